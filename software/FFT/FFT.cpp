@@ -11,6 +11,9 @@
  *
  * History
  * 2023/05/10	jorjor	First release
+ * 2026/10/17	jorjor	Twiddle tables built once, integer loop bounds
+ * 2026/10/17	jorjor	Reject n that is not a power of 2
+ * 2026/10/17	jorjor	right_rotate() in place, streaming filters in FFT_fir.h
  * */
 
 #include <iostream>
@@ -48,7 +51,7 @@ int reverse(int num,int len) { // reverse bit
     int out = 0;
     for (int i = 0; i < len; i++){
         if (num & 1) {
-            out += pow(2, len - i - 1);
+            out |= 1 << (len - i - 1);
         }
         num >>= 1;
     }
@@ -90,20 +93,25 @@ Complex W(int m, int n, bool stat) {
     return w;
 }
 
-void right_rotate(double* arr, int len){
-	double *temp = new double[len];
-	
-	// copy
-	for (int i = 0; i < len; i++) {
-		temp[i] = arr[i];
-	}
+Complex* twiddle_table(int n, bool stat) {
+	// W(distance, 2 * half, stat) of the stage with half = 2^(step - 1) at table[half + distance]
+	// built once, the butterfly loops only read it
+    Complex* table = new Complex[n];
+    for (int half = 1; half < n; half <<= 1) {
+        for (int distance = 0; distance < half; distance++) {
+            table[half + distance] = W(distance, 2 * half, stat);
+        }
+    }
+    return table;
+}
 
-	arr[0] = temp[len - 1];
-	for (int i = 0; i < len - 1; i++) {
-		arr[i+1] = temp[i];
+void right_rotate(double* arr, int len){
+	// in place, no buffer per step
+	double last = arr[len - 1];
+	for (int i = len - 1; i > 0; i--) {
+		arr[i] = arr[i-1];
 	}
-
-	delete temp;
+	arr[0] = last;
 }
 
 double* convolution(double x1[], double x2[], int len){
@@ -130,14 +138,21 @@ double* convolution(double x1[], double x2[], int len){
 		out[step] = sum;
 	}
 	
-	delete a;
-	delete b;
+	delete[] a;
+	delete[] b;
 	
 	return out;
 }
 
 int main() {
     int n = 8; // 4
+    if (n < 1 || (n & (n - 1)) != 0) {
+        // the stages below need a power of 2, FftBluestein (FFT_bluestein.h) takes any n
+        cerr << "n must be a power of 2" << endl;
+        return 1;
+    }
+    int logn = 0;
+    while ((1 << logn) < n) logn++;
     double x1[] = {1, 2, 2, 0, 1, 2, 2, 0};
     double x2[] = {1, 2, 3, 4, 5, 6, 7, 8};
     //double x1[] = {1, 2, 2, 0};
@@ -166,14 +181,15 @@ int main() {
     cout << "x2: "; print_complex(x2_complex, n); cout << endl;
 	
 	// FFT
-    for (int step = log2(n); step >= 1; step--) {								// 
+	Complex* w_fft = twiddle_table(n, normal);
+    for (int step = logn; step >= 1; step--) {								// 
         cout << step << endl;
-		for (int idx = 0; idx < (n/pow(2, step)); idx++) {					// 
-            for (int distance = 0; distance < pow(2, step - 1); distance++) {	//
-				int i = idx * pow(2, step) + distance;
-				int j = idx * pow(2, step) + distance + pow(2, step - 1);
-				cout << i << ' ' << j << "(" << distance << ", " << pow(2, step) << ") " << endl;
-				Complex w = W(distance, pow(2, step), normal);
+		for (int idx = 0; idx < (n >> step); idx++) {					// 
+            for (int distance = 0; distance < (1 << (step - 1)); distance++) {	//
+				int i = (idx << step) + distance;
+				int j = (idx << step) + distance + (1 << (step - 1));
+				cout << i << ' ' << j << "(" << distance << ", " << (1 << step) << ") " << endl;
+				Complex w = w_fft[(1 << (step - 1)) + distance];
                 BFU_GS(x1_complex, i, j, w);
                 BFU_GS(x2_complex, i, j, w);
             }
@@ -202,12 +218,13 @@ int main() {
 	} 
 
 	// IFFT
-    for (int step = 1; step <= log2(n); step++) {								// 
-        for (int idx = 0; idx < (n/pow(2, step)); idx++) {					// 
-            for (int distance = 0; distance < pow(2, step - 1); distance++) {	//
-				int i = idx * pow(2, step) + distance;
-				int j = idx * pow(2, step) + distance + pow(2, step - 1);
-				Complex w = W(distance, pow(2, step), inverse);
+	Complex* w_ifft = twiddle_table(n, inverse);
+    for (int step = 1; step <= logn; step++) {								// 
+        for (int idx = 0; idx < (n >> step); idx++) {					// 
+            for (int distance = 0; distance < (1 << (step - 1)); distance++) {	//
+				int i = (idx << step) + distance;
+				int j = (idx << step) + distance + (1 << (step - 1));
+				Complex w = w_ifft[(1 << (step - 1)) + distance];
                 BFU_CT(X_complex, i, j, w);
             }
         }
@@ -224,10 +241,12 @@ int main() {
 	double * org_conv = convolution(x1, x2, n);
     cout << "org_conv: "; print(org_conv, n); cout << endl;
 
-	delete x1_complex;
-	delete x2_complex;
-	delete X_multi;
-	delete X_complex;
+	delete[] x1_complex;
+	delete[] x2_complex;
+	delete[] X_multi;
+	delete[] X_complex;
+	delete[] w_fft;
+	delete[] w_ifft;
     
 	return 0;
 }
@@ -0,0 +1,137 @@
+/*
+ * FFT_bluestein.cpp
+ *
+ * Description
+ * Implementation of FftBluestein, dft() and idft(), see FFT_bluestein.h
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * 2026/10/17	jorjor	dft() / idft() run FftMixed on 7-smooth sizes
+ * 2026/10/17	jorjor	Chirp from root_of_unity()
+ * */
+
+#include "FFT_bluestein.h"
+#include "FFT_mixed.h"
+#include "bitrev.h"
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+
+using namespace std;
+
+static int check_size(int n) {
+	if (n < 1 || n > (1 << 28)) {
+		throw invalid_argument("FftBluestein: n must be in [1, 2^28]");
+	}
+	return n;
+}
+
+static int convolution_size(int n) {
+	if ((n & (n - 1)) == 0) return n;
+	int m = 1;
+	while (m < 2 * n - 1) m <<= 1;
+	return m;
+}
+
+FftBluestein::FftBluestein(int n, cpu_isa isa)
+	: n_(check_size(n)), pow2_((n & (n - 1)) == 0), plan_(convolution_size(n), isa) {
+	if (pow2_) {
+		return;
+	}
+
+	// c[j] = e^(-pi i (j^2 mod 2n) / n) = W(j^2 mod 2n, 2n)
+	chirp_.resize(n);
+	for (int j = 0; j < n; j++) {
+		chirp_[j] = root_of_unity((int)((long long)j * j % (2LL * n)), 2 * n);
+	}
+
+	// conj(c) at the indices -(n - 1) ... n - 1 of the cyclic convolution
+	const int m = plan_.size();
+	kernel_.assign(m, Complex(0, 0));
+	kernel_[0] = conj(chirp_[0]);
+	for (int j = 1; j < n; j++) {
+		kernel_[j] = conj(chirp_[j]);
+		kernel_[m - j] = conj(chirp_[j]);
+	}
+	plan_.forward(kernel_.data());
+}
+
+void FftBluestein::forward(Complex *x, Complex *tmp) const {
+	if (pow2_) {
+		plan_.forward(x);
+		bitrev_permute(x, plan_.log2n());
+		return;
+	}
+
+	const int m = plan_.size();
+	vector<Complex> own;
+	if (tmp == NULL) {
+		own.resize(m);
+		tmp = own.data();
+	}
+	for (int j = 0; j < n_; j++) {
+		tmp[j] = cmul(x[j], chirp_[j]);
+	}
+	for (int j = n_; j < m; j++) {
+		tmp[j] = Complex(0, 0);
+	}
+	plan_.forward(tmp);
+	plan_.pointwise(tmp, tmp, kernel_.data());
+	plan_.inverse(tmp);
+	for (int k = 0; k < n_; k++) {
+		x[k] = cmul(tmp[k], chirp_[k]);
+	}
+}
+
+void FftBluestein::inverse(Complex *x, Complex *tmp) const {
+	for (int j = 0; j < n_; j++) {
+		x[j] = conj(x[j]);
+	}
+	forward(x, tmp);
+	const double scale = 1.0 / n_;
+	for (int j = 0; j < n_; j++) {
+		x[j] = conj(x[j]) * scale;
+	}
+}
+
+struct dft_object {
+	unique_ptr<FftMixed> mixed;
+	unique_ptr<FftBluestein> chirp;
+};
+
+static const dft_object &cached(int n) {
+	// the objects are read-only, one per n is built on first use and kept
+	// a power of 2 stays on FftBluestein, its FftPlan is vectorized
+	static mutex lock;
+	static map<int, dft_object> objects;
+	lock_guard<mutex> hold(lock);
+	dft_object &p = objects[n];
+	if (!p.mixed && !p.chirp) {
+		if (FftMixed::supported(n) && (n & (n - 1)) != 0) {
+			p.mixed.reset(new FftMixed(n));
+		} else {
+			p.chirp.reset(new FftBluestein(n));
+		}
+	}
+	return p;
+}
+
+void dft(Complex *x, int n) {
+	const dft_object &p = cached(n);
+	if (p.mixed) {
+		p.mixed->forward(x);
+	} else {
+		p.chirp->forward(x);
+	}
+}
+
+void idft(Complex *x, int n) {
+	const dft_object &p = cached(n);
+	if (p.mixed) {
+		p.mixed->inverse(x);
+	} else {
+		p.chirp->inverse(x);
+	}
+}
@@ -0,0 +1,67 @@
+/*
+ * FFT_bluestein.h
+ *
+ * Description
+ * DFT of any length n (Bluestein's chirp-z algorithm)
+ * FFT.cpp and FftPlan need a power of 2, a frame of another length had to be
+ * padded or resampled, which changes its spectrum. With jk = (j^2 + k^2 - (k - j)^2) / 2
+ *
+ *   X[k] = sum x[j] e^(-2 pi i jk / n) = c[k] sum (x[j] c[j]) conj(c[k - j]),  c[j] = e^(-pi i j^2 / n)
+ *
+ * the sum is a cyclic convolution of size m >= 2n - 1, a power of 2, on FftPlan :
+ * x c zero-padded, forward, times the transform of conj(c) (wrapped to
+ * negative indices), inverse, times c. The chirp and the transform of conj(c)
+ * are computed once per n and kept in the object, a DFT costs two FftPlan
+ * transforms of size m and 2n + m complex products
+ * j^2 is reduced modulo 2n before the angle is taken, in long double, so the chirp
+ * stays accurate for large n. A power of 2 n runs FftPlan itself, then the
+ * bit-reversal permutation (bitrev.h)
+ *
+ *   forward   X[k] = sum x[j] e^(-2 pi i jk / n), natural order in and out
+ *   inverse   x[j] = 1/n sum X[k] e^(2 pi i jk / n), conj(forward(conj(X))) / n
+ *
+ * The object is read-only after construction and can be shared between threads
+ * when every thread passes its own tmp. dft() / idft() take the object of n from a
+ * cache, built on first use and kept, a 7-smooth n that is not a power of 2 runs
+ * the mixed-radix FftMixed (FFT_mixed.h) instead of the chirp
+ * Invalid sizes throw std::invalid_argument
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * 2026/10/17	jorjor	dft() / idft() run FftMixed on 7-smooth sizes
+ * */
+
+#ifndef FFT_BLUESTEIN_H
+#define FFT_BLUESTEIN_H
+
+#include <vector>
+
+#include "FFT_plan.h"
+
+class FftBluestein {
+public:
+	// n : any length in [1, 2^28]
+	explicit FftBluestein(int n, cpu_isa isa = ISA_AUTO);
+
+	int size() const { return n_; }
+
+	// size of the convolution, n itself for a power of 2
+	int transform_size() const { return plan_.size(); }
+
+	// in-place, tmp holds transform_size() values, or is NULL and allocated here
+	void forward(Complex *x, Complex *tmp = NULL) const;
+	void inverse(Complex *x, Complex *tmp = NULL) const;
+
+private:
+	int n_;
+	bool pow2_;
+	FftPlan plan_;
+	std::vector<Complex> chirp_;	// c[j], j < n
+	std::vector<Complex> kernel_;	// forward() of conj(c) at 0 ... n - 1 and m - n + 1 ... m - 1
+};
+
+// in-place DFT / inverse DFT of any length on the cached FftMixed or FftBluestein of n
+void dft(Complex *x, int n);
+void idft(Complex *x, int n);
+
+#endif
@@ -0,0 +1,78 @@
+/*
+ * FFT_convolve.cpp
+ *
+ * Description
+ * Implementation of FftConvolver and convolve(), see FFT_convolve.h
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * 2026/10/17	jorjor	PlanCache of plan_cache.h
+ * */
+
+#include "FFT_convolve.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace std;
+
+FftConvolver::FftConvolver(cpu_isa isa, fft_radix radix) : isa_(isa), radix_(radix) {
+}
+
+int FftConvolver::transform_size(int la, int lb) {
+	if (la < 1 || lb < 1) {
+		throw invalid_argument("FftConvolver: la and lb must be at least 1");
+	}
+	if (min(la, lb) < FFT_CONVOLVE_DIRECT) {
+		return 0;
+	}
+	if ((long long)la + lb - 1 > (1 << 30)) {
+		throw invalid_argument("FftConvolver: la + lb - 1 must be at most 2^30");
+	}
+	int n = 1;
+	while (n < la + lb - 1) n <<= 1;
+	return n;
+}
+
+const FftPlan &FftConvolver::plan(int n) {
+	return plans_.get(n, [this](int m) { return new FftPlan(m, isa_, radix_); });
+}
+
+void FftConvolver::convolve(const double *a, int la, const double *b, int lb, double *out) {
+	const int n = transform_size(la, lb);
+	const int len = la + lb - 1;
+
+	if (n == 0) {
+		// a long operand runs in the inner loop, out may alias a or b
+		if (la < lb) {
+			swap(a, b);
+			swap(la, lb);
+		}
+		a_.assign(len, 0.0);
+		for (int j = 0; j < lb; j++) {
+			const double bj = b[j];
+			double *o = &a_[j];
+			for (int i = 0; i < la; i++) {
+				o[i] += a[i] * bj;
+			}
+		}
+		copy(a_.begin(), a_.begin() + len, out);
+		return;
+	}
+
+	const FftPlan &p = plan(n);
+	a_.resize(n);
+	b_.resize(n);
+	tmp_.resize(n);
+	copy(a, a + la, a_.begin());
+	fill(a_.begin() + la, a_.end(), 0.0);
+	copy(b, b + lb, b_.begin());
+	fill(b_.begin() + lb, b_.end(), 0.0);
+	p.multiply_real(a_.data(), a_.data(), b_.data(), tmp_.data());
+	copy(a_.begin(), a_.begin() + len, out);
+}
+
+void convolve(const double *a, int la, const double *b, int lb, double *out) {
+	static thread_local FftConvolver conv;
+	conv.convolve(a, la, b, lb, out);
+}
@@ -0,0 +1,65 @@
+/*
+ * FFT_convolve.h
+ *
+ * Description
+ * Linear convolution of real sequences of any lengths with the double FFT
+ * FftPlan::multiply() and FFT_GSCT.cpp compute cyclic products of two equal
+ * power-of-2 lengths, the caller pads both operands to twice the longer one
+ * and runs three complex transforms. convolve() takes la and lb values :
+ *
+ *   size     the smallest power of 2 n >= la + lb - 1, so a short operand does
+ *            not double the transform of a long one
+ *   padding  a and b are copied into the plan's buffers, zero above la and lb,
+ *            the buffers and the plan of every size are kept for the next calls
+ *   real     multiply_real() packs a - i b into one complex transform and runs
+ *            the inverse on n / 2 points, 1.5 transforms of size n instead of 3,
+ *            the zero imaginary halves of both inputs are never transformed
+ *   direct   below FFT_CONVOLVE_DIRECT values in the shorter operand the sum
+ *            out[k] = sum a[i] b[k - i] runs directly, without any transform
+ *
+ * The result is out[0 ... la + lb - 2], rounded like FftPlan::multiply_real()
+ * An FftConvolver owns its buffers, use one per thread, the free function
+ * convolve() keeps one per thread
+ * Invalid lengths throw std::invalid_argument
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * 2026/10/17	jorjor	PlanCache of plan_cache.h
+ * */
+
+#ifndef FFT_CONVOLVE_H
+#define FFT_CONVOLVE_H
+
+#include <vector>
+
+#include "FFT_plan.h"
+#include "plan_cache.h"
+
+// shorter operand below this : direct sum
+#define FFT_CONVOLVE_DIRECT 32
+
+class FftConvolver {
+public:
+	explicit FftConvolver(cpu_isa isa = ISA_AUTO, fft_radix radix = FFT_SPLIT_RADIX);
+
+	// transform size of an la x lb product, 0 when it runs directly
+	static int transform_size(int la, int lb);
+
+	// out = a * b, la + lb - 1 values, out may alias a or b
+	void convolve(const double *a, int la, const double *b, int lb, double *out);
+
+private:
+	const FftPlan &plan(int n);
+
+	cpu_isa isa_;
+	fft_radix radix_;
+	PlanCache<FftPlan> plans_;
+	std::vector<double> a_;
+	std::vector<double> b_;
+	std::vector<Complex> tmp_;
+};
+
+// FftConvolver::convolve() on a convolver of the calling thread
+void convolve(const double *a, int la, const double *b, int lb, double *out);
+
+#endif
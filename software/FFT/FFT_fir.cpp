@@ -0,0 +1,157 @@
+/*
+ * FFT_fir.cpp
+ *
+ * Description
+ * Implementation of FftFir, see FFT_fir.h
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * */
+
+#include "FFT_fir.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace std;
+
+// inputs per step of the direct sum
+#define FIR_DIRECT_BLOCK 256
+
+int FftFir::best_size(int taps) {
+	if (taps < 1 || taps > (1 << 24)) {
+		throw invalid_argument("FftFir: taps must be in [1, 2^24]");
+	}
+	if (taps < FFT_FIR_DIRECT) {
+		return 0;
+	}
+	// n (log2 n + FFT_FIR_COST) / (n - taps + 1) over the powers of 2 from taps
+	// up to FFT_FIR_MAX_SIZE, or 4 taps for long kernels
+	int lg = 1;
+	while ((1 << lg) < taps) lg++;
+	int best = 1 << lg;
+	double best_cost = (double)best * (lg + FFT_FIR_COST) / (best - taps + 1);
+	const int top = max(FFT_FIR_MAX_SIZE, 4 * taps);
+	for (lg++; lg <= 30 && (1 << lg) <= top; lg++) {
+		int n = 1 << lg;
+		double cost = (double)n * (lg + FFT_FIR_COST) / (n - taps + 1);
+		if (cost < best_cost) {
+			best = n;
+			best_cost = cost;
+		}
+	}
+	return best;
+}
+
+FftFir::FftFir(const double *h, int taps, fir_method method, int n, cpu_isa isa)
+	: taps_(taps), method_(method), n_(n), pos_(0), h_(h, h + max(taps, 0)) {
+	if (taps < 1 || taps > (1 << 24)) {
+		throw invalid_argument("FftFir: taps must be in [1, 2^24]");
+	}
+	if (n == 0) {
+		n_ = best_size(taps);
+	} else if (n < 2 || n > (1 << 30) || (n & (n - 1)) != 0 || n < taps) {
+		throw invalid_argument("FftFir: n must be 0 or a power of 2 in [max(taps, 2), 2^30]");
+	}
+
+	if (n_ == 0) {
+		block_ = FIR_DIRECT_BLOCK;
+		x_.assign(taps_ - 1 + block_, 0.0);
+		return;
+	}
+
+	block_ = n_ - taps_ + 1;
+	plan_.push_back(FftPlan(n_, isa));
+	t_.assign(h_.begin(), h_.end());
+	t_.resize(n_, 0.0);
+	kernel_.resize(n_ / 2 + 1);
+	plan_[0].forward_real(kernel_.data(), t_.data());
+	spec_.resize(n_ / 2 + 1);
+	y_.resize(block_);
+	reset();
+}
+
+void FftFir::reset() {
+	pos_ = 0;
+	fill(x_.begin(), x_.end(), 0.0);
+	if (n_ == 0) return;
+	x_.assign(n_, 0.0);
+	y_.assign(block_, 0.0);
+	tail_.assign(taps_ - 1, 0.0);
+}
+
+void FftFir::run_block() {
+	const FftPlan &p = plan_[0];
+	const int L = block_;
+	const int h = taps_ - 1;
+	if (method_ == FIR_OVERLAP_ADD) {
+		fill(x_.begin() + L, x_.end(), 0.0);
+	}
+	p.forward_real(spec_.data(), x_.data());
+	for (int k = 0; k <= n_ / 2; k++) {
+		spec_[k] = cmul(spec_[k], kernel_[k]);
+	}
+	p.inverse_real(t_.data(), spec_.data());
+
+	if (method_ == FIR_OVERLAP_SAVE) {
+		copy(t_.begin() + h, t_.end(), y_.begin());
+		// the last taps - 1 inputs open the next frame
+		copy(x_.begin() + L, x_.end(), x_.begin());
+		return;
+	}
+
+	for (int i = 0; i < L; i++) {
+		y_[i] = t_[i] + (i < h ? tail_[i] : 0.0);
+	}
+	// tail_[j + L] is read before tail_[j + L] is written
+	for (int j = 0; j < h; j++) {
+		tail_[j] = t_[L + j] + (L + j < h ? tail_[L + j] : 0.0);
+	}
+}
+
+void FftFir::process(const double *in, double *out, int count) {
+	if (count < 0) {
+		throw invalid_argument("FftFir: count must be at least 0");
+	}
+	const int h = taps_ - 1;
+
+	if (n_ == 0) {
+		// x_ : taps - 1 past inputs then up to FIR_DIRECT_BLOCK new ones
+		while (count > 0) {
+			const int c = min(count, block_);
+			copy(in, in + c, x_.begin() + h);
+			for (int i = 0; i < c; i++) {
+				const double *x = &x_[h + i];
+				double sum = 0;
+				for (int k = 0; k < taps_; k++) {
+					sum += h_[k] * x[-k];
+				}
+				out[i] = sum;
+			}
+			copy(x_.begin() + c, x_.begin() + c + h, x_.begin());
+			in += c;
+			out += c;
+			count -= c;
+		}
+		return;
+	}
+
+	// the inputs of a block go to x_, the outputs of the previous block come out
+	double *x = (method_ == FIR_OVERLAP_SAVE) ? &x_[h] : &x_[0];
+	while (count > 0) {
+		const int c = min(count, block_ - pos_);
+		for (int i = 0; i < c; i++) {
+			const double v = in[i];
+			out[i] = y_[pos_ + i];
+			x[pos_ + i] = v;
+		}
+		pos_ += c;
+		in += c;
+		out += c;
+		count -= c;
+		if (pos_ == block_) {
+			run_block();
+			pos_ = 0;
+		}
+	}
+}
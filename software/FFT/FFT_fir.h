@@ -0,0 +1,97 @@
+/*
+ * FFT_fir.h
+ *
+ * Description
+ * Streaming FIR filter, y[i] = sum h[k] x[i - k], on an unbounded input given in
+ * chunks of any length. convolution() of FFT.cpp is a cyclic O(n^2) product of one
+ * frame and FftConvolver (FFT_convolve.h) needs the whole input, here the kernel
+ * is fixed and its real FFT of size n is computed once, the input runs through in
+ * blocks of L = n - taps + 1 samples :
+ *
+ *   FIR_OVERLAP_SAVE   a frame of the last taps - 1 inputs and the L new ones,
+ *                      the first taps - 1 outputs of the cyclic product are
+ *                      wrapped around and dropped, the other L are kept
+ *   FIR_OVERLAP_ADD    the L new inputs padded with zeros, the first L outputs
+ *                      plus the tail of the previous block are kept, the last
+ *                      taps - 1 become the next tail
+ *
+ * One block costs forward_real() + n / 2 + 1 complex products + inverse_real()
+ * of FftPlan, about n (log2 n + FFT_FIR_COST) for L outputs. With n = 0 the
+ * power of 2 with the lowest cost per output is taken (best_size()), below
+ * FFT_FIR_DIRECT taps the sum runs directly
+ *
+ * process() writes one output per input. The FFT paths give the outputs of a
+ * block once it is complete, so out lags the filtered input by latency() = L
+ * samples (the first L outputs are 0), the direct sum has no latency
+ * Per sample the cost is constant, the memory is about 4 n values
+ *
+ * An FftFir owns its buffers and the stream state, use one per thread (stream)
+ * Invalid parameters throw std::invalid_argument
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * */
+
+#ifndef FFT_FIR_H
+#define FFT_FIR_H
+
+#include <vector>
+
+#include "FFT_plan.h"
+
+// fewer taps : direct sum
+#define FFT_FIR_DIRECT 16
+// cost model of one block, n (log2 n + FFT_FIR_COST)
+#define FFT_FIR_COST 3
+// largest transform best_size() picks below 4 taps, larger blocks leave the cache
+#define FFT_FIR_MAX_SIZE (1 << 14)
+
+enum fir_method {
+	FIR_OVERLAP_SAVE = 0,
+	FIR_OVERLAP_ADD
+};
+
+class FftFir {
+public:
+	// h : taps coefficients, taps in [1, 2^24]
+	// n : transform size, a power of 2 >= taps, or 0 for best_size(taps)
+	FftFir(const double *h, int taps, fir_method method = FIR_OVERLAP_SAVE, int n = 0, cpu_isa isa = ISA_AUTO);
+
+	// power of 2 with the lowest cost per output, 0 when the sum runs directly
+	static int best_size(int taps);
+
+	int taps() const { return taps_; }
+	fir_method method() const { return method_; }
+
+	// transform size, 0 for the direct sum
+	int size() const { return n_; }
+
+	// outputs per block, and the lag of out behind the filtered input
+	int block() const { return block_; }
+	int latency() const { return n_ ? block_ : 0; }
+
+	// count inputs of the stream in, count outputs into out, out may alias in
+	void process(const double *in, double *out, int count);
+
+	// back to the start of a stream, all past inputs zero
+	void reset();
+
+private:
+	void run_block();
+
+	int taps_;
+	fir_method method_;
+	int n_;
+	int block_;
+	int pos_;	// inputs of the current block
+	std::vector<FftPlan> plan_;	// one plan, empty for the direct sum
+	std::vector<double> h_;
+	std::vector<Complex> kernel_;	// forward_real() of h padded to n
+	std::vector<Complex> spec_;
+	std::vector<double> x_;		// save : taps - 1 past inputs then the block, add : the block
+	std::vector<double> t_;		// cyclic product of a block
+	std::vector<double> y_;		// outputs of the last block
+	std::vector<double> tail_;	// add : taps - 1 values carried to the next block
+};
+
+#endif
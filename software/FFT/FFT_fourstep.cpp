@@ -0,0 +1,163 @@
+/*
+ * FFT_fourstep.cpp
+ *
+ * Description
+ * Implementation of FftFourStep, see FFT_fourstep.h
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * 2026/10/17	jorjor	Bit-reverse table from bitrev.h
+ * */
+
+#include "FFT_fourstep.h"
+#include "bitrev.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace std;
+
+static int check_size(int n) {
+	if (n < 1 || (n & (n - 1)) != 0) {
+		throw invalid_argument("FftFourStep: n must be a power of 2");
+	}
+	return n;
+}
+
+static int log2_of(int n) {
+	int lg = 0;
+	while ((1 << lg) < n) lg++;
+	return lg;
+}
+
+static Complex root(int k, int n) {
+	// root_of_unity() needs a multiple of 8
+	return (n % 8 == 0) ? root_of_unity(k, n) : root_of_unity(k * (8 / n), 8);
+}
+
+FftFourStep::FftFourStep(int n, cpu_isa isa)
+	: n_(check_size(n)), n1_(1 << (log2_of(n) / 2)), n2_(n / n1_),
+	  lo_bits_((log2_of(n) + 1) / 2), panel_(min(FFT_PANEL_COLS, n2_)), plan1_(n1_, isa), plan2_(n2_, isa) {
+	rev1_.assign(n1_, 0);
+	bitrev_table(&rev1_[0], log2_of(n1_));
+
+	int lo = 1 << lo_bits_;
+	lo_.resize(lo);
+	for (int b = 0; b < lo; b++) {
+		lo_[b] = root(b, n);
+	}
+	hi_.resize(n >> lo_bits_);
+	for (int a = 0; a < (n >> lo_bits_); a++) {
+		hi_[a] = root(a, n >> lo_bits_);
+	}
+}
+
+void FftFourStep::twiddle_column(Complex *col, int j2, bool inverse) const {
+	if (j2 == 0) {
+		return;
+	}
+	const int mask = (1 << lo_bits_) - 1;
+	const double sign = inverse ? -1.0 : 1.0;
+	double *p = (double *)col;
+	for (int i = 0; i < n1_; i++) {
+		// j2 * k1 < n2 * n1 = n
+		int m = j2 * rev1_[i];
+		const double *h = (const double *)&hi_[m >> lo_bits_];
+		const double *l = (const double *)&lo_[m & mask];
+		double wr = h[0] * l[0] - h[1] * l[1];
+		double wi = sign * (h[0] * l[1] + h[1] * l[0]);
+		double xr = p[2*i], xi = p[2*i+1];
+		p[2*i] = xr * wr - xi * wi;
+		p[2*i+1] = xr * wi + xi * wr;
+	}
+}
+
+void FftFourStep::load_panel(Complex *tmp, const Complex *x, int c0) const {
+	// whole cache lines of every row, written to panel_ rows of tmp
+	// the rows are n2 values apart, farther than the hardware prefetchers look
+	const int B = panel_;
+	for (int j1 = 0; j1 < n1_; j1++) {
+		const Complex *src = x + j1 * n2_ + c0;
+		if (j1 + FFT_PANEL_PREFETCH < n1_) {
+			for (int b = 0; b < B; b += 4) {
+				__builtin_prefetch(src + FFT_PANEL_PREFETCH * n2_ + b);
+			}
+		}
+		for (int b = 0; b < B; b++) {
+			tmp[b * n1_ + j1] = src[b];
+		}
+	}
+}
+
+void FftFourStep::store_panel(Complex *x, const Complex *tmp, int c0) const {
+	const int B = panel_;
+	for (int j1 = 0; j1 < n1_; j1++) {
+		Complex *dst = x + j1 * n2_ + c0;
+		if (j1 + FFT_PANEL_PREFETCH < n1_) {
+			for (int b = 0; b < B; b += 4) {
+				__builtin_prefetch(dst + FFT_PANEL_PREFETCH * n2_ + b, 1);
+			}
+		}
+		for (int b = 0; b < B; b++) {
+			dst[b] = tmp[b * n1_ + j1];
+		}
+	}
+}
+
+void FftFourStep::forward(Complex *x, Complex *tmp) const {
+	for (int c0 = 0; c0 < n2_; c0 += panel_) {
+		load_panel(tmp, x, c0);
+		for (int b = 0; b < panel_; b++) {
+			plan1_.forward(tmp + b * n1_);
+			twiddle_column(tmp + b * n1_, c0 + b, false);
+		}
+		store_panel(x, tmp, c0);
+	}
+	for (int k1 = 0; k1 < n1_; k1++) {
+		plan2_.forward(x + k1 * n2_);
+	}
+}
+
+void FftFourStep::inverse(Complex *x, Complex *tmp) const {
+	// 1 / n1 and 1 / n2 from the sub-FFTs
+	for (int k1 = 0; k1 < n1_; k1++) {
+		plan2_.inverse(x + k1 * n2_);
+	}
+	for (int c0 = 0; c0 < n2_; c0 += panel_) {
+		load_panel(tmp, x, c0);
+		for (int b = 0; b < panel_; b++) {
+			twiddle_column(tmp + b * n1_, c0 + b, true);
+			plan1_.inverse(tmp + b * n1_);
+		}
+		store_panel(x, tmp, c0);
+	}
+}
+
+void FftFourStep::pointwise(Complex *out, const Complex *a, const Complex *b) const {
+	const double *pa = (const double *)a;
+	const double *pb = (const double *)b;
+	double *po = (double *)out;
+	for (int i = 0; i < n_; i++) {
+		double ar = pa[2*i], ai = pa[2*i+1];
+		double br = pb[2*i], bi = pb[2*i+1];
+		po[2*i] = ar * br - ai * bi;
+		po[2*i+1] = ar * bi + ai * br;
+	}
+}
+
+void FftFourStep::multiply(Complex *out, const Complex *a, const Complex *b, Complex *tmp) const {
+	Complex *fb = tmp + panel_ * n1_;
+	for (int i = 0; i < n_; i++) {
+		fb[i] = b[i];
+	}
+	if (out != a) {
+		for (int i = 0; i < n_; i++) {
+			out[i] = a[i];
+		}
+	}
+
+	forward(out, tmp);
+	forward(fb, tmp);
+	pointwise(out, out, fb);
+	inverse(out, tmp);
+}
@@ -0,0 +1,90 @@
+/*
+ * FFT_fourstep.h
+ *
+ * Description
+ * Cache-blocked FFT for sizes beyond the L2 cache (Bailey's four-step / six-step)
+ * The stage loops of FFT_GSCT.cpp and FftPlan sweep the whole array once per stage,
+ * past the cache sizes every stage streams from DRAM
+ * Here n = n1 * n2 with n1 ~ n2 ~ sqrt(n), the array is read as n1 rows of n2 values
+ *
+ *   1. n2 FFTs of size n1 on the columns : FFT_PANEL_COLS columns at a time
+ *      are transposed into contiguous rows of tmp, transformed, multiplied by
+ *      their twiddles W(j2 * k1, n) and transposed back
+ *   2. n1 FFTs of size n2 on the rows, in place
+ * Every sub-FFT and every panel fits in the cache, the array is read twice
+ * whatever n is, instead of log2(n) times
+ *
+ * The sub-FFTs are FftPlan transforms, their bit-reversed outputs combine into the
+ * bit-reversed order of the whole transform, so the output is the one of FftPlan
+ * and no transpose of the whole array is needed (the six-step variant has three),
+ * pointwise() of a FftPlan of the same size works on it
+ * inverse() runs the steps backwards with the conjugate twiddles, scaled by 1 / n
+ *
+ * The twiddles W(m, n) are the product of two tables of about sqrt(n) entries,
+ * W(m, n) = W(m >> l, n >> l) * W(m & (2^l - 1), n)
+ * Invalid sizes throw std::invalid_argument
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * */
+
+#ifndef FFT_FOURSTEP_H
+#define FFT_FOURSTEP_H
+
+#include <vector>
+
+#include "FFT_plan.h"
+
+// columns per panel, 8 x 16 bytes = 2 cache lines of every row
+#define FFT_PANEL_COLS 8
+
+// rows prefetched ahead by the panel copies, 4 complex = 1 cache line
+#define FFT_PANEL_PREFETCH 8
+
+class FftFourStep {
+public:
+	// n : power of 2, isa : ISA_AUTO or the highest ISA the row plans may use
+	explicit FftFourStep(int n, cpu_isa isa = ISA_AUTO);
+
+	int size() const { return n_; }
+	int rows() const { return n1_; }
+	int cols() const { return n2_; }
+	cpu_isa isa() const { return plan1_.isa(); }
+
+	// in-place transforms on n values, tmp must hold FFT_PANEL_COLS * rows() values
+	void forward(Complex *x, Complex *tmp) const;
+	void inverse(Complex *x, Complex *tmp) const;
+
+	// out = a . b in the frequency domain, out may alias a or b
+	void pointwise(Complex *out, const Complex *a, const Complex *b) const;
+
+	// out = cyclic convolution of a and b, tmp must hold n + FFT_PANEL_COLS * rows() values
+	// out may alias a, tmp must not alias anything
+	void multiply(Complex *out, const Complex *a, const Complex *b, Complex *tmp) const;
+
+private:
+	// column j2 of n1 values in the bit-reversed order of plan1_, times W(j2 * k1, n)
+	void twiddle_column(Complex *col, int j2, bool inverse) const;
+
+	// columns [c0, c0 + panel_) <-> rows of n1 values in tmp
+	void load_panel(Complex *tmp, const Complex *x, int c0) const;
+	void store_panel(Complex *x, const Complex *tmp, int c0) const;
+
+	int n_;
+	int n1_;
+	int n2_;
+	int lo_bits_;
+	int panel_;
+
+	FftPlan plan1_;
+	FftPlan plan2_;
+
+	// k1 of the position p in a column of n1 values
+	std::vector<int> rev1_;
+
+	// W(b, n) for b < 2^lo_bits_, W(a, n >> lo_bits_) for a < n >> lo_bits_
+	std::vector<Complex> lo_;
+	std::vector<Complex> hi_;
+};
+
+#endif
@@ -0,0 +1,737 @@
+/*
+ * FFT_kernels.cpp
+ *
+ * Description
+ * Implementation of the FFT stages, see FFT_kernels.h
+ * The SIMD kernels are compiled with the target attributes of cpu_target.h
+ * The complex products are written out with real arithmetic,
+ * operator* of std::complex checks for NaN / inf on every call
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * 2026/10/17	jorjor	Radix-4 and split-radix stages
+ * 2026/10/17	jorjor	Stockham pass
+ * 2026/10/17	jorjor	Intrinsics and target attributes from cpu_target.h
+ * */
+
+#include "FFT_kernels.h"
+#include "cpu_target.h"
+
+/* scalar */
+
+static inline void BFU_GS(double *a, double *b, double wr, double wi) {
+	// DIF-FFT
+	// Gentleman-Sande butterfly unit
+	double tr = a[0] - b[0];
+	double ti = a[1] - b[1];
+	a[0] += b[0];
+	a[1] += b[1];
+	b[0] = tr * wr - ti * wi;
+	b[1] = tr * wi + ti * wr;
+}
+
+static inline void BFU_CT(double *a, double *b, double wr, double wi) {
+	// DIT-FFT
+	// Cooley-Tukey butterfly unit
+	double tr = b[0] * wr - b[1] * wi;
+	double ti = b[0] * wi + b[1] * wr;
+	b[0] = a[0] - tr;
+	b[1] = a[1] - ti;
+	a[0] += tr;
+	a[1] += ti;
+}
+
+static void gs_stage_scalar(Complex *x, int n, int half, const Complex *w) {
+	double *p = (double *)x;
+	const double *q = (const double *)w;
+	for (int s = 0; s < n; s += 2 * half) {
+		for (int j = 0; j < half; j++) {
+			BFU_GS(p + 2 * (s + j), p + 2 * (s + j + half), q[2 * j], q[2 * j + 1]);
+		}
+	}
+}
+
+static void ct_stage_scalar(Complex *x, int n, int half, const Complex *w) {
+	double *p = (double *)x;
+	const double *q = (const double *)w;
+	for (int s = 0; s < n; s += 2 * half) {
+		for (int j = 0; j < half; j++) {
+			BFU_CT(p + 2 * (s + j), p + 2 * (s + j + half), q[2 * j], q[2 * j + 1]);
+		}
+	}
+}
+
+static inline void cmul_store(double *p, double re, double im, double wr, double wi) {
+	p[0] = re * wr - im * wi;
+	p[1] = re * wi + im * wr;
+}
+
+static void r4_gs_stage_scalar(Complex *x, int n, int q, const Complex *w) {
+	double *p = (double *)x;
+	const double *w1 = (const double *)w;
+	const double *w2 = w1 + 2 * q;
+	const double *w3 = w2 + 2 * q;
+	for (int s = 0; s < n; s += 4 * q) {
+		for (int j = 0; j < q; j++) {
+			double *p0 = p + 2 * (s + j);
+			double *p1 = p0 + 2 * q;
+			double *p2 = p1 + 2 * q;
+			double *p3 = p2 + 2 * q;
+			double a0r = p0[0] + p2[0], a0i = p0[1] + p2[1];
+			double br = p0[0] - p2[0], bi = p0[1] - p2[1];
+			double a1r = p1[0] + p3[0], a1i = p1[1] + p3[1];
+			double cr = p1[0] - p3[0], ci = p1[1] - p3[1];
+			p0[0] = a0r + a1r;
+			p0[1] = a0i + a1i;
+			cmul_store(p1, a0r - a1r, a0i - a1i, w2[2 * j], w2[2 * j + 1]);
+			cmul_store(p2, br + ci, bi - cr, w1[2 * j], w1[2 * j + 1]);	// b - ic
+			cmul_store(p3, br - ci, bi + cr, w3[2 * j], w3[2 * j + 1]);	// b + ic
+		}
+	}
+}
+
+static void r4_ct_stage_scalar(Complex *x, int n, int q, const Complex *w) {
+	double *p = (double *)x;
+	const double *w1 = (const double *)w;
+	const double *w2 = w1 + 2 * q;
+	const double *w3 = w2 + 2 * q;
+	double t1[2], t2[2], t3[2];
+	for (int s = 0; s < n; s += 4 * q) {
+		for (int j = 0; j < q; j++) {
+			double *p0 = p + 2 * (s + j);
+			double *p1 = p0 + 2 * q;
+			double *p2 = p1 + 2 * q;
+			double *p3 = p2 + 2 * q;
+			cmul_store(t1, p1[0], p1[1], w2[2 * j], w2[2 * j + 1]);
+			cmul_store(t2, p2[0], p2[1], w1[2 * j], w1[2 * j + 1]);
+			cmul_store(t3, p3[0], p3[1], w3[2 * j], w3[2 * j + 1]);
+			double a0r = p0[0] + t1[0], a0i = p0[1] + t1[1];
+			double a1r = p0[0] - t1[0], a1i = p0[1] - t1[1];
+			double sr = t2[0] + t3[0], si = t2[1] + t3[1];
+			double dr = t2[0] - t3[0], di = t2[1] - t3[1];
+			p0[0] = a0r + sr;
+			p0[1] = a0i + si;
+			p2[0] = a0r - sr;
+			p2[1] = a0i - si;
+			p1[0] = a1r - di;	// a1 + id
+			p1[1] = a1i + dr;
+			p3[0] = a1r + di;	// a1 - id
+			p3[1] = a1i - dr;
+		}
+	}
+}
+
+static void sr_gs_stage_scalar(Complex *x, int n, int q, const Complex *w) {
+	double *p = (double *)x;
+	const double *w1 = (const double *)w;
+	const double *w3 = w1 + 4 * q;
+	for (int s = 0; s < n; s += 4 * q) {
+		for (int j = 0; j < q; j++) {
+			double *p0 = p + 2 * (s + j);
+			double *p1 = p0 + 2 * q;
+			double *p2 = p1 + 2 * q;
+			double *p3 = p2 + 2 * q;
+			double br = p0[0] - p2[0], bi = p0[1] - p2[1];
+			double cr = p1[0] - p3[0], ci = p1[1] - p3[1];
+			p0[0] += p2[0];
+			p0[1] += p2[1];
+			p1[0] += p3[0];
+			p1[1] += p3[1];
+			cmul_store(p2, br + ci, bi - cr, w1[2 * j], w1[2 * j + 1]);
+			cmul_store(p3, br - ci, bi + cr, w3[2 * j], w3[2 * j + 1]);
+		}
+	}
+}
+
+static void sr_ct_stage_scalar(Complex *x, int n, int q, const Complex *w) {
+	double *p = (double *)x;
+	const double *w1 = (const double *)w;
+	const double *w3 = w1 + 4 * q;
+	double t2[2], t3[2];
+	for (int s = 0; s < n; s += 4 * q) {
+		for (int j = 0; j < q; j++) {
+			double *p0 = p + 2 * (s + j);
+			double *p1 = p0 + 2 * q;
+			double *p2 = p1 + 2 * q;
+			double *p3 = p2 + 2 * q;
+			cmul_store(t2, p2[0], p2[1], w1[2 * j], w1[2 * j + 1]);
+			cmul_store(t3, p3[0], p3[1], w3[2 * j], w3[2 * j + 1]);
+			double sr = t2[0] + t3[0], si = t2[1] + t3[1];
+			double dr = t2[0] - t3[0], di = t2[1] - t3[1];
+			p2[0] = p0[0] - sr;
+			p2[1] = p0[1] - si;
+			p0[0] += sr;
+			p0[1] += si;
+			p3[0] = p1[0] + di;
+			p3[1] = p1[1] - dr;
+			p1[0] -= di;
+			p1[1] += dr;
+		}
+	}
+}
+
+static void stockham_pass_scalar(const Complex *x, Complex *y, int m, int s, const Complex *w) {
+	const double *px = (const double *)x;
+	const double *pw = (const double *)w;
+	double *py = (double *)y;
+	for (int p = 0; p < m; p++) {
+		double wr = pw[2 * p], wi = pw[2 * p + 1];
+		const double *a = px + 2 * s * p;
+		const double *b = px + 2 * s * (p + m);
+		double *u = py + 4 * s * p;
+		double *v = u + 2 * s;
+		for (int q = 0; q < 2 * s; q += 2) {
+			double tr = a[q] - b[q], ti = a[q + 1] - b[q + 1];
+			u[q] = a[q] + b[q];
+			u[q + 1] = a[q + 1] + b[q + 1];
+			v[q] = tr * wr - ti * wi;
+			v[q + 1] = tr * wi + ti * wr;
+		}
+	}
+}
+
+template <bool Inv>
+static void stockham4_scalar(const Complex *x, Complex *y, int m, int s, const Complex *w) {
+	const double *px = (const double *)x;
+	const double *w1 = (const double *)w;
+	const double *w2 = w1 + 2 * m;
+	const double *w3 = w2 + 2 * m;
+	double *py = (double *)y;
+	for (int p = 0; p < m; p++) {
+		const double *a0 = px + 2 * s * p;
+		const double *a1 = a0 + 2 * s * m;
+		const double *a2 = a1 + 2 * s * m;
+		const double *a3 = a2 + 2 * s * m;
+		double *y0 = py + 8 * s * p;
+		double *y1 = y0 + 2 * s;
+		double *y2 = y1 + 2 * s;
+		double *y3 = y2 + 2 * s;
+		for (int q = 0; q < 2 * s; q += 2) {
+			double c0r = a0[q] + a2[q], c0i = a0[q + 1] + a2[q + 1];
+			double c1r = a0[q] - a2[q], c1i = a0[q + 1] - a2[q + 1];
+			double c2r = a1[q] + a3[q], c2i = a1[q + 1] + a3[q + 1];
+			double dr = a1[q] - a3[q], di = a1[q + 1] - a3[q + 1];
+			// c3 = -i d, or i d for the inverse
+			double c3r = Inv ? -di : di, c3i = Inv ? dr : -dr;
+			y0[q] = c0r + c2r;
+			y0[q + 1] = c0i + c2i;
+			cmul_store(y1 + q, c1r + c3r, c1i + c3i, w1[2 * p], w1[2 * p + 1]);
+			cmul_store(y2 + q, c0r - c2r, c0i - c2i, w2[2 * p], w2[2 * p + 1]);
+			cmul_store(y3 + q, c1r - c3r, c1i - c3i, w3[2 * p], w3[2 * p + 1]);
+		}
+	}
+}
+
+/* AVX2 + FMA, 2 complex per register */
+
+static inline AVX2 __m256d cmul(__m256d a, __m256d w) {
+	// (ar wr - ai wi, ai wr + ar wi)
+	__m256d wr = _mm256_movedup_pd(w);
+	__m256d wi = _mm256_permute_pd(w, 0xF);
+	__m256d as = _mm256_permute_pd(a, 0x5);
+	return _mm256_fmaddsub_pd(a, wr, _mm256_mul_pd(as, wi));
+}
+
+static AVX2 void gs_stage_avx2(Complex *x, int n, int half, const Complex *w) {
+	if (half < 2) {
+		gs_stage_scalar(x, n, half, w);
+		return;
+	}
+	double *p = (double *)x;
+	const double *q = (const double *)w;
+	for (int s = 0; s < n; s += 2 * half) {
+		double *pa = p + 2 * s;
+		double *pb = p + 2 * (s + half);
+		for (int j = 0; j < 2 * half; j += 4) {
+			__m256d a = _mm256_loadu_pd(pa + j);
+			__m256d b = _mm256_loadu_pd(pb + j);
+			_mm256_storeu_pd(pa + j, _mm256_add_pd(a, b));
+			_mm256_storeu_pd(pb + j, cmul(_mm256_sub_pd(a, b), _mm256_loadu_pd(q + j)));
+		}
+	}
+}
+
+static AVX2 void ct_stage_avx2(Complex *x, int n, int half, const Complex *w) {
+	if (half < 2) {
+		ct_stage_scalar(x, n, half, w);
+		return;
+	}
+	double *p = (double *)x;
+	const double *q = (const double *)w;
+	for (int s = 0; s < n; s += 2 * half) {
+		double *pa = p + 2 * s;
+		double *pb = p + 2 * (s + half);
+		for (int j = 0; j < 2 * half; j += 4) {
+			__m256d a = _mm256_loadu_pd(pa + j);
+			__m256d t = cmul(_mm256_loadu_pd(pb + j), _mm256_loadu_pd(q + j));
+			_mm256_storeu_pd(pa + j, _mm256_add_pd(a, t));
+			_mm256_storeu_pd(pb + j, _mm256_sub_pd(a, t));
+		}
+	}
+}
+
+static AVX2 void r4_gs_stage_avx2(Complex *x, int n, int q, const Complex *w) {
+	if (q < 2) {
+		r4_gs_stage_scalar(x, n, q, w);
+		return;
+	}
+	const __m256d ONE = _mm256_set1_pd(1.0);
+	double *p = (double *)x;
+	const double *w1 = (const double *)w;
+	const double *w2 = w1 + 2 * q;
+	const double *w3 = w2 + 2 * q;
+	for (int s = 0; s < n; s += 4 * q) {
+		double *p0 = p + 2 * s;
+		double *p1 = p0 + 2 * q;
+		double *p2 = p1 + 2 * q;
+		double *p3 = p2 + 2 * q;
+		for (int j = 0; j < 2 * q; j += 4) {
+			__m256d x0 = _mm256_loadu_pd(p0 + j), x1 = _mm256_loadu_pd(p1 + j);
+			__m256d x2 = _mm256_loadu_pd(p2 + j), x3 = _mm256_loadu_pd(p3 + j);
+			__m256d a0 = _mm256_add_pd(x0, x2), b = _mm256_sub_pd(x0, x2);
+			__m256d a1 = _mm256_add_pd(x1, x3), c = _mm256_permute_pd(_mm256_sub_pd(x1, x3), 0x5);
+			_mm256_storeu_pd(p0 + j, _mm256_add_pd(a0, a1));
+			_mm256_storeu_pd(p1 + j, cmul(_mm256_sub_pd(a0, a1), _mm256_loadu_pd(w2 + j)));
+			_mm256_storeu_pd(p2 + j, cmul(_mm256_fmsubadd_pd(b, ONE, c), _mm256_loadu_pd(w1 + j)));	// b - ic
+			_mm256_storeu_pd(p3 + j, cmul(_mm256_fmaddsub_pd(b, ONE, c), _mm256_loadu_pd(w3 + j)));	// b + ic
+		}
+	}
+}
+
+static AVX2 void r4_ct_stage_avx2(Complex *x, int n, int q, const Complex *w) {
+	if (q < 2) {
+		r4_ct_stage_scalar(x, n, q, w);
+		return;
+	}
+	const __m256d ONE = _mm256_set1_pd(1.0);
+	double *p = (double *)x;
+	const double *w1 = (const double *)w;
+	const double *w2 = w1 + 2 * q;
+	const double *w3 = w2 + 2 * q;
+	for (int s = 0; s < n; s += 4 * q) {
+		double *p0 = p + 2 * s;
+		double *p1 = p0 + 2 * q;
+		double *p2 = p1 + 2 * q;
+		double *p3 = p2 + 2 * q;
+		for (int j = 0; j < 2 * q; j += 4) {
+			__m256d x0 = _mm256_loadu_pd(p0 + j);
+			__m256d t1 = cmul(_mm256_loadu_pd(p1 + j), _mm256_loadu_pd(w2 + j));
+			__m256d t2 = cmul(_mm256_loadu_pd(p2 + j), _mm256_loadu_pd(w1 + j));
+			__m256d t3 = cmul(_mm256_loadu_pd(p3 + j), _mm256_loadu_pd(w3 + j));
+			__m256d a0 = _mm256_add_pd(x0, t1), a1 = _mm256_sub_pd(x0, t1);
+			__m256d sum = _mm256_add_pd(t2, t3), d = _mm256_permute_pd(_mm256_sub_pd(t2, t3), 0x5);
+			_mm256_storeu_pd(p0 + j, _mm256_add_pd(a0, sum));
+			_mm256_storeu_pd(p2 + j, _mm256_sub_pd(a0, sum));
+			_mm256_storeu_pd(p1 + j, _mm256_fmaddsub_pd(a1, ONE, d));	// a1 + id
+			_mm256_storeu_pd(p3 + j, _mm256_fmsubadd_pd(a1, ONE, d));	// a1 - id
+		}
+	}
+}
+
+static AVX2 void sr_gs_stage_avx2(Complex *x, int n, int q, const Complex *w) {
+	if (q < 2) {
+		sr_gs_stage_scalar(x, n, q, w);
+		return;
+	}
+	const __m256d ONE = _mm256_set1_pd(1.0);
+	double *p = (double *)x;
+	const double *w1 = (const double *)w;
+	const double *w3 = w1 + 4 * q;
+	for (int s = 0; s < n; s += 4 * q) {
+		double *p0 = p + 2 * s;
+		double *p1 = p0 + 2 * q;
+		double *p2 = p1 + 2 * q;
+		double *p3 = p2 + 2 * q;
+		for (int j = 0; j < 2 * q; j += 4) {
+			__m256d x0 = _mm256_loadu_pd(p0 + j), x1 = _mm256_loadu_pd(p1 + j);
+			__m256d x2 = _mm256_loadu_pd(p2 + j), x3 = _mm256_loadu_pd(p3 + j);
+			__m256d b = _mm256_sub_pd(x0, x2);
+			__m256d c = _mm256_permute_pd(_mm256_sub_pd(x1, x3), 0x5);
+			_mm256_storeu_pd(p0 + j, _mm256_add_pd(x0, x2));
+			_mm256_storeu_pd(p1 + j, _mm256_add_pd(x1, x3));
+			_mm256_storeu_pd(p2 + j, cmul(_mm256_fmsubadd_pd(b, ONE, c), _mm256_loadu_pd(w1 + j)));
+			_mm256_storeu_pd(p3 + j, cmul(_mm256_fmaddsub_pd(b, ONE, c), _mm256_loadu_pd(w3 + j)));
+		}
+	}
+}
+
+static AVX2 void sr_ct_stage_avx2(Complex *x, int n, int q, const Complex *w) {
+	if (q < 2) {
+		sr_ct_stage_scalar(x, n, q, w);
+		return;
+	}
+	const __m256d ONE = _mm256_set1_pd(1.0);
+	double *p = (double *)x;
+	const double *w1 = (const double *)w;
+	const double *w3 = w1 + 4 * q;
+	for (int s = 0; s < n; s += 4 * q) {
+		double *p0 = p + 2 * s;
+		double *p1 = p0 + 2 * q;
+		double *p2 = p1 + 2 * q;
+		double *p3 = p2 + 2 * q;
+		for (int j = 0; j < 2 * q; j += 4) {
+			__m256d a0 = _mm256_loadu_pd(p0 + j), a1 = _mm256_loadu_pd(p1 + j);
+			__m256d t2 = cmul(_mm256_loadu_pd(p2 + j), _mm256_loadu_pd(w1 + j));
+			__m256d t3 = cmul(_mm256_loadu_pd(p3 + j), _mm256_loadu_pd(w3 + j));
+			__m256d sum = _mm256_add_pd(t2, t3), d = _mm256_permute_pd(_mm256_sub_pd(t2, t3), 0x5);
+			_mm256_storeu_pd(p0 + j, _mm256_add_pd(a0, sum));
+			_mm256_storeu_pd(p2 + j, _mm256_sub_pd(a0, sum));
+			_mm256_storeu_pd(p1 + j, _mm256_fmaddsub_pd(a1, ONE, d));
+			_mm256_storeu_pd(p3 + j, _mm256_fmsubadd_pd(a1, ONE, d));
+		}
+	}
+}
+
+static AVX2 void stockham_pass_avx2(const Complex *x, Complex *y, int m, int s, const Complex *w) {
+	const double *px = (const double *)x;
+	const double *pw = (const double *)w;
+	double *py = (double *)y;
+	if (s == 1) {
+		if (m < 2) {
+			stockham_pass_scalar(x, y, m, s, w);
+			return;
+		}
+		// along p : y[2p], y[2p + 1], y[2p + 2], y[2p + 3] from the sums and differences of p, p + 1
+		for (int p = 0; p < m; p += 2) {
+			__m256d a = _mm256_loadu_pd(px + 2 * p), b = _mm256_loadu_pd(px + 2 * (p + m));
+			__m256d u = _mm256_add_pd(a, b);
+			__m256d v = cmul(_mm256_sub_pd(a, b), _mm256_loadu_pd(pw + 2 * p));
+			_mm256_storeu_pd(py + 4 * p, _mm256_permute2f128_pd(u, v, 0x20));
+			_mm256_storeu_pd(py + 4 * p + 4, _mm256_permute2f128_pd(u, v, 0x31));
+		}
+		return;
+	}
+	for (int p = 0; p < m; p++) {
+		__m256d wp = _mm256_broadcast_pd((const __m128d *)(pw + 2 * p));
+		const double *a = px + 2 * s * p;
+		const double *b = px + 2 * s * (p + m);
+		double *u = py + 4 * s * p;
+		double *v = u + 2 * s;
+		for (int q = 0; q < 2 * s; q += 4) {
+			__m256d xa = _mm256_loadu_pd(a + q), xb = _mm256_loadu_pd(b + q);
+			_mm256_storeu_pd(u + q, _mm256_add_pd(xa, xb));
+			_mm256_storeu_pd(v + q, cmul(_mm256_sub_pd(xa, xb), wp));
+		}
+	}
+}
+
+template <bool Inv>
+static AVX2 void stockham4_avx2(const Complex *x, Complex *y, int m, int s, const Complex *w) {
+	if (s == 1 && m < 2) {
+		stockham4_scalar<Inv>(x, y, m, s, w);
+		return;
+	}
+	const __m256d ONE = _mm256_set1_pd(1.0);
+	const double *px = (const double *)x;
+	const double *w1 = (const double *)w;
+	const double *w2 = w1 + 2 * m;
+	const double *w3 = w2 + 2 * m;
+	double *py = (double *)y;
+	if (s == 1) {
+		// along p, then the 4 outputs of p and p + 1 are regrouped by 128-bit lanes
+		for (int p = 0; p < m; p += 2) {
+			__m256d a0 = _mm256_loadu_pd(px + 2 * p), a1 = _mm256_loadu_pd(px + 2 * (p + m));
+			__m256d a2 = _mm256_loadu_pd(px + 2 * (p + 2 * m)), a3 = _mm256_loadu_pd(px + 2 * (p + 3 * m));
+			__m256d c0 = _mm256_add_pd(a0, a2), c1 = _mm256_sub_pd(a0, a2);
+			__m256d c2 = _mm256_add_pd(a1, a3), d = _mm256_permute_pd(_mm256_sub_pd(a1, a3), 0x5);
+			__m256d b1 = Inv ? _mm256_fmaddsub_pd(c1, ONE, d) : _mm256_fmsubadd_pd(c1, ONE, d);
+			__m256d b3 = Inv ? _mm256_fmsubadd_pd(c1, ONE, d) : _mm256_fmaddsub_pd(c1, ONE, d);
+			__m256d y0 = _mm256_add_pd(c0, c2);
+			__m256d y1 = cmul(b1, _mm256_loadu_pd(w1 + 2 * p));
+			__m256d y2 = cmul(_mm256_sub_pd(c0, c2), _mm256_loadu_pd(w2 + 2 * p));
+			__m256d y3 = cmul(b3, _mm256_loadu_pd(w3 + 2 * p));
+			double *o = py + 8 * p;
+			_mm256_storeu_pd(o, _mm256_permute2f128_pd(y0, y1, 0x20));
+			_mm256_storeu_pd(o + 4, _mm256_permute2f128_pd(y2, y3, 0x20));
+			_mm256_storeu_pd(o + 8, _mm256_permute2f128_pd(y0, y1, 0x31));
+			_mm256_storeu_pd(o + 12, _mm256_permute2f128_pd(y2, y3, 0x31));
+		}
+		return;
+	}
+	for (int p = 0; p < m; p++) {
+		__m256d t1 = _mm256_broadcast_pd((const __m128d *)(w1 + 2 * p));
+		__m256d t2 = _mm256_broadcast_pd((const __m128d *)(w2 + 2 * p));
+		__m256d t3 = _mm256_broadcast_pd((const __m128d *)(w3 + 2 * p));
+		const double *x0 = px + 2 * s * p;
+		const double *x1 = x0 + 2 * s * m;
+		const double *x2 = x1 + 2 * s * m;
+		const double *x3 = x2 + 2 * s * m;
+		double *o = py + 8 * s * p;
+		for (int q = 0; q < 2 * s; q += 4) {
+			__m256d a0 = _mm256_loadu_pd(x0 + q), a1 = _mm256_loadu_pd(x1 + q);
+			__m256d a2 = _mm256_loadu_pd(x2 + q), a3 = _mm256_loadu_pd(x3 + q);
+			__m256d c0 = _mm256_add_pd(a0, a2), c1 = _mm256_sub_pd(a0, a2);
+			__m256d c2 = _mm256_add_pd(a1, a3), d = _mm256_permute_pd(_mm256_sub_pd(a1, a3), 0x5);
+			__m256d b1 = Inv ? _mm256_fmaddsub_pd(c1, ONE, d) : _mm256_fmsubadd_pd(c1, ONE, d);
+			__m256d b3 = Inv ? _mm256_fmsubadd_pd(c1, ONE, d) : _mm256_fmaddsub_pd(c1, ONE, d);
+			_mm256_storeu_pd(o + q, _mm256_add_pd(c0, c2));
+			_mm256_storeu_pd(o + 2 * s + q, cmul(b1, t1));
+			_mm256_storeu_pd(o + 4 * s + q, cmul(_mm256_sub_pd(c0, c2), t2));
+			_mm256_storeu_pd(o + 6 * s + q, cmul(b3, t3));
+		}
+	}
+}
+
+/* AVX-512 F, 4 complex per register */
+
+static inline AVX512 __m512d cmul(__m512d a, __m512d w) {
+	__m512d wr = _mm512_movedup_pd(w);
+	__m512d wi = _mm512_permute_pd(w, 0xFF);
+	__m512d as = _mm512_permute_pd(a, 0x55);
+	return _mm512_fmaddsub_pd(a, wr, _mm512_mul_pd(as, wi));
+}
+
+static AVX512 void gs_stage_avx512(Complex *x, int n, int half, const Complex *w) {
+	if (half < 4) {
+		gs_stage_avx2(x, n, half, w);
+		return;
+	}
+	double *p = (double *)x;
+	const double *q = (const double *)w;
+	for (int s = 0; s < n; s += 2 * half) {
+		double *pa = p + 2 * s;
+		double *pb = p + 2 * (s + half);
+		for (int j = 0; j < 2 * half; j += 8) {
+			__m512d a = _mm512_loadu_pd(pa + j);
+			__m512d b = _mm512_loadu_pd(pb + j);
+			_mm512_storeu_pd(pa + j, _mm512_add_pd(a, b));
+			_mm512_storeu_pd(pb + j, cmul(_mm512_sub_pd(a, b), _mm512_loadu_pd(q + j)));
+		}
+	}
+}
+
+static AVX512 void ct_stage_avx512(Complex *x, int n, int half, const Complex *w) {
+	if (half < 4) {
+		ct_stage_avx2(x, n, half, w);
+		return;
+	}
+	double *p = (double *)x;
+	const double *q = (const double *)w;
+	for (int s = 0; s < n; s += 2 * half) {
+		double *pa = p + 2 * s;
+		double *pb = p + 2 * (s + half);
+		for (int j = 0; j < 2 * half; j += 8) {
+			__m512d a = _mm512_loadu_pd(pa + j);
+			__m512d t = cmul(_mm512_loadu_pd(pb + j), _mm512_loadu_pd(q + j));
+			_mm512_storeu_pd(pa + j, _mm512_add_pd(a, t));
+			_mm512_storeu_pd(pb + j, _mm512_sub_pd(a, t));
+		}
+	}
+}
+
+static AVX512 void r4_gs_stage_avx512(Complex *x, int n, int q, const Complex *w) {
+	if (q < 4) {
+		r4_gs_stage_avx2(x, n, q, w);
+		return;
+	}
+	const __m512d ONE = _mm512_set1_pd(1.0);
+	double *p = (double *)x;
+	const double *w1 = (const double *)w;
+	const double *w2 = w1 + 2 * q;
+	const double *w3 = w2 + 2 * q;
+	for (int s = 0; s < n; s += 4 * q) {
+		double *p0 = p + 2 * s;
+		double *p1 = p0 + 2 * q;
+		double *p2 = p1 + 2 * q;
+		double *p3 = p2 + 2 * q;
+		for (int j = 0; j < 2 * q; j += 8) {
+			__m512d x0 = _mm512_loadu_pd(p0 + j), x1 = _mm512_loadu_pd(p1 + j);
+			__m512d x2 = _mm512_loadu_pd(p2 + j), x3 = _mm512_loadu_pd(p3 + j);
+			__m512d a0 = _mm512_add_pd(x0, x2), b = _mm512_sub_pd(x0, x2);
+			__m512d a1 = _mm512_add_pd(x1, x3), c = _mm512_permute_pd(_mm512_sub_pd(x1, x3), 0x55);
+			_mm512_storeu_pd(p0 + j, _mm512_add_pd(a0, a1));
+			_mm512_storeu_pd(p1 + j, cmul(_mm512_sub_pd(a0, a1), _mm512_loadu_pd(w2 + j)));
+			_mm512_storeu_pd(p2 + j, cmul(_mm512_fmsubadd_pd(b, ONE, c), _mm512_loadu_pd(w1 + j)));	// b - ic
+			_mm512_storeu_pd(p3 + j, cmul(_mm512_fmaddsub_pd(b, ONE, c), _mm512_loadu_pd(w3 + j)));	// b + ic
+		}
+	}
+}
+
+static AVX512 void r4_ct_stage_avx512(Complex *x, int n, int q, const Complex *w) {
+	if (q < 4) {
+		r4_ct_stage_avx2(x, n, q, w);
+		return;
+	}
+	const __m512d ONE = _mm512_set1_pd(1.0);
+	double *p = (double *)x;
+	const double *w1 = (const double *)w;
+	const double *w2 = w1 + 2 * q;
+	const double *w3 = w2 + 2 * q;
+	for (int s = 0; s < n; s += 4 * q) {
+		double *p0 = p + 2 * s;
+		double *p1 = p0 + 2 * q;
+		double *p2 = p1 + 2 * q;
+		double *p3 = p2 + 2 * q;
+		for (int j = 0; j < 2 * q; j += 8) {
+			__m512d x0 = _mm512_loadu_pd(p0 + j);
+			__m512d t1 = cmul(_mm512_loadu_pd(p1 + j), _mm512_loadu_pd(w2 + j));
+			__m512d t2 = cmul(_mm512_loadu_pd(p2 + j), _mm512_loadu_pd(w1 + j));
+			__m512d t3 = cmul(_mm512_loadu_pd(p3 + j), _mm512_loadu_pd(w3 + j));
+			__m512d a0 = _mm512_add_pd(x0, t1), a1 = _mm512_sub_pd(x0, t1);
+			__m512d sum = _mm512_add_pd(t2, t3), d = _mm512_permute_pd(_mm512_sub_pd(t2, t3), 0x55);
+			_mm512_storeu_pd(p0 + j, _mm512_add_pd(a0, sum));
+			_mm512_storeu_pd(p2 + j, _mm512_sub_pd(a0, sum));
+			_mm512_storeu_pd(p1 + j, _mm512_fmaddsub_pd(a1, ONE, d));	// a1 + id
+			_mm512_storeu_pd(p3 + j, _mm512_fmsubadd_pd(a1, ONE, d));	// a1 - id
+		}
+	}
+}
+
+static AVX512 void sr_gs_stage_avx512(Complex *x, int n, int q, const Complex *w) {
+	if (q < 4) {
+		sr_gs_stage_avx2(x, n, q, w);
+		return;
+	}
+	const __m512d ONE = _mm512_set1_pd(1.0);
+	double *p = (double *)x;
+	const double *w1 = (const double *)w;
+	const double *w3 = w1 + 4 * q;
+	for (int s = 0; s < n; s += 4 * q) {
+		double *p0 = p + 2 * s;
+		double *p1 = p0 + 2 * q;
+		double *p2 = p1 + 2 * q;
+		double *p3 = p2 + 2 * q;
+		for (int j = 0; j < 2 * q; j += 8) {
+			__m512d x0 = _mm512_loadu_pd(p0 + j), x1 = _mm512_loadu_pd(p1 + j);
+			__m512d x2 = _mm512_loadu_pd(p2 + j), x3 = _mm512_loadu_pd(p3 + j);
+			__m512d b = _mm512_sub_pd(x0, x2);
+			__m512d c = _mm512_permute_pd(_mm512_sub_pd(x1, x3), 0x55);
+			_mm512_storeu_pd(p0 + j, _mm512_add_pd(x0, x2));
+			_mm512_storeu_pd(p1 + j, _mm512_add_pd(x1, x3));
+			_mm512_storeu_pd(p2 + j, cmul(_mm512_fmsubadd_pd(b, ONE, c), _mm512_loadu_pd(w1 + j)));
+			_mm512_storeu_pd(p3 + j, cmul(_mm512_fmaddsub_pd(b, ONE, c), _mm512_loadu_pd(w3 + j)));
+		}
+	}
+}
+
+static AVX512 void sr_ct_stage_avx512(Complex *x, int n, int q, const Complex *w) {
+	if (q < 4) {
+		sr_ct_stage_avx2(x, n, q, w);
+		return;
+	}
+	const __m512d ONE = _mm512_set1_pd(1.0);
+	double *p = (double *)x;
+	const double *w1 = (const double *)w;
+	const double *w3 = w1 + 4 * q;
+	for (int s = 0; s < n; s += 4 * q) {
+		double *p0 = p + 2 * s;
+		double *p1 = p0 + 2 * q;
+		double *p2 = p1 + 2 * q;
+		double *p3 = p2 + 2 * q;
+		for (int j = 0; j < 2 * q; j += 8) {
+			__m512d a0 = _mm512_loadu_pd(p0 + j), a1 = _mm512_loadu_pd(p1 + j);
+			__m512d t2 = cmul(_mm512_loadu_pd(p2 + j), _mm512_loadu_pd(w1 + j));
+			__m512d t3 = cmul(_mm512_loadu_pd(p3 + j), _mm512_loadu_pd(w3 + j));
+			__m512d sum = _mm512_add_pd(t2, t3), d = _mm512_permute_pd(_mm512_sub_pd(t2, t3), 0x55);
+			_mm512_storeu_pd(p0 + j, _mm512_add_pd(a0, sum));
+			_mm512_storeu_pd(p2 + j, _mm512_sub_pd(a0, sum));
+			_mm512_storeu_pd(p1 + j, _mm512_fmaddsub_pd(a1, ONE, d));
+			_mm512_storeu_pd(p3 + j, _mm512_fmsubadd_pd(a1, ONE, d));
+		}
+	}
+}
+
+static inline AVX512 __m512d broadcast_complex(const double *w) {
+	// one complex in every 128-bit lane
+	return _mm512_castps_pd(_mm512_broadcast_f32x4(_mm_castpd_ps(_mm_loadu_pd(w))));
+}
+
+static AVX512 void stockham_pass_avx512(const Complex *x, Complex *y, int m, int s, const Complex *w) {
+	if (s < 4) {
+		stockham_pass_avx2(x, y, m, s, w);
+		return;
+	}
+	const double *px = (const double *)x;
+	const double *pw = (const double *)w;
+	double *py = (double *)y;
+	for (int p = 0; p < m; p++) {
+		__m512d wp = broadcast_complex(pw + 2 * p);
+		const double *a = px + 2 * s * p;
+		const double *b = px + 2 * s * (p + m);
+		double *u = py + 4 * s * p;
+		double *v = u + 2 * s;
+		for (int q = 0; q < 2 * s; q += 8) {
+			__m512d xa = _mm512_loadu_pd(a + q), xb = _mm512_loadu_pd(b + q);
+			_mm512_storeu_pd(u + q, _mm512_add_pd(xa, xb));
+			_mm512_storeu_pd(v + q, cmul(_mm512_sub_pd(xa, xb), wp));
+		}
+	}
+}
+
+template <bool Inv>
+static AVX512 void stockham4_avx512(const Complex *x, Complex *y, int m, int s, const Complex *w) {
+	if (s < 4) {
+		stockham4_avx2<Inv>(x, y, m, s, w);
+		return;
+	}
+	const __m512d ONE = _mm512_set1_pd(1.0);
+	const double *px = (const double *)x;
+	const double *w1 = (const double *)w;
+	const double *w2 = w1 + 2 * m;
+	const double *w3 = w2 + 2 * m;
+	double *py = (double *)y;
+	for (int p = 0; p < m; p++) {
+		__m512d t1 = broadcast_complex(w1 + 2 * p);
+		__m512d t2 = broadcast_complex(w2 + 2 * p);
+		__m512d t3 = broadcast_complex(w3 + 2 * p);
+		const double *x0 = px + 2 * s * p;
+		const double *x1 = x0 + 2 * s * m;
+		const double *x2 = x1 + 2 * s * m;
+		const double *x3 = x2 + 2 * s * m;
+		double *o = py + 8 * s * p;
+		for (int q = 0; q < 2 * s; q += 8) {
+			__m512d a0 = _mm512_loadu_pd(x0 + q), a1 = _mm512_loadu_pd(x1 + q);
+			__m512d a2 = _mm512_loadu_pd(x2 + q), a3 = _mm512_loadu_pd(x3 + q);
+			__m512d c0 = _mm512_add_pd(a0, a2), c1 = _mm512_sub_pd(a0, a2);
+			__m512d c2 = _mm512_add_pd(a1, a3), d = _mm512_permute_pd(_mm512_sub_pd(a1, a3), 0x55);
+			__m512d b1 = Inv ? _mm512_fmaddsub_pd(c1, ONE, d) : _mm512_fmsubadd_pd(c1, ONE, d);
+			__m512d b3 = Inv ? _mm512_fmsubadd_pd(c1, ONE, d) : _mm512_fmaddsub_pd(c1, ONE, d);
+			_mm512_storeu_pd(o + q, _mm512_add_pd(c0, c2));
+			_mm512_storeu_pd(o + 2 * s + q, cmul(b1, t1));
+			_mm512_storeu_pd(o + 4 * s + q, cmul(_mm512_sub_pd(c0, c2), t2));
+			_mm512_storeu_pd(o + 6 * s + q, cmul(b3, t3));
+		}
+	}
+}
+
+FftKernels fft_kernels(cpu_isa isa) {
+	FftKernels k;
+	k.isa = cpu_resolve_isa(isa);
+	switch (k.isa) {
+	case ISA_AVX512:
+		k.gs_stage = gs_stage_avx512;
+		k.ct_stage = ct_stage_avx512;
+		k.r4_gs_stage = r4_gs_stage_avx512;
+		k.r4_ct_stage = r4_ct_stage_avx512;
+		k.sr_gs_stage = sr_gs_stage_avx512;
+		k.sr_ct_stage = sr_ct_stage_avx512;
+		k.stockham_pass = stockham_pass_avx512;
+		k.stockham4_fwd = stockham4_avx512<false>;
+		k.stockham4_inv = stockham4_avx512<true>;
+		break;
+	case ISA_AVX2:
+		k.gs_stage = gs_stage_avx2;
+		k.ct_stage = ct_stage_avx2;
+		k.r4_gs_stage = r4_gs_stage_avx2;
+		k.r4_ct_stage = r4_ct_stage_avx2;
+		k.sr_gs_stage = sr_gs_stage_avx2;
+		k.sr_ct_stage = sr_ct_stage_avx2;
+		k.stockham_pass = stockham_pass_avx2;
+		k.stockham4_fwd = stockham4_avx2<false>;
+		k.stockham4_inv = stockham4_avx2<true>;
+		break;
+	default:
+		k.isa = ISA_SCALAR;
+		k.gs_stage = gs_stage_scalar;
+		k.ct_stage = ct_stage_scalar;
+		k.r4_gs_stage = r4_gs_stage_scalar;
+		k.r4_ct_stage = r4_ct_stage_scalar;
+		k.sr_gs_stage = sr_gs_stage_scalar;
+		k.sr_ct_stage = sr_ct_stage_scalar;
+		k.stockham_pass = stockham_pass_scalar;
+		k.stockham4_fwd = stockham4_scalar<false>;
+		k.stockham4_inv = stockham4_scalar<true>;
+		break;
+	}
+	return k;
+}
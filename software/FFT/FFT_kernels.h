@@ -0,0 +1,94 @@
+/*
+ * FFT_kernels.h
+ *
+ * Description
+ * Butterfly stages of FFT_GSCT.cpp (BFU_GS / BFU_CT) for the scalar, AVX2 + FMA
+ * and AVX-512 F kernels, one function call per stage
+ *
+ *   gs_stage   DIF-FFT stage (Gentleman-Sande) : a, b -> a + b, (a - b) * w[j]
+ *   ct_stage   DIT-FFT stage (Cooley-Tukey)    : a, b -> a + w[j] * b, a - w[j] * b
+ *
+ * For every block of 2 * half values, a = x[s + j] and b = x[s + j + half],
+ * j in [0, half), w holds the half twiddles of the stage, e.g. W(j, 2 * half)
+ * A forward FFT runs gs_stage() from half = n / 2 down to 1 (bit-reversed output),
+ * the inverse runs ct_stage() from half = 1 up to n / 2 with the conjugate twiddles
+ *
+ * Radix-4 and split-radix, blocks of 4 * q values x0..x3 = x[s + j + {0, 1, 2, 3} * q],
+ * j in [0, q), w holds 3 * q twiddles : W(j, 4q) | W(2j, 4q) | W(3j, 4q)
+ *
+ *   r4_gs_stage   two DIF stages (half = 2q and q) fused, same output positions,
+ *                 3 complex multiplies for 4 values instead of 4
+ *   r4_ct_stage   two DIT stages (half = q and 2q) fused
+ *   sr_gs_stage   split-radix DIF step : x0 + x2 and x1 + x3 stay for the 2q-point sub-FFT,
+ *                 (x0 - x2 -+ i (x1 - x3)) * W(j or 3j, 4q) go to the two q-point sub-FFTs
+ *   sr_ct_stage   split-radix DIT step, the inverse arrangement
+ *
+ * The output order stays bit-reversed, whatever mix of stages is used
+ *
+ * Stockham auto-sort pass, out of place from x to y, n = 2 * m * s values
+ *
+ *   stockham_pass   a = x[q + s p], b = x[q + s (p + m)], p in [0, m), q in [0, s)
+ *                   y[q + 2 s p] = a + b, y[q + s (2p + 1)] = (a - b) * w[p]
+ *
+ * w holds the m twiddles W(p, 2m), the same as gs_stage with half = m
+ *
+ *   stockham4_fwd   radix-4 pass, n = 4 * m * s, a_r = x[q + s (p + r m)], r in [0, 4)
+ *                   y[q + s (4p + k)] = (sum_r a_r W(rk, 4)) * W(kp, 4m)
+ *   stockham4_inv   the same with W(rk, 4) conjugated, for the inverse transform
+ * w holds 3 * m twiddles : W(p, 4m) | W(2p, 4m) | W(3p, 4m), as r4_gs_stage with q = m
+ *
+ * Passes of any radix, s growing by the radix from s = 1 to n / radix, give the natural
+ * order, every access has unit stride in q (or in p while s is below a register)
+ *
+ * The SIMD kernels multiply with fmaddsub, the results can differ from the scalar
+ * kernel in the last bit, stages narrower than a register use the scalar code
+ *
+ * fft_kernels() resolves the ISA once (cpu_dispatch.h), a plan keeps the result
+ *
+ * cmul() is the scalar complex multiply shared by the transforms built on the kernels
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * 2026/10/17	jorjor	Radix-4 and split-radix stages
+ * 2026/10/17	jorjor	Stockham pass
+ * 2026/10/17	jorjor	cmul()
+ * */
+
+#ifndef FFT_KERNELS_H
+#define FFT_KERNELS_H
+
+#include <complex>
+
+#include "cpu_dispatch.h"
+
+typedef std::complex<double> Complex;
+
+static inline Complex cmul(const Complex &a, const Complex &b) {
+	// written out with real arithmetic, operator* checks for NaN / inf
+	return Complex(a.real() * b.real() - a.imag() * b.imag(), a.real() * b.imag() + a.imag() * b.real());
+}
+
+typedef void (*fft_stage_fn)(Complex *x, int n, int half, const Complex *w);
+
+typedef void (*fft_pass_fn)(const Complex *x, Complex *y, int m, int s, const Complex *w);
+
+struct FftKernels {
+	cpu_isa isa;
+	fft_stage_fn gs_stage;
+	fft_stage_fn ct_stage;
+
+	// (x, n, q, w)
+	fft_stage_fn r4_gs_stage;
+	fft_stage_fn r4_ct_stage;
+	fft_stage_fn sr_gs_stage;
+	fft_stage_fn sr_ct_stage;
+
+	fft_pass_fn stockham_pass;
+	fft_pass_fn stockham4_fwd;
+	fft_pass_fn stockham4_inv;
+};
+
+// isa : ISA_AUTO or the highest ISA the kernels may use
+FftKernels fft_kernels(cpu_isa isa = ISA_AUTO);
+
+#endif
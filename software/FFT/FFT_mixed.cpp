@@ -0,0 +1,183 @@
+/*
+ * FFT_mixed.cpp
+ *
+ * Description
+ * Implementation of FftMixed, see FFT_mixed.h
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * 2026/10/17	jorjor	Twiddles from root_of_unity()
+ * */
+
+#include "FFT_mixed.h"
+#include "FFT_plan.h"
+
+#include <stdexcept>
+
+using namespace std;
+
+bool FftMixed::supported(int n) {
+	if (n < 1) return false;
+	const int primes[4] = { 2, 3, 5, 7 };
+	for (int i = 0; i < 4; i++) {
+		while (n % primes[i] == 0) n /= primes[i];
+	}
+	return n == 1;
+}
+
+FftMixed::FftMixed(int n) : n_(n) {
+	if (n > (1 << 28) || !supported(n)) {
+		throw invalid_argument("FftMixed: n must be in [1, 2^28] with no prime factor above 7");
+	}
+
+	int r = n;
+	while (r % 4 == 0) {
+		radices_.push_back(4);
+		r /= 4;
+	}
+	const int primes[4] = { 2, 3, 5, 7 };
+	for (int i = 0; i < 4; i++) {
+		while (r % primes[i] == 0) {
+			radices_.push_back(primes[i]);
+			r /= primes[i];
+		}
+	}
+
+	// pass i runs on sub-transforms of length l, W(jk, l) for j < l / p
+	int l = n;
+	for (size_t i = 0; i < radices_.size(); i++) {
+		int p = radices_[i];
+		int m = l / p;
+		offset_.push_back(tw_.size());
+		for (int j = 0; j < m; j++) {
+			for (int k = 1; k < p; k++) {
+				tw_.push_back(root_of_unity(j * k, l));
+			}
+		}
+		l = m;
+	}
+
+	for (int p = 3; p <= 7; p += 2) {
+		for (int k = 0; k < p; k++) {
+			c_[p][k] = root_of_unity(k, p);
+		}
+	}
+}
+
+static void pass_r2(const Complex *x, Complex *y, int m, int s, const Complex *tw) {
+	for (int j = 0; j < m; j++) {
+		Complex w = tw[j];
+		for (int q = 0; q < s; q++) {
+			// BFU_GS
+			Complex a0 = x[q + s * j];
+			Complex a1 = x[q + s * (j + m)];
+			y[q + s * (2 * j)] = a0 + a1;
+			y[q + s * (2 * j + 1)] = cmul(a0 - a1, w);
+		}
+	}
+}
+
+static void pass_r4(const Complex *x, Complex *y, int m, int s, const Complex *tw) {
+	for (int j = 0; j < m; j++) {
+		Complex w1 = tw[3 * j], w2 = tw[3 * j + 1], w3 = tw[3 * j + 2];
+		for (int q = 0; q < s; q++) {
+			Complex a0 = x[q + s * j];
+			Complex a1 = x[q + s * (j + m)];
+			Complex a2 = x[q + s * (j + 2 * m)];
+			Complex a3 = x[q + s * (j + 3 * m)];
+			Complex t0 = a0 + a2, t1 = a0 - a2;
+			Complex t2 = a1 + a3, t3 = a1 - a3;
+			// -i t3
+			Complex u = Complex(t3.imag(), -t3.real());
+			y[q + s * (4 * j)] = t0 + t2;
+			y[q + s * (4 * j + 1)] = cmul(t1 + u, w1);
+			y[q + s * (4 * j + 2)] = cmul(t0 - t2, w2);
+			y[q + s * (4 * j + 3)] = cmul(t1 - u, w3);
+		}
+	}
+}
+
+template <int P>
+static void pass_odd(const Complex *x, Complex *y, int m, int s, const Complex *tw, const Complex *c) {
+	// c[k] = W(k, P), the pairs r, P - r give m_k -+ i n_k
+	const int H = P / 2;
+	double cr[H + 1][H + 1], ci[H + 1][H + 1];
+	for (int k = 1; k <= H; k++) {
+		for (int r = 1; r <= H; r++) {
+			cr[k][r] = c[(r * k) % P].real();
+			ci[k][r] = -c[(r * k) % P].imag();	// sin(2 pi rk / P)
+		}
+	}
+
+	for (int j = 0; j < m; j++) {
+		const Complex *w = &tw[j * (P - 1)];
+		for (int q = 0; q < s; q++) {
+			Complex a0 = x[q + s * j];
+			Complex sum[H + 1], dif[H + 1];
+			Complex b0 = a0;
+			for (int r = 1; r <= H; r++) {
+				Complex u = x[q + s * (j + r * m)];
+				Complex v = x[q + s * (j + (P - r) * m)];
+				sum[r] = u + v;
+				dif[r] = u - v;
+				b0 += sum[r];
+			}
+			y[q + s * (P * j)] = b0;
+			for (int k = 1; k <= H; k++) {
+				double mr = a0.real(), mi = a0.imag(), nr = 0, ni = 0;
+				for (int r = 1; r <= H; r++) {
+					mr += cr[k][r] * sum[r].real();
+					mi += cr[k][r] * sum[r].imag();
+					nr += ci[k][r] * dif[r].real();
+					ni += ci[k][r] * dif[r].imag();
+				}
+				// b[k] = m - i n, b[P - k] = m + i n
+				y[q + s * (P * j + k)] = cmul(Complex(mr + ni, mi - nr), w[k - 1]);
+				y[q + s * (P * j + P - k)] = cmul(Complex(mr - ni, mi + nr), w[P - k - 1]);
+			}
+		}
+	}
+}
+
+void FftMixed::forward(Complex *x, Complex *tmp) const {
+	vector<Complex> own;
+	if (tmp == NULL) {
+		own.resize(n_);
+		tmp = own.data();
+	}
+
+	Complex *src = x, *dst = tmp;
+	int m = n_, s = 1;
+	for (size_t i = 0; i < radices_.size(); i++) {
+		const int p = radices_[i];
+		const Complex *tw = &tw_[offset_[i]];
+		m /= p;
+		switch (p) {
+		case 2:	pass_r2(src, dst, m, s, tw); break;
+		case 3:	pass_odd<3>(src, dst, m, s, tw, c_[3]); break;
+		case 4:	pass_r4(src, dst, m, s, tw); break;
+		case 5:	pass_odd<5>(src, dst, m, s, tw, c_[5]); break;
+		default:	pass_odd<7>(src, dst, m, s, tw, c_[7]); break;
+		}
+		s *= p;
+		Complex *t = src;
+		src = dst;
+		dst = t;
+	}
+	if (src != x) {
+		for (int i = 0; i < n_; i++) {
+			x[i] = src[i];
+		}
+	}
+}
+
+void FftMixed::inverse(Complex *x, Complex *tmp) const {
+	for (int j = 0; j < n_; j++) {
+		x[j] = conj(x[j]);
+	}
+	forward(x, tmp);
+	const double scale = 1.0 / n_;
+	for (int j = 0; j < n_; j++) {
+		x[j] = conj(x[j]) * scale;
+	}
+}
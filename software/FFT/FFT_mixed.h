@@ -0,0 +1,68 @@
+/*
+ * FFT_mixed.h
+ *
+ * Description
+ * Mixed-radix complex FFT for n = 2^a 3^b 5^c 7^d (frame sizes such as 1920 or 3000)
+ * FftPlan needs a power of 2 and FftBluestein (FFT_bluestein.h) pays two
+ * power-of-2 transforms of at least 2n - 1 points, here n is factored and every
+ * factor is one pass of radix-4, 2, 3, 5 or 7 butterflies :
+ *
+ *   BFU_R2 / BFU_R4   the radix-2 butterfly of BFU_GS, radix-4 as two of its layers
+ *   BFU_R3/5/7        p-point DFT of an odd prime p, the pairs a[r] +- a[p - r] share
+ *                     their products : b[k], b[p - k] = m_k -+ i n_k,
+ *                     m_k = a0 + sum cos(2 pi rk / p) (a[r] + a[p - r]),
+ *                     n_k = sum sin(2 pi rk / p) (a[r] - a[p - r])
+ *
+ * Stockham auto-sort, decimation in frequency : the pass of radix p over a
+ * sub-transform of length l = p m and stride s reads x[q + s (j + r m)], writes
+ * y[q + s (p j + k)] = W(jk, l) b[k], and the next pass runs on length m with
+ * stride s p. Natural order in and out, no permutation, two buffers in turn
+ * The stage order is radix-4 while 4 divides n, then 2, 3, 5, 7 : the radix-4
+ * passes do the most work per pass, the small odd radices end on long
+ * unit-stride inner loops
+ *
+ *   forward   X[k] = sum x[j] e^(-2 pi i jk / n)
+ *   inverse   x[j] = 1/n sum X[k] e^(2 pi i jk / n), conj(forward(conj(X))) / n
+ *
+ * The twiddles of every pass are computed once, correctly rounded in long double
+ * The object is read-only after construction and can be shared between threads
+ * when every thread passes its own tmp
+ * n with another prime factor throws std::invalid_argument, use FftBluestein
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * */
+
+#ifndef FFT_MIXED_H
+#define FFT_MIXED_H
+
+#include <vector>
+
+#include "FFT_kernels.h"
+
+class FftMixed {
+public:
+	// n : 7-smooth, in [1, 2^28]
+	explicit FftMixed(int n);
+
+	// true when n > 0 has no prime factor above 7
+	static bool supported(int n);
+
+	int size() const { return n_; }
+
+	// radix of every pass, in the order they run
+	const std::vector<int> &radices() const { return radices_; }
+
+	// in-place, tmp holds n values, or is NULL and allocated here
+	void forward(Complex *x, Complex *tmp = NULL) const;
+	void inverse(Complex *x, Complex *tmp = NULL) const;
+
+private:
+	int n_;
+	std::vector<int> radices_;
+	std::vector<size_t> offset_;	// twiddles of pass i at tw_[offset_[i]]
+	std::vector<Complex> tw_;		// W(jk, l) at j (p - 1) + k - 1, j < m, 1 <= k < p
+	Complex c_[8][8];				// W(rk, p) of the odd radices, c_[p][rk mod p]
+};
+
+#endif
@@ -10,12 +10,17 @@
  *
  * History
  * 2023/05/10	jorjor	First release
+ * 2026/10/17	jorjor	Twiddle tables built once, integer loop bounds
+ * 2026/10/17	jorjor	Bit-reverse permutation from bitrev.h
+ * 2026/10/17	jorjor	right_rotate() in place, streaming filters in FFT_fir.h
  * */
 
 #include <iostream>
 #include <complex>
 #include <cmath>
 
+#include "../bitrev.h"
+
 using namespace std;
 
 typedef complex<double> Complex;
@@ -32,17 +37,6 @@ void bufferfly_unit(Complex* arr, int i, int j, Complex w) {
     arr[j] = temp1 - w * temp2;
 }
 
-int reverse(int num,int len) { // reverse bit
-    int out = 0;
-    for (int i = 0; i < len; i++){
-        if (num & 1) {
-            out += pow(2, len - i - 1);
-        }
-        num >>= 1;
-    }
-    return out;
-}
-
 void print(double* arr, int len) {
     cout << "[ ";
     for (int i = 0; i < len; i++) {
@@ -78,20 +72,25 @@ Complex W(int m, int n, bool stat) {
     return w;
 }
 
-void right_rotate(double* arr, int len){
-	double *temp = new double[len];
-	
-	// copy
-	for (int i = 0; i < len; i++) {
-		temp[i] = arr[i];
-	}
+Complex* twiddle_table(int n, bool stat) {
+	// W(distance, 2 * half, stat) of the stage with half = 2^(step - 1) at table[half + distance]
+	// built once, the butterfly loops only read it
+    Complex* table = new Complex[n];
+    for (int half = 1; half < n; half <<= 1) {
+        for (int distance = 0; distance < half; distance++) {
+            table[half + distance] = W(distance, 2 * half, stat);
+        }
+    }
+    return table;
+}
 
-	arr[0] = temp[len - 1];
-	for (int i = 0; i < len - 1; i++) {
-		arr[i+1] = temp[i];
+void right_rotate(double* arr, int len){
+	// in place, no buffer per step
+	double last = arr[len - 1];
+	for (int i = len - 1; i > 0; i--) {
+		arr[i] = arr[i-1];
 	}
-
-	delete temp;
+	arr[0] = last;
 }
 
 double* convolution(double x1[], double x2[], int len){
@@ -118,14 +117,16 @@ double* convolution(double x1[], double x2[], int len){
 		out[step] = sum;
 	}
 	
-	delete a;
-	delete b;
+	delete[] a;
+	delete[] b;
 	
 	return out;
 }
 
 int main() {
     int n = 8;
+    int logn = 0;
+    while ((1 << logn) < n) logn++;
     double x1[] = {1, 2, 2, 0, 1, 2, 2, 0};
     double x2[] = {1, 2, 3, 4, 5, 6, 7, 8};
     
@@ -140,24 +141,27 @@ int main() {
     x2_complex = new Complex[n];
 
     for (int i = 0; i < n; i++) { // preprocessing
-        x1_complex[i].real(x1[reverse(i, log2(n))]);
+        x1_complex[i].real(x1[i]);
         x1_complex[i].imag(0);
 
-        x2_complex[i].real(x2[reverse(i, log2(n))]);
+        x2_complex[i].real(x2[i]);
         x2_complex[i].imag(0);
     }
+    bitrev_permute(x1_complex, logn);
+    bitrev_permute(x2_complex, logn);
 
     cout << "***** After Preprocessing *****" << endl;
     cout << "x1: "; print_complex(x1_complex, n);
     cout << "x2: "; print_complex(x2_complex, n); cout << endl;
 	
 	// FFT
-    for (int step = 1; step <= log2(n); step++) {								// 
-        for (int idx = 0; idx < (n/pow(2, step)); idx++) {					// 
-            for (int distance = 0; distance < pow(2, step - 1); distance++) {	//
-				int i = idx * pow(2, step) + distance;
-				int j = idx * pow(2, step) + distance + pow(2, step - 1);
-				Complex w = W(distance, pow(2, step), normal);
+	Complex* w_fft = twiddle_table(n, normal);
+    for (int step = 1; step <= logn; step++) {								// 
+        for (int idx = 0; idx < (n >> step); idx++) {					// 
+            for (int distance = 0; distance < (1 << (step - 1)); distance++) {	//
+				int i = (idx << step) + distance;
+				int j = (idx << step) + distance + (1 << (step - 1));
+				Complex w = w_fft[(1 << (step - 1)) + distance];
                 bufferfly_unit(x1_complex, i, j, w);
                 bufferfly_unit(x2_complex, i, j, w);
             }
@@ -182,16 +186,18 @@ int main() {
 	Complex* X_complex = new Complex[n];
 
 	for (int i = 0; i < n; i++) {
-		X_complex[i] = X_multi[reverse(i, log2(n))];
-	} 
+		X_complex[i] = X_multi[i];
+	}
+	bitrev_permute(X_complex, logn);
 
 	// IFFT
-    for (int step = 1; step <= log2(n); step++) {								// 
-        for (int idx = 0; idx < (n/pow(2, step)); idx++) {					// 
-            for (int distance = 0; distance < pow(2, step - 1); distance++) {	//
-				int i = idx * pow(2, step) + distance;
-				int j = idx * pow(2, step) + distance + pow(2, step - 1);
-				Complex w = W(distance, pow(2, step), inverse);
+	Complex* w_ifft = twiddle_table(n, inverse);
+    for (int step = 1; step <= logn; step++) {								// 
+        for (int idx = 0; idx < (n >> step); idx++) {					// 
+            for (int distance = 0; distance < (1 << (step - 1)); distance++) {	//
+				int i = (idx << step) + distance;
+				int j = (idx << step) + distance + (1 << (step - 1));
+				Complex w = w_ifft[(1 << (step - 1)) + distance];
                 bufferfly_unit(X_complex, i, j, w);
             }
         }
@@ -208,10 +214,12 @@ int main() {
 	double * org_conv = convolution(x1, x2, n);
     cout << "org_conv: "; print(org_conv, n); cout << endl;
 
-	delete x1_complex;
-	delete x2_complex;
-	delete X_multi;
-	delete X_complex;
+	delete[] x1_complex;
+	delete[] x2_complex;
+	delete[] X_multi;
+	delete[] X_complex;
+	delete[] w_fft;
+	delete[] w_ifft;
     
 	return 0;
 }
@@ -0,0 +1,341 @@
+/*
+ * FFT_plan.cpp
+ *
+ * Description
+ * Implementation of FftPlan, see FFT_plan.h
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * 2026/10/17	jorjor	Radix-4 and split-radix
+ * 2026/10/17	jorjor	Real-input transforms
+ * 2026/10/17	jorjor	Bit-reverse table from bitrev.h
+ * */
+
+#include "FFT_plan.h"
+#include "bitrev.h"
+
+#include <cmath>
+#include <stdexcept>
+
+using namespace std;
+
+Complex root_of_unity(int k, int n) {
+	const long double pi = 3.141592653589793238462643383279502884L;
+	k %= n;
+	if (n % 8 != 0) {
+		long double a = 2 * pi * k / n;
+		return Complex((double)cosl(a), (double)-sinl(a));
+	}
+
+	// folded into the first octant so that cos / sin see an argument in [0, pi / 4]
+	int oct = n / 8;
+	int r = k % (n / 4);
+	int quad = k / (n / 4);
+	long double c, s;
+	if (r <= oct) {
+		long double a = 2 * pi * r / n;
+		c = cosl(a);
+		s = sinl(a);
+	}
+	else {
+		long double a = 2 * pi * (n / 4 - r) / n;
+		c = sinl(a);
+		s = cosl(a);
+	}
+
+	// rotate by -pi/2 for each quadrant : (c, s) -> (s, -c)
+	double re = (double)c, im = -(double)s;
+	for (int i = 0; i < quad; i++) {
+		double t = re;
+		re = im;
+		im = -t;
+	}
+	return Complex(re, im);
+}
+
+FftPlan::FftPlan(int n, cpu_isa isa, fft_radix radix)
+	: n_(n), log2n_(0), radix_(radix), kernels_(fft_kernels(isa)) {
+	if (n < 1 || (n & (n - 1)) != 0) {
+		throw invalid_argument("FftPlan: n must be a power of 2");
+	}
+	while ((1 << log2n_) < n) log2n_++;
+
+	rev_.assign(n, 0);
+	bitrev_table(&rev_[0], log2n_);
+
+	tw_.assign(n, Complex(0, 0));
+	tw_inv_.assign(n, Complex(0, 0));
+	if (n < 2) {
+		return;
+	}
+
+	// the whole circle W(k, m), every stage is a subsample of it
+	int m = (n < 8) ? 8 : n;
+	vector<Complex> w(m);
+	for (int k = 0; k < m; k++) {
+		w[k] = root_of_unity(k, m);
+	}
+	for (int half = 1; half < n; half <<= 1) {
+		int step = m / (2 * half);
+		for (int j = 0; j < half; j++) {
+			tw_[half + j] = w[j * step];
+			tw_inv_[half + j] = conj(w[j * step]);
+		}
+	}
+
+	tw4_.assign(n > 4 ? 3 * (n / 4 - 1) + 3 * (n / 4) : 3, Complex(0, 0));
+	tw4_inv_.assign(tw4_.size(), Complex(0, 0));
+	for (int q = 1; 4 * q <= n; q <<= 1) {
+		int step = m / (4 * q);
+		Complex *t = &tw4_[3 * (q - 1)];
+		Complex *ti = &tw4_inv_[3 * (q - 1)];
+		for (int j = 0; j < q; j++) {
+			for (int r = 1; r <= 3; r++) {
+				t[(r - 1) * q + j] = w[r * j * step];
+				ti[(r - 1) * q + j] = conj(w[r * j * step]);
+			}
+		}
+	}
+}
+
+void FftPlan::radix4_forward(Complex *x, int n) const {
+	// pairs of DIF stages (half = 2q and q), then the radix-2 tail (half = 1)
+	int lg = 0;
+	while ((1 << lg) < n) lg++;
+	for (int q = n / 4; q >= 1; q >>= 2) {
+		kernels_.r4_gs_stage(x, n, q, twiddles4(q));
+	}
+	if (lg & 1) {
+		kernels_.gs_stage(x, n, 1, &tw_[1]);
+	}
+}
+
+void FftPlan::radix4_inverse(Complex *x, int n) const {
+	int lg = 0;
+	while ((1 << lg) < n) lg++;
+	int q = 1;
+	if (lg & 1) {
+		kernels_.ct_stage(x, n, 1, &tw_inv_[1]);
+		q = 2;
+	}
+	for (; 4 * q <= n; q <<= 2) {
+		kernels_.r4_ct_stage(x, n, q, twiddles4_inv(q));
+	}
+}
+
+void FftPlan::split_forward(Complex *x, int n) const {
+	// x0 + x2, x1 + x3 -> n/2-point sub-FFT, the two odd quarters -> n/4-point sub-FFTs
+	if (n <= FFT_SPLIT_LEAF) {
+		radix4_forward(x, n);
+		return;
+	}
+	int q = n / 4;
+	kernels_.sr_gs_stage(x, n, q, twiddles4(q));
+	split_forward(x, n / 2);
+	split_forward(x + 2 * q, q);
+	split_forward(x + 3 * q, q);
+}
+
+void FftPlan::split_inverse(Complex *x, int n) const {
+	if (n <= FFT_SPLIT_LEAF) {
+		radix4_inverse(x, n);
+		return;
+	}
+	int q = n / 4;
+	split_inverse(x, n / 2);
+	split_inverse(x + 2 * q, q);
+	split_inverse(x + 3 * q, q);
+	kernels_.sr_ct_stage(x, n, q, twiddles4_inv(q));
+}
+
+void FftPlan::forward_n(Complex *x, int n) const {
+	// every stage table depends on the stage size only, so the plan runs any n <= n_
+	switch (radix_) {
+	case FFT_RADIX4:
+		radix4_forward(x, n);
+		break;
+	case FFT_SPLIT_RADIX:
+		split_forward(x, n);
+		break;
+	default:
+		for (int half = n / 2; half >= 1; half >>= 1) {
+			kernels_.gs_stage(x, n, half, &tw_[half]);
+		}
+		break;
+	}
+}
+
+void FftPlan::inverse_n(Complex *x, int n) const {
+	// without the 1 / n scaling
+	switch (radix_) {
+	case FFT_RADIX4:
+		radix4_inverse(x, n);
+		break;
+	case FFT_SPLIT_RADIX:
+		split_inverse(x, n);
+		break;
+	default:
+		for (int half = 1; half <= n / 2; half <<= 1) {
+			kernels_.ct_stage(x, n, half, &tw_inv_[half]);
+		}
+		break;
+	}
+}
+
+void FftPlan::forward(Complex *x) const {
+	forward_n(x, n_);
+}
+
+void FftPlan::inverse(Complex *x) const {
+	inverse_n(x, n_);
+
+	// 1 / n is a power of 2, the scaling is exact
+	const double scale = 1.0 / n_;
+	double *p = (double *)x;
+	for (int i = 0; i < 2 * n_; i++) {
+		p[i] *= scale;
+	}
+}
+
+void FftPlan::pointwise(Complex *out, const Complex *a, const Complex *b) const {
+	for (int i = 0; i < n_; i++) {
+		out[i] = cmul(a[i], b[i]);
+	}
+}
+
+void FftPlan::multiply(Complex *out, const Complex *a, const Complex *b, Complex *tmp) const {
+	for (int i = 0; i < n_; i++) {
+		tmp[i] = b[i];
+	}
+	if (out != a) {
+		for (int i = 0; i < n_; i++) {
+			out[i] = a[i];
+		}
+	}
+
+	forward(out);
+	forward(tmp);
+	pointwise(out, out, tmp);
+	inverse(out);
+}
+
+// The real transforms need natural order, the plan gives DIF natural -> bit-reversed
+// and DIT bit-reversed -> natural, so the packed input is conjugated and scattered
+// into bit-reversed order and the unscaled inverse gives conj(FFT) in natural order :
+// sum conj(z[j]) e^(2 pi i jk / m) = conj(Z[k])
+
+void FftPlan::forward_real(Complex *out, const double *in) const {
+	if (n_ == 1) {
+		out[0] = Complex(in[0], 0);
+		return;
+	}
+	int m = n_ / 2;
+	for (int j = 0; j < m; j++) {
+		out[rev_[j] >> 1] = Complex(in[2*j], -in[2*j+1]);
+	}
+	inverse_n(out, m);
+
+	// E = (Z[k] + conj(Z[m-k])) / 2, O = (Z[k] - conj(Z[m-k])) / 2i
+	// X[k] = E + W(k, n) O, X[m-k] = conj(E - W(k, n) O)
+	double *p = (double *)out;
+	const double *w = (const double *)&tw_[m];
+	double z0r = p[0], z0i = -p[1];
+	for (int k = 1; 2 * k <= m; k++) {
+		double ar = p[2*k], ai = -p[2*k+1];
+		double br = p[2*(m-k)], bi = p[2*(m-k)+1];
+		double er = 0.5 * (ar + br), ei = 0.5 * (ai + bi);
+		double or_ = 0.5 * (ai - bi), oi = 0.5 * (br - ar);
+		double wr = w[2*k], wi = w[2*k+1];
+		double tr = wr * or_ - wi * oi, ti = wr * oi + wi * or_;
+		p[2*k] = er + tr;
+		p[2*k+1] = ei + ti;
+		p[2*(m-k)] = er - tr;
+		p[2*(m-k)+1] = ti - ei;
+	}
+	out[0] = Complex(z0r + z0i, 0);
+	out[m] = Complex(z0r - z0i, 0);
+}
+
+void FftPlan::inverse_real(double *out, Complex *in) const {
+	if (n_ == 1) {
+		out[0] = in[0].real();
+		return;
+	}
+	int m = n_ / 2;
+
+	// 2E = X[k] + conj(X[m-k]), 2O = (X[k] - conj(X[m-k])) conj(W(k, n)), Z[k] = E + i O
+	// conj(2Z[k]) and conj(2Z[m-k]) = 2E - 2iO are stored, the 1 / 2 goes into the 1 / n
+	double *p = (double *)in;
+	const double *w = (const double *)&tw_inv_[m];
+	double x0 = p[0], xm = p[2*m];
+	p[0] = x0 + xm;
+	p[1] = xm - x0;
+	for (int k = 1; 2 * k <= m; k++) {
+		double ar = p[2*k], ai = p[2*k+1];
+		double br = p[2*(m-k)], bi = -p[2*(m-k)+1];
+		double er = ar + br, ei = ai + bi;
+		double dr = ar - br, di = ai - bi;
+		double wr = w[2*k], wi = w[2*k+1];
+		double or_ = wr * dr - wi * di, oi = wr * di + wi * dr;
+		p[2*k] = er - oi;
+		p[2*k+1] = -(ei + or_);
+		p[2*(m-k)] = er + oi;
+		p[2*(m-k)+1] = ei - or_;
+	}
+
+	// conj(n z[j]) in bit-reversed order
+	forward_n(in, m);
+	const double scale = 1.0 / n_;
+	for (int j = 0; j < m; j++) {
+		const double *q = &p[2 * (rev_[j] >> 1)];
+		out[2*j] = q[0] * scale;
+		out[2*j+1] = -q[1] * scale;
+	}
+}
+
+void FftPlan::multiply_real(double *out, const double *a, const double *b, Complex *tmp) const {
+	if (n_ == 1) {
+		out[0] = a[0] * b[0];
+		return;
+	}
+	for (int j = 0; j < n_; j++) {
+		tmp[rev_[j]] = Complex(a[j], -b[j]);
+	}
+	inverse_n(tmp, n_);
+
+	// Z = conj(tmp), 2A = Z[k] + conj(Z[n-k]), 2B = (Z[k] - conj(Z[n-k])) / i
+	// C[k] = A B for k <= n/2 into tmp[k], tmp[n-k] is read before it could be written
+	double *p = (double *)tmp;
+	for (int k = 0; 2 * k <= n_; k++) {
+		int r = (k == 0) ? 0 : n_ - k;
+		double zr = p[2*k], zi = -p[2*k+1];
+		double ur = p[2*r], ui = p[2*r+1];
+		double ar = zr + ur, ai = zi + ui;
+		double br = zi - ui, bi = ur - zr;
+		p[2*k] = 0.25 * (ar * br - ai * bi);
+		p[2*k+1] = 0.25 * (ar * bi + ai * br);
+	}
+	inverse_real(out, tmp);
+}
+
+double FftPlan::flops(int n, fft_radix radix) const {
+	// radix-2 butterfly 1 cmul + 2 cadd, radix-4 3 cmul + 8 cadd,
+	// split-radix step 2 cmul + 6 cadd per j
+	int lg = 0;
+	while ((1 << lg) < n) lg++;
+	switch (radix) {
+	case FFT_RADIX4:
+		return (lg / 2) * (n / 4) * 34.0 + (lg & 1) * (n / 2) * 10.0;
+	case FFT_SPLIT_RADIX:
+		if (n <= FFT_SPLIT_LEAF) {
+			return flops(n, FFT_RADIX4);
+		}
+		return (n / 4) * 24.0 + flops(n / 2, radix) + 2 * flops(n / 4, radix);
+	default:
+		return lg * (n / 2) * 10.0;
+	}
+}
+
+double FftPlan::flops() const {
+	return flops(n_, radix_);
+}
@@ -0,0 +1,132 @@
+/*
+ * FFT_plan.h
+ *
+ * Description
+ * Reusable FFT plan for the DIF-forward / DIT-inverse arrangement of FFT_GSCT.cpp
+ * A plan owns the twiddles of one power-of-2 size, built once instead of calling
+ * W() (cos, sin, acos) for every butterfly, and then only read,
+ * so one plan can be shared by many threads
+ *
+ * forward : DIF (Gentleman-Sande), natural order in, bit-reversed order out
+ * inverse : DIT (Cooley-Tukey), bit-reversed order in, natural order out, scaled by 1 / n
+ * no bit reverse permutation is done, same as FFT_GSCT.cpp
+ *
+ * The twiddles of the stage with distance half are contiguous, twiddles(half)[j] = W(j, 2 * half)
+ * They are computed in long double from the first octant and rounded once,
+ * every entry is within 1 ulp of exp(-+ 2 pi i j / (2 * half))
+ *
+ * The butterfly stages are the kernels of FFT_kernels.h, picked once when the plan is built
+ *
+ *   FFT_RADIX2        log2(n) radix-2 stages, as FFT_GSCT.cpp
+ *   FFT_RADIX4        radix-4 stages, a last radix-2 stage when log2(n) is odd
+ *   FFT_SPLIT_RADIX   split-radix, depth first, radix-4 below FFT_SPLIT_LEAF values
+ * All radices give the same bit-reversed order, so pointwise() does not depend on it
+ *
+ * Real input, n real values, the spectrum is Hermitian, X[n - k] = conj(X[k])
+ *   forward_real   X[0 ... n/2] in natural order, one n/2-point transform of
+ *                  z[j] = x[2j] + i x[2j+1] and a split into the even / odd halves
+ *   inverse_real   the reverse, scaled by 1 / n
+ *   multiply_real  cyclic convolution of two real inputs, a + i b in one n-point forward,
+ *                  the two spectra separated, then inverse_real : 1.5 transforms instead of 3
+ * They read the sub-transforms of the same plan, no second plan is needed
+ * Invalid sizes throw std::invalid_argument
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * 2026/10/17	jorjor	Radix-4 and split-radix
+ * 2026/10/17	jorjor	Real-input transforms
+ * 2026/10/17	jorjor	root_of_unity() shared with FFT_fourstep.cpp
+ * 2026/10/17	jorjor	root_of_unity() for any n, shared with FFT_bluestein.cpp
+ * */
+
+#ifndef FFT_PLAN_H
+#define FFT_PLAN_H
+
+#include <vector>
+
+#include "FFT_kernels.h"
+
+enum fft_radix {
+	FFT_RADIX2 = 0,
+	FFT_RADIX4,
+	FFT_SPLIT_RADIX
+};
+
+// split-radix sub-FFTs of this size or less run radix-4 stages
+#define FFT_SPLIT_LEAF 64
+
+// e^(-2 pi i k / n) for k >= 0 and n >= 1, within 1 ulp when n is a multiple of 8,
+// other n take the angle of k mod n in long double
+Complex root_of_unity(int k, int n);
+
+class FftPlan {
+public:
+	// n : power of 2, isa : ISA_AUTO or the highest ISA the plan may use
+	explicit FftPlan(int n, cpu_isa isa = ISA_AUTO, fft_radix radix = FFT_SPLIT_RADIX);
+
+	int size() const { return n_; }
+	int log2n() const { return log2n_; }
+	cpu_isa isa() const { return kernels_.isa; }
+	fft_radix radix() const { return radix_; }
+
+	// real floating-point operations of one forward() or inverse() as executed,
+	// 6 per complex multiply, 2 per complex add, without the 1 / n scaling
+	double flops() const;
+
+	// in-place transforms on n values
+	void forward(Complex *x) const;
+	void inverse(Complex *x) const;
+
+	// out = a . b in the frequency domain, out may alias a or b
+	void pointwise(Complex *out, const Complex *a, const Complex *b) const;
+
+	// out = cyclic convolution of a and b, tmp must hold n values
+	// out may alias a, tmp must not alias anything
+	void multiply(Complex *out, const Complex *a, const Complex *b, Complex *tmp) const;
+
+	// in : n real values, out : n / 2 + 1 values X[0 ... n/2], out must not alias in
+	void forward_real(Complex *out, const double *in) const;
+
+	// in : n / 2 + 1 values, overwritten, out : n real values
+	void inverse_real(double *out, Complex *in) const;
+
+	// out = cyclic convolution of the real a and b, tmp must hold n values
+	// out may alias a or b, tmp must not alias anything
+	void multiply_real(double *out, const double *a, const double *b, Complex *tmp) const;
+
+	// W(j, 2 * half) for j < half, forward (e^-) and inverse (e^+)
+	const Complex *twiddles(int half) const { return &tw_[half]; }
+	const Complex *twiddles_inv(int half) const { return &tw_inv_[half]; }
+
+	// W(j, 4q) | W(2j, 4q) | W(3j, 4q) for j < q, the radix-4 and split-radix stages
+	const Complex *twiddles4(int q) const { return &tw4_[3 * (q - 1)]; }
+	const Complex *twiddles4_inv(int q) const { return &tw4_inv_[3 * (q - 1)]; }
+
+private:
+	// unscaled transforms of size n <= n_
+	void forward_n(Complex *x, int n) const;
+	void inverse_n(Complex *x, int n) const;
+	void radix4_forward(Complex *x, int n) const;
+	void radix4_inverse(Complex *x, int n) const;
+	void split_forward(Complex *x, int n) const;
+	void split_inverse(Complex *x, int n) const;
+	double flops(int n, fft_radix radix) const;
+
+	int n_;
+	int log2n_;
+	fft_radix radix_;
+	FftKernels kernels_;
+
+	// stage with distance half at [half, 2 * half)
+	std::vector<Complex> tw_;
+	std::vector<Complex> tw_inv_;
+
+	// stage q at [3 (q - 1), 3 (2q - 1))
+	std::vector<Complex> tw4_;
+	std::vector<Complex> tw4_inv_;
+
+	// log2(n)-bit reversal, rev_[j] >> 1 is the reversal for n / 2
+	std::vector<int> rev_;
+};
+
+#endif
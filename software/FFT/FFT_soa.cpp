@@ -0,0 +1,647 @@
+/*
+ * FFT_soa.cpp
+ *
+ * Description
+ * Implementation of FftSoaPlan, see FFT_soa.h
+ * The SIMD kernels are compiled with the target attributes of cpu_target.h, as FFT_kernels.cpp
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * 2026/10/17	jorjor	Intrinsics and target attributes from cpu_target.h
+ * */
+
+#include "FFT_soa.h"
+#include "FFT_plan.h"
+#include "cpu_target.h"
+
+#include <stdexcept>
+
+using namespace std;
+
+// (re, im, n, half or q, twiddles of the stage)
+typedef void (*soa_stage_fn)(double *re, double *im, int n, int half, const double *w);
+
+// the last log2(width) stages, (re, im, n, twiddle table of the plan)
+typedef void (*soa_tail_fn)(double *re, double *im, int n, const double *tw);
+
+struct SoaKernels {
+	int width;
+	soa_stage_fn r2_gs_stage;
+	soa_stage_fn r2_ct_stage;
+	soa_stage_fn r4_gs_stage;
+	soa_stage_fn r4_ct_stage;
+	soa_tail_fn tail_gs;
+	soa_tail_fn tail_ct;
+};
+
+/* scalar */
+
+static inline void bfly_gs(double &ar, double &ai, double &br, double &bi, double wr, double wi) {
+	// DIF-FFT
+	// Gentleman-Sande butterfly unit
+	double tr = ar - br;
+	double ti = ai - bi;
+	ar += br;
+	ai += bi;
+	br = tr * wr - ti * wi;
+	bi = tr * wi + ti * wr;
+}
+
+static inline void bfly_ct(double &ar, double &ai, double &br, double &bi, double wr, double wi) {
+	// DIT-FFT
+	// Cooley-Tukey butterfly unit
+	double tr = br * wr - bi * wi;
+	double ti = br * wi + bi * wr;
+	br = ar - tr;
+	bi = ai - ti;
+	ar += tr;
+	ai += ti;
+}
+
+static void r2_gs_stage_scalar(double *re, double *im, int n, int half, const double *w) {
+	for (int s = 0; s < n; s += 2 * half) {
+		for (int j = s; j < s + half; j++) {
+			bfly_gs(re[j], im[j], re[j + half], im[j + half], w[j - s], w[half + j - s]);
+		}
+	}
+}
+
+static void r2_ct_stage_scalar(double *re, double *im, int n, int half, const double *w) {
+	for (int s = 0; s < n; s += 2 * half) {
+		for (int j = s; j < s + half; j++) {
+			bfly_ct(re[j], im[j], re[j + half], im[j + half], w[j - s], w[half + j - s]);
+		}
+	}
+}
+
+static void r4_gs_stage_scalar(double *re, double *im, int n, int q, const double *w) {
+	for (int s = 0; s < n; s += 4 * q) {
+		for (int j = 0; j < q; j++) {
+			int k0 = s + j, k1 = k0 + q, k2 = k1 + q, k3 = k2 + q;
+			double a0r = re[k0] + re[k2], a0i = im[k0] + im[k2];
+			double br = re[k0] - re[k2], bi = im[k0] - im[k2];
+			double a1r = re[k1] + re[k3], a1i = im[k1] + im[k3];
+			double cr = re[k1] - re[k3], ci = im[k1] - im[k3];
+			double w1r = w[j], w1i = w[q + j];
+			double w2r = w[2 * q + j], w2i = w[3 * q + j];
+			double w3r = w[4 * q + j], w3i = w[5 * q + j];
+			double tr = a0r - a1r, ti = a0i - a1i;
+			re[k0] = a0r + a1r;
+			im[k0] = a0i + a1i;
+			re[k1] = tr * w2r - ti * w2i;
+			im[k1] = tr * w2i + ti * w2r;
+			tr = br + ci;	// b - ic
+			ti = bi - cr;
+			re[k2] = tr * w1r - ti * w1i;
+			im[k2] = tr * w1i + ti * w1r;
+			tr = br - ci;	// b + ic
+			ti = bi + cr;
+			re[k3] = tr * w3r - ti * w3i;
+			im[k3] = tr * w3i + ti * w3r;
+		}
+	}
+}
+
+static void r4_ct_stage_scalar(double *re, double *im, int n, int q, const double *w) {
+	for (int s = 0; s < n; s += 4 * q) {
+		for (int j = 0; j < q; j++) {
+			int k0 = s + j, k1 = k0 + q, k2 = k1 + q, k3 = k2 + q;
+			double w1r = w[j], w1i = w[q + j];
+			double w2r = w[2 * q + j], w2i = w[3 * q + j];
+			double w3r = w[4 * q + j], w3i = w[5 * q + j];
+			double t1r = re[k1] * w2r - im[k1] * w2i, t1i = re[k1] * w2i + im[k1] * w2r;
+			double t2r = re[k2] * w1r - im[k2] * w1i, t2i = re[k2] * w1i + im[k2] * w1r;
+			double t3r = re[k3] * w3r - im[k3] * w3i, t3i = re[k3] * w3i + im[k3] * w3r;
+			double a0r = re[k0] + t1r, a0i = im[k0] + t1i;
+			double a1r = re[k0] - t1r, a1i = im[k0] - t1i;
+			double sr = t2r + t3r, si = t2i + t3i;
+			double dr = t2r - t3r, di = t2i - t3i;
+			re[k0] = a0r + sr;
+			im[k0] = a0i + si;
+			re[k2] = a0r - sr;
+			im[k2] = a0i - si;
+			re[k1] = a1r - di;	// a1 + id
+			im[k1] = a1i + dr;
+			re[k3] = a1r + di;	// a1 - id
+			im[k3] = a1i - dr;
+		}
+	}
+}
+
+/* AVX2 + FMA, 4 values per register */
+
+static inline AVX2 void bfly_gs(__m256d &ar, __m256d &ai, __m256d &br, __m256d &bi, __m256d wr, __m256d wi) {
+	// DIF-FFT
+	// Gentleman-Sande butterfly unit
+	__m256d tr = _mm256_sub_pd(ar, br);
+	__m256d ti = _mm256_sub_pd(ai, bi);
+	ar = _mm256_add_pd(ar, br);
+	ai = _mm256_add_pd(ai, bi);
+	br = _mm256_fmsub_pd(tr, wr, _mm256_mul_pd(ti, wi));
+	bi = _mm256_fmadd_pd(tr, wi, _mm256_mul_pd(ti, wr));
+}
+
+static inline AVX2 void bfly_ct(__m256d &ar, __m256d &ai, __m256d &br, __m256d &bi, __m256d wr, __m256d wi) {
+	// DIT-FFT
+	// Cooley-Tukey butterfly unit
+	__m256d tr = _mm256_fmsub_pd(br, wr, _mm256_mul_pd(bi, wi));
+	__m256d ti = _mm256_fmadd_pd(br, wi, _mm256_mul_pd(bi, wr));
+	br = _mm256_sub_pd(ar, tr);
+	bi = _mm256_sub_pd(ai, ti);
+	ar = _mm256_add_pd(ar, tr);
+	ai = _mm256_add_pd(ai, ti);
+}
+
+static inline AVX2 void cmul_store(double *pr, double *pi, __m256d xr, __m256d xi, const double *wr, const double *wi) {
+	__m256d a = _mm256_loadu_pd(wr), b = _mm256_loadu_pd(wi);
+	_mm256_storeu_pd(pr, _mm256_fmsub_pd(xr, a, _mm256_mul_pd(xi, b)));
+	_mm256_storeu_pd(pi, _mm256_fmadd_pd(xr, b, _mm256_mul_pd(xi, a)));
+}
+
+static AVX2 void r2_gs_stage_avx2(double *re, double *im, int n, int half, const double *w) {
+	for (int s = 0; s < n; s += 2 * half) {
+		double *ar = re + s, *ai = im + s;
+		double *br = ar + half, *bi = ai + half;
+		for (int j = 0; j < half; j += 4) {
+			__m256d xr = _mm256_loadu_pd(ar + j), xi = _mm256_loadu_pd(ai + j);
+			__m256d yr = _mm256_loadu_pd(br + j), yi = _mm256_loadu_pd(bi + j);
+			bfly_gs(xr, xi, yr, yi, _mm256_loadu_pd(w + j), _mm256_loadu_pd(w + half + j));
+			_mm256_storeu_pd(ar + j, xr);
+			_mm256_storeu_pd(ai + j, xi);
+			_mm256_storeu_pd(br + j, yr);
+			_mm256_storeu_pd(bi + j, yi);
+		}
+	}
+}
+
+static AVX2 void r2_ct_stage_avx2(double *re, double *im, int n, int half, const double *w) {
+	for (int s = 0; s < n; s += 2 * half) {
+		double *ar = re + s, *ai = im + s;
+		double *br = ar + half, *bi = ai + half;
+		for (int j = 0; j < half; j += 4) {
+			__m256d xr = _mm256_loadu_pd(ar + j), xi = _mm256_loadu_pd(ai + j);
+			__m256d yr = _mm256_loadu_pd(br + j), yi = _mm256_loadu_pd(bi + j);
+			bfly_ct(xr, xi, yr, yi, _mm256_loadu_pd(w + j), _mm256_loadu_pd(w + half + j));
+			_mm256_storeu_pd(ar + j, xr);
+			_mm256_storeu_pd(ai + j, xi);
+			_mm256_storeu_pd(br + j, yr);
+			_mm256_storeu_pd(bi + j, yi);
+		}
+	}
+}
+
+static AVX2 void r4_gs_stage_avx2(double *re, double *im, int n, int q, const double *w) {
+	for (int s = 0; s < n; s += 4 * q) {
+		double *r0 = re + s, *i0 = im + s;
+		double *r1 = r0 + q, *i1 = i0 + q;
+		double *r2 = r1 + q, *i2 = i1 + q;
+		double *r3 = r2 + q, *i3 = i2 + q;
+		for (int j = 0; j < q; j += 4) {
+			__m256d x0r = _mm256_loadu_pd(r0 + j), x0i = _mm256_loadu_pd(i0 + j);
+			__m256d x1r = _mm256_loadu_pd(r1 + j), x1i = _mm256_loadu_pd(i1 + j);
+			__m256d x2r = _mm256_loadu_pd(r2 + j), x2i = _mm256_loadu_pd(i2 + j);
+			__m256d x3r = _mm256_loadu_pd(r3 + j), x3i = _mm256_loadu_pd(i3 + j);
+			__m256d a0r = _mm256_add_pd(x0r, x2r), a0i = _mm256_add_pd(x0i, x2i);
+			__m256d br = _mm256_sub_pd(x0r, x2r), bi = _mm256_sub_pd(x0i, x2i);
+			__m256d a1r = _mm256_add_pd(x1r, x3r), a1i = _mm256_add_pd(x1i, x3i);
+			__m256d cr = _mm256_sub_pd(x1r, x3r), ci = _mm256_sub_pd(x1i, x3i);
+			_mm256_storeu_pd(r0 + j, _mm256_add_pd(a0r, a1r));
+			_mm256_storeu_pd(i0 + j, _mm256_add_pd(a0i, a1i));
+			cmul_store(r1 + j, i1 + j, _mm256_sub_pd(a0r, a1r), _mm256_sub_pd(a0i, a1i), w + 2 * q + j, w + 3 * q + j);
+			cmul_store(r2 + j, i2 + j, _mm256_add_pd(br, ci), _mm256_sub_pd(bi, cr), w + j, w + q + j);	// b - ic
+			cmul_store(r3 + j, i3 + j, _mm256_sub_pd(br, ci), _mm256_add_pd(bi, cr), w + 4 * q + j, w + 5 * q + j);	// b + ic
+		}
+	}
+}
+
+static AVX2 void r4_ct_stage_avx2(double *re, double *im, int n, int q, const double *w) {
+	for (int s = 0; s < n; s += 4 * q) {
+		double *r0 = re + s, *i0 = im + s;
+		double *r1 = r0 + q, *i1 = i0 + q;
+		double *r2 = r1 + q, *i2 = i1 + q;
+		double *r3 = r2 + q, *i3 = i2 + q;
+		for (int j = 0; j < q; j += 4) {
+			__m256d x0r = _mm256_loadu_pd(r0 + j), x0i = _mm256_loadu_pd(i0 + j);
+			__m256d x1r = _mm256_loadu_pd(r1 + j), x1i = _mm256_loadu_pd(i1 + j);
+			__m256d x2r = _mm256_loadu_pd(r2 + j), x2i = _mm256_loadu_pd(i2 + j);
+			__m256d x3r = _mm256_loadu_pd(r3 + j), x3i = _mm256_loadu_pd(i3 + j);
+			__m256d w1r = _mm256_loadu_pd(w + j), w1i = _mm256_loadu_pd(w + q + j);
+			__m256d w2r = _mm256_loadu_pd(w + 2 * q + j), w2i = _mm256_loadu_pd(w + 3 * q + j);
+			__m256d w3r = _mm256_loadu_pd(w + 4 * q + j), w3i = _mm256_loadu_pd(w + 5 * q + j);
+			__m256d t1r = _mm256_fmsub_pd(x1r, w2r, _mm256_mul_pd(x1i, w2i)), t1i = _mm256_fmadd_pd(x1r, w2i, _mm256_mul_pd(x1i, w2r));
+			__m256d t2r = _mm256_fmsub_pd(x2r, w1r, _mm256_mul_pd(x2i, w1i)), t2i = _mm256_fmadd_pd(x2r, w1i, _mm256_mul_pd(x2i, w1r));
+			__m256d t3r = _mm256_fmsub_pd(x3r, w3r, _mm256_mul_pd(x3i, w3i)), t3i = _mm256_fmadd_pd(x3r, w3i, _mm256_mul_pd(x3i, w3r));
+			__m256d a0r = _mm256_add_pd(x0r, t1r), a0i = _mm256_add_pd(x0i, t1i);
+			__m256d a1r = _mm256_sub_pd(x0r, t1r), a1i = _mm256_sub_pd(x0i, t1i);
+			__m256d sr = _mm256_add_pd(t2r, t3r), si = _mm256_add_pd(t2i, t3i);
+			__m256d dr = _mm256_sub_pd(t2r, t3r), di = _mm256_sub_pd(t2i, t3i);
+			_mm256_storeu_pd(r0 + j, _mm256_add_pd(a0r, sr));
+			_mm256_storeu_pd(i0 + j, _mm256_add_pd(a0i, si));
+			_mm256_storeu_pd(r2 + j, _mm256_sub_pd(a0r, sr));
+			_mm256_storeu_pd(i2 + j, _mm256_sub_pd(a0i, si));
+			_mm256_storeu_pd(r1 + j, _mm256_sub_pd(a1r, di));	// a1 + id
+			_mm256_storeu_pd(i1 + j, _mm256_add_pd(a1i, dr));
+			_mm256_storeu_pd(r3 + j, _mm256_add_pd(a1r, di));	// a1 - id
+			_mm256_storeu_pd(i3 + j, _mm256_sub_pd(a1i, dr));
+		}
+	}
+}
+
+static inline AVX2 void transpose4(__m256d *r) {
+	__m256d t0 = _mm256_unpacklo_pd(r[0], r[1]), t1 = _mm256_unpackhi_pd(r[0], r[1]);
+	__m256d t2 = _mm256_unpacklo_pd(r[2], r[3]), t3 = _mm256_unpackhi_pd(r[2], r[3]);
+	r[0] = _mm256_permute2f128_pd(t0, t2, 0x20);
+	r[1] = _mm256_permute2f128_pd(t1, t3, 0x20);
+	r[2] = _mm256_permute2f128_pd(t0, t2, 0x31);
+	r[3] = _mm256_permute2f128_pd(t1, t3, 0x31);
+}
+
+static AVX2 void tail_gs_avx2(double *re, double *im, int n, const double *tw) {
+	// stages half = 2, 1 on 4 blocks of 4 values, lane g holds block g after the transpose
+	__m256d w2r[2], w2i[2];
+	for (int k = 0; k < 2; k++) {
+		w2r[k] = _mm256_set1_pd(tw[4 + k]);
+		w2i[k] = _mm256_set1_pd(tw[6 + k]);
+	}
+	__m256d w1r = _mm256_set1_pd(tw[2]), w1i = _mm256_set1_pd(tw[3]);
+	for (int s = 0; s < n; s += 16) {
+		__m256d r[4], i[4];
+		for (int g = 0; g < 4; g++) {
+			r[g] = _mm256_loadu_pd(re + s + 4 * g);
+			i[g] = _mm256_loadu_pd(im + s + 4 * g);
+		}
+		transpose4(r);
+		transpose4(i);
+		for (int k = 0; k < 2; k++) {
+			bfly_gs(r[k], i[k], r[k + 2], i[k + 2], w2r[k], w2i[k]);
+		}
+		for (int k = 0; k < 4; k += 2) {
+			bfly_gs(r[k], i[k], r[k + 1], i[k + 1], w1r, w1i);
+		}
+		transpose4(r);
+		transpose4(i);
+		for (int g = 0; g < 4; g++) {
+			_mm256_storeu_pd(re + s + 4 * g, r[g]);
+			_mm256_storeu_pd(im + s + 4 * g, i[g]);
+		}
+	}
+}
+
+static AVX2 void tail_ct_avx2(double *re, double *im, int n, const double *tw) {
+	// stages half = 1, 2
+	__m256d w2r[2], w2i[2];
+	for (int k = 0; k < 2; k++) {
+		w2r[k] = _mm256_set1_pd(tw[4 + k]);
+		w2i[k] = _mm256_set1_pd(tw[6 + k]);
+	}
+	__m256d w1r = _mm256_set1_pd(tw[2]), w1i = _mm256_set1_pd(tw[3]);
+	for (int s = 0; s < n; s += 16) {
+		__m256d r[4], i[4];
+		for (int g = 0; g < 4; g++) {
+			r[g] = _mm256_loadu_pd(re + s + 4 * g);
+			i[g] = _mm256_loadu_pd(im + s + 4 * g);
+		}
+		transpose4(r);
+		transpose4(i);
+		for (int k = 0; k < 4; k += 2) {
+			bfly_ct(r[k], i[k], r[k + 1], i[k + 1], w1r, w1i);
+		}
+		for (int k = 0; k < 2; k++) {
+			bfly_ct(r[k], i[k], r[k + 2], i[k + 2], w2r[k], w2i[k]);
+		}
+		transpose4(r);
+		transpose4(i);
+		for (int g = 0; g < 4; g++) {
+			_mm256_storeu_pd(re + s + 4 * g, r[g]);
+			_mm256_storeu_pd(im + s + 4 * g, i[g]);
+		}
+	}
+}
+
+/* AVX-512 F, 8 values per register */
+
+static inline AVX512 void bfly_gs(__m512d &ar, __m512d &ai, __m512d &br, __m512d &bi, __m512d wr, __m512d wi) {
+	// DIF-FFT
+	// Gentleman-Sande butterfly unit
+	__m512d tr = _mm512_sub_pd(ar, br);
+	__m512d ti = _mm512_sub_pd(ai, bi);
+	ar = _mm512_add_pd(ar, br);
+	ai = _mm512_add_pd(ai, bi);
+	br = _mm512_fmsub_pd(tr, wr, _mm512_mul_pd(ti, wi));
+	bi = _mm512_fmadd_pd(tr, wi, _mm512_mul_pd(ti, wr));
+}
+
+static inline AVX512 void bfly_ct(__m512d &ar, __m512d &ai, __m512d &br, __m512d &bi, __m512d wr, __m512d wi) {
+	// DIT-FFT
+	// Cooley-Tukey butterfly unit
+	__m512d tr = _mm512_fmsub_pd(br, wr, _mm512_mul_pd(bi, wi));
+	__m512d ti = _mm512_fmadd_pd(br, wi, _mm512_mul_pd(bi, wr));
+	br = _mm512_sub_pd(ar, tr);
+	bi = _mm512_sub_pd(ai, ti);
+	ar = _mm512_add_pd(ar, tr);
+	ai = _mm512_add_pd(ai, ti);
+}
+
+static inline AVX512 void cmul_store(double *pr, double *pi, __m512d xr, __m512d xi, const double *wr, const double *wi) {
+	__m512d a = _mm512_loadu_pd(wr), b = _mm512_loadu_pd(wi);
+	_mm512_storeu_pd(pr, _mm512_fmsub_pd(xr, a, _mm512_mul_pd(xi, b)));
+	_mm512_storeu_pd(pi, _mm512_fmadd_pd(xr, b, _mm512_mul_pd(xi, a)));
+}
+
+static AVX512 void r2_gs_stage_avx512(double *re, double *im, int n, int half, const double *w) {
+	for (int s = 0; s < n; s += 2 * half) {
+		double *ar = re + s, *ai = im + s;
+		double *br = ar + half, *bi = ai + half;
+		for (int j = 0; j < half; j += 8) {
+			__m512d xr = _mm512_loadu_pd(ar + j), xi = _mm512_loadu_pd(ai + j);
+			__m512d yr = _mm512_loadu_pd(br + j), yi = _mm512_loadu_pd(bi + j);
+			bfly_gs(xr, xi, yr, yi, _mm512_loadu_pd(w + j), _mm512_loadu_pd(w + half + j));
+			_mm512_storeu_pd(ar + j, xr);
+			_mm512_storeu_pd(ai + j, xi);
+			_mm512_storeu_pd(br + j, yr);
+			_mm512_storeu_pd(bi + j, yi);
+		}
+	}
+}
+
+static AVX512 void r2_ct_stage_avx512(double *re, double *im, int n, int half, const double *w) {
+	for (int s = 0; s < n; s += 2 * half) {
+		double *ar = re + s, *ai = im + s;
+		double *br = ar + half, *bi = ai + half;
+		for (int j = 0; j < half; j += 8) {
+			__m512d xr = _mm512_loadu_pd(ar + j), xi = _mm512_loadu_pd(ai + j);
+			__m512d yr = _mm512_loadu_pd(br + j), yi = _mm512_loadu_pd(bi + j);
+			bfly_ct(xr, xi, yr, yi, _mm512_loadu_pd(w + j), _mm512_loadu_pd(w + half + j));
+			_mm512_storeu_pd(ar + j, xr);
+			_mm512_storeu_pd(ai + j, xi);
+			_mm512_storeu_pd(br + j, yr);
+			_mm512_storeu_pd(bi + j, yi);
+		}
+	}
+}
+
+static AVX512 void r4_gs_stage_avx512(double *re, double *im, int n, int q, const double *w) {
+	for (int s = 0; s < n; s += 4 * q) {
+		double *r0 = re + s, *i0 = im + s;
+		double *r1 = r0 + q, *i1 = i0 + q;
+		double *r2 = r1 + q, *i2 = i1 + q;
+		double *r3 = r2 + q, *i3 = i2 + q;
+		for (int j = 0; j < q; j += 8) {
+			__m512d x0r = _mm512_loadu_pd(r0 + j), x0i = _mm512_loadu_pd(i0 + j);
+			__m512d x1r = _mm512_loadu_pd(r1 + j), x1i = _mm512_loadu_pd(i1 + j);
+			__m512d x2r = _mm512_loadu_pd(r2 + j), x2i = _mm512_loadu_pd(i2 + j);
+			__m512d x3r = _mm512_loadu_pd(r3 + j), x3i = _mm512_loadu_pd(i3 + j);
+			__m512d a0r = _mm512_add_pd(x0r, x2r), a0i = _mm512_add_pd(x0i, x2i);
+			__m512d br = _mm512_sub_pd(x0r, x2r), bi = _mm512_sub_pd(x0i, x2i);
+			__m512d a1r = _mm512_add_pd(x1r, x3r), a1i = _mm512_add_pd(x1i, x3i);
+			__m512d cr = _mm512_sub_pd(x1r, x3r), ci = _mm512_sub_pd(x1i, x3i);
+			_mm512_storeu_pd(r0 + j, _mm512_add_pd(a0r, a1r));
+			_mm512_storeu_pd(i0 + j, _mm512_add_pd(a0i, a1i));
+			cmul_store(r1 + j, i1 + j, _mm512_sub_pd(a0r, a1r), _mm512_sub_pd(a0i, a1i), w + 2 * q + j, w + 3 * q + j);
+			cmul_store(r2 + j, i2 + j, _mm512_add_pd(br, ci), _mm512_sub_pd(bi, cr), w + j, w + q + j);	// b - ic
+			cmul_store(r3 + j, i3 + j, _mm512_sub_pd(br, ci), _mm512_add_pd(bi, cr), w + 4 * q + j, w + 5 * q + j);	// b + ic
+		}
+	}
+}
+
+static AVX512 void r4_ct_stage_avx512(double *re, double *im, int n, int q, const double *w) {
+	for (int s = 0; s < n; s += 4 * q) {
+		double *r0 = re + s, *i0 = im + s;
+		double *r1 = r0 + q, *i1 = i0 + q;
+		double *r2 = r1 + q, *i2 = i1 + q;
+		double *r3 = r2 + q, *i3 = i2 + q;
+		for (int j = 0; j < q; j += 8) {
+			__m512d x0r = _mm512_loadu_pd(r0 + j), x0i = _mm512_loadu_pd(i0 + j);
+			__m512d x1r = _mm512_loadu_pd(r1 + j), x1i = _mm512_loadu_pd(i1 + j);
+			__m512d x2r = _mm512_loadu_pd(r2 + j), x2i = _mm512_loadu_pd(i2 + j);
+			__m512d x3r = _mm512_loadu_pd(r3 + j), x3i = _mm512_loadu_pd(i3 + j);
+			__m512d w1r = _mm512_loadu_pd(w + j), w1i = _mm512_loadu_pd(w + q + j);
+			__m512d w2r = _mm512_loadu_pd(w + 2 * q + j), w2i = _mm512_loadu_pd(w + 3 * q + j);
+			__m512d w3r = _mm512_loadu_pd(w + 4 * q + j), w3i = _mm512_loadu_pd(w + 5 * q + j);
+			__m512d t1r = _mm512_fmsub_pd(x1r, w2r, _mm512_mul_pd(x1i, w2i)), t1i = _mm512_fmadd_pd(x1r, w2i, _mm512_mul_pd(x1i, w2r));
+			__m512d t2r = _mm512_fmsub_pd(x2r, w1r, _mm512_mul_pd(x2i, w1i)), t2i = _mm512_fmadd_pd(x2r, w1i, _mm512_mul_pd(x2i, w1r));
+			__m512d t3r = _mm512_fmsub_pd(x3r, w3r, _mm512_mul_pd(x3i, w3i)), t3i = _mm512_fmadd_pd(x3r, w3i, _mm512_mul_pd(x3i, w3r));
+			__m512d a0r = _mm512_add_pd(x0r, t1r), a0i = _mm512_add_pd(x0i, t1i);
+			__m512d a1r = _mm512_sub_pd(x0r, t1r), a1i = _mm512_sub_pd(x0i, t1i);
+			__m512d sr = _mm512_add_pd(t2r, t3r), si = _mm512_add_pd(t2i, t3i);
+			__m512d dr = _mm512_sub_pd(t2r, t3r), di = _mm512_sub_pd(t2i, t3i);
+			_mm512_storeu_pd(r0 + j, _mm512_add_pd(a0r, sr));
+			_mm512_storeu_pd(i0 + j, _mm512_add_pd(a0i, si));
+			_mm512_storeu_pd(r2 + j, _mm512_sub_pd(a0r, sr));
+			_mm512_storeu_pd(i2 + j, _mm512_sub_pd(a0i, si));
+			_mm512_storeu_pd(r1 + j, _mm512_sub_pd(a1r, di));	// a1 + id
+			_mm512_storeu_pd(i1 + j, _mm512_add_pd(a1i, dr));
+			_mm512_storeu_pd(r3 + j, _mm512_add_pd(a1r, di));	// a1 - id
+			_mm512_storeu_pd(i3 + j, _mm512_sub_pd(a1i, dr));
+		}
+	}
+}
+
+static inline AVX512 void transpose8(__m512d *r) {
+	// pairs of rows, then quads with permutex2var, then the 256-bit halves
+	const __m512i lo = _mm512_set_epi64(13, 12, 5, 4, 9, 8, 1, 0);
+	const __m512i hi = _mm512_set_epi64(15, 14, 7, 6, 11, 10, 3, 2);
+	__m512d t[8], u[8];
+	for (int k = 0; k < 8; k += 2) {
+		t[k] = _mm512_unpacklo_pd(r[k], r[k + 1]);
+		t[k + 1] = _mm512_unpackhi_pd(r[k], r[k + 1]);
+	}
+	for (int k = 0; k < 8; k += 4) {
+		u[k] = _mm512_permutex2var_pd(t[k], lo, t[k + 2]);
+		u[k + 1] = _mm512_permutex2var_pd(t[k + 1], lo, t[k + 3]);
+		u[k + 2] = _mm512_permutex2var_pd(t[k], hi, t[k + 2]);
+		u[k + 3] = _mm512_permutex2var_pd(t[k + 1], hi, t[k + 3]);
+	}
+	for (int k = 0; k < 4; k++) {
+		r[k] = _mm512_shuffle_f64x2(u[k], u[k + 4], 0x44);
+		r[k + 4] = _mm512_shuffle_f64x2(u[k], u[k + 4], 0xEE);
+	}
+}
+
+static AVX512 void tail_gs_avx512(double *re, double *im, int n, const double *tw) {
+	// stages half = 4, 2, 1 on 8 blocks of 8 values, lane g holds block g after the transpose
+	__m512d w4r[4], w4i[4], w2r[2], w2i[2];
+	for (int k = 0; k < 4; k++) {
+		w4r[k] = _mm512_set1_pd(tw[8 + k]);
+		w4i[k] = _mm512_set1_pd(tw[12 + k]);
+	}
+	for (int k = 0; k < 2; k++) {
+		w2r[k] = _mm512_set1_pd(tw[4 + k]);
+		w2i[k] = _mm512_set1_pd(tw[6 + k]);
+	}
+	__m512d w1r = _mm512_set1_pd(tw[2]), w1i = _mm512_set1_pd(tw[3]);
+	for (int s = 0; s < n; s += 64) {
+		__m512d r[8], i[8];
+		for (int g = 0; g < 8; g++) {
+			r[g] = _mm512_loadu_pd(re + s + 8 * g);
+			i[g] = _mm512_loadu_pd(im + s + 8 * g);
+		}
+		transpose8(r);
+		transpose8(i);
+		for (int k = 0; k < 4; k++) {
+			bfly_gs(r[k], i[k], r[k + 4], i[k + 4], w4r[k], w4i[k]);
+		}
+		for (int k = 0; k < 8; k += 4) {
+			bfly_gs(r[k], i[k], r[k + 2], i[k + 2], w2r[0], w2i[0]);
+			bfly_gs(r[k + 1], i[k + 1], r[k + 3], i[k + 3], w2r[1], w2i[1]);
+		}
+		for (int k = 0; k < 8; k += 2) {
+			bfly_gs(r[k], i[k], r[k + 1], i[k + 1], w1r, w1i);
+		}
+		transpose8(r);
+		transpose8(i);
+		for (int g = 0; g < 8; g++) {
+			_mm512_storeu_pd(re + s + 8 * g, r[g]);
+			_mm512_storeu_pd(im + s + 8 * g, i[g]);
+		}
+	}
+}
+
+static AVX512 void tail_ct_avx512(double *re, double *im, int n, const double *tw) {
+	// stages half = 1, 2, 4
+	__m512d w4r[4], w4i[4], w2r[2], w2i[2];
+	for (int k = 0; k < 4; k++) {
+		w4r[k] = _mm512_set1_pd(tw[8 + k]);
+		w4i[k] = _mm512_set1_pd(tw[12 + k]);
+	}
+	for (int k = 0; k < 2; k++) {
+		w2r[k] = _mm512_set1_pd(tw[4 + k]);
+		w2i[k] = _mm512_set1_pd(tw[6 + k]);
+	}
+	__m512d w1r = _mm512_set1_pd(tw[2]), w1i = _mm512_set1_pd(tw[3]);
+	for (int s = 0; s < n; s += 64) {
+		__m512d r[8], i[8];
+		for (int g = 0; g < 8; g++) {
+			r[g] = _mm512_loadu_pd(re + s + 8 * g);
+			i[g] = _mm512_loadu_pd(im + s + 8 * g);
+		}
+		transpose8(r);
+		transpose8(i);
+		for (int k = 0; k < 8; k += 2) {
+			bfly_ct(r[k], i[k], r[k + 1], i[k + 1], w1r, w1i);
+		}
+		for (int k = 0; k < 8; k += 4) {
+			bfly_ct(r[k], i[k], r[k + 2], i[k + 2], w2r[0], w2i[0]);
+			bfly_ct(r[k + 1], i[k + 1], r[k + 3], i[k + 3], w2r[1], w2i[1]);
+		}
+		for (int k = 0; k < 4; k++) {
+			bfly_ct(r[k], i[k], r[k + 4], i[k + 4], w4r[k], w4i[k]);
+		}
+		transpose8(r);
+		transpose8(i);
+		for (int g = 0; g < 8; g++) {
+			_mm512_storeu_pd(re + s + 8 * g, r[g]);
+			_mm512_storeu_pd(im + s + 8 * g, i[g]);
+		}
+	}
+}
+
+static const SoaKernels &soa_kernels(cpu_isa isa) {
+	static const SoaKernels k[3] = {
+		{ 1, r2_gs_stage_scalar, r2_ct_stage_scalar, r4_gs_stage_scalar, r4_ct_stage_scalar, 0, 0 },
+		{ 4, r2_gs_stage_avx2, r2_ct_stage_avx2, r4_gs_stage_avx2, r4_ct_stage_avx2, tail_gs_avx2, tail_ct_avx2 },
+		{ 8, r2_gs_stage_avx512, r2_ct_stage_avx512, r4_gs_stage_avx512, r4_ct_stage_avx512, tail_gs_avx512, tail_ct_avx512 }
+	};
+	return k[isa];
+}
+
+void fft_split(double *re, double *im, const Complex *x, int n) {
+	const double *p = (const double *)x;
+	for (int i = 0; i < n; i++) {
+		re[i] = p[2*i];
+		im[i] = p[2*i+1];
+	}
+}
+
+void fft_merge(Complex *x, const double *re, const double *im, int n) {
+	double *p = (double *)x;
+	for (int i = 0; i < n; i++) {
+		p[2*i] = re[i];
+		p[2*i+1] = im[i];
+	}
+}
+
+FftSoaPlan::FftSoaPlan(int n, cpu_isa isa)
+	: n_(n), log2n_(0), isa_(cpu_resolve_isa(isa)) {
+	if (n < 1 || (n & (n - 1)) != 0) {
+		throw invalid_argument("FftSoaPlan: n must be a power of 2");
+	}
+	while ((1 << log2n_) < n) log2n_++;
+
+	// the transposed tail needs width x width values
+	if (isa_ == ISA_AVX512 && n < 64) isa_ = ISA_AVX2;
+	if (isa_ == ISA_AVX2 && n < 16) isa_ = ISA_SCALAR;
+
+	// the twiddles of FftPlan, split into re / im
+	FftPlan plan(n, ISA_SCALAR);
+	tw_.assign(2 * n, 0.0);
+	tw_inv_.assign(2 * n, 0.0);
+	for (int half = 1; half < n; half <<= 1) {
+		const Complex *w = plan.twiddles(half);
+		for (int j = 0; j < half; j++) {
+			tw_[2 * half + j] = w[j].real();
+			tw_[3 * half + j] = w[j].imag();
+			tw_inv_[2 * half + j] = w[j].real();
+			tw_inv_[3 * half + j] = -w[j].imag();
+		}
+	}
+
+	tw4_.assign(n >= 4 ? 6 * (n / 2 - 1) : 6, 0.0);
+	tw4_inv_.assign(tw4_.size(), 0.0);
+	for (int q = 1; 4 * q <= n; q <<= 1) {
+		const Complex *w = plan.twiddles4(q);
+		double *t = &tw4_[6 * (q - 1)];
+		double *ti = &tw4_inv_[6 * (q - 1)];
+		for (int r = 0; r < 3; r++) {
+			for (int j = 0; j < q; j++) {
+				t[2 * r * q + j] = w[r * q + j].real();
+				t[(2 * r + 1) * q + j] = w[r * q + j].imag();
+				ti[2 * r * q + j] = w[r * q + j].real();
+				ti[(2 * r + 1) * q + j] = -w[r * q + j].imag();
+			}
+		}
+	}
+}
+
+void FftSoaPlan::forward(double *re, double *im) const {
+	// radix-4 pairs down to half = width, a radix-2 stage when one is left, then the tail
+	const SoaKernels &k = soa_kernels(isa_);
+	int half = n_ / 2;
+	while (half >= k.width) {
+		if (half / 2 >= k.width) {
+			k.r4_gs_stage(re, im, n_, half / 2, &tw4_[6 * (half / 2 - 1)]);
+			half >>= 2;
+		}
+		else {
+			k.r2_gs_stage(re, im, n_, half, &tw_[2 * half]);
+			half >>= 1;
+		}
+	}
+	if (k.tail_gs) {
+		k.tail_gs(re, im, n_, tw_.data());
+	}
+}
+
+void FftSoaPlan::inverse(double *re, double *im) const {
+	const SoaKernels &k = soa_kernels(isa_);
+	if (k.tail_ct) {
+		k.tail_ct(re, im, n_, tw_inv_.data());
+	}
+	int half = k.width;
+	int lgw = 0;
+	while ((1 << lgw) < k.width) lgw++;
+	if ((log2n_ - lgw) & 1) {
+		k.r2_ct_stage(re, im, n_, half, &tw_inv_[2 * half]);
+		half <<= 1;
+	}
+	for (; half < n_; half <<= 2) {
+		k.r4_ct_stage(re, im, n_, half, &tw4_inv_[6 * (half - 1)]);
+	}
+
+	// 1 / n is a power of 2, the scaling is exact
+	const double scale = 1.0 / n_;
+	for (int i = 0; i < n_; i++) {
+		re[i] *= scale;
+		im[i] *= scale;
+	}
+}
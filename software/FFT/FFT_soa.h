@@ -0,0 +1,68 @@
+/*
+ * FFT_soa.h
+ *
+ * Description
+ * Split-complex (structure of arrays) FFT : the real and the imaginary parts
+ * live in two double arrays instead of the interleaved std::complex<double>
+ * A register then holds 4 (AVX2) or 8 (AVX-512) real parts of consecutive j,
+ * every butterfly is plain vertical FMA, the interleaved kernels of FFT_kernels.h
+ * spend their shuffles on the (re, im) swap of each complex multiply
+ *
+ * Same arrangement and output order as FftPlan (FFT_plan.h)
+ *   forward : DIF, natural order in, bit-reversed order out
+ *   inverse : DIT, bit-reversed order in, natural order out, scaled by 1 / n
+ * The stages with half >= V (V = values per register) are radix-4 pairs,
+ * with a radix-2 stage when their number is odd, the last log2(V) stages run on
+ * blocks of V x V values transposed in registers, so they are vertical as well
+ * Sizes below V x V use the next smaller ISA
+ *
+ * The twiddles are the correctly rounded ones of FftPlan
+ *
+ * fft_split() / fft_merge() convert to and from the interleaved Complex API
+ * Invalid sizes throw std::invalid_argument
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * */
+
+#ifndef FFT_SOA_H
+#define FFT_SOA_H
+
+#include <vector>
+
+#include "FFT_kernels.h"
+
+// re[i] = x[i].real(), im[i] = x[i].imag()
+void fft_split(double *re, double *im, const Complex *x, int n);
+
+// x[i] = (re[i], im[i])
+void fft_merge(Complex *x, const double *re, const double *im, int n);
+
+class FftSoaPlan {
+public:
+	// n : power of 2, isa : ISA_AUTO or the highest ISA the plan may use
+	explicit FftSoaPlan(int n, cpu_isa isa = ISA_AUTO);
+
+	int size() const { return n_; }
+	int log2n() const { return log2n_; }
+	cpu_isa isa() const { return isa_; }
+
+	// in-place transforms on n values
+	void forward(double *re, double *im) const;
+	void inverse(double *re, double *im) const;
+
+private:
+	int n_;
+	int log2n_;
+	cpu_isa isa_;
+
+	// stage with distance half : re at [2 half, 3 half), im at [3 half, 4 half)
+	std::vector<double> tw_;
+	std::vector<double> tw_inv_;
+
+	// radix-4 stage q at 6 (q - 1) : re / im of W(j, 4q) | W(2j, 4q) | W(3j, 4q)
+	std::vector<double> tw4_;
+	std::vector<double> tw4_inv_;
+};
+
+#endif
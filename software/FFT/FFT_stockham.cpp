@@ -0,0 +1,83 @@
+/*
+ * FFT_stockham.cpp
+ *
+ * Description
+ * Implementation of FftStockham, see FFT_stockham.h
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * */
+
+#include "FFT_stockham.h"
+#include "FFT_plan.h"
+
+#include <stdexcept>
+
+using namespace std;
+
+FftStockham::FftStockham(int n, cpu_isa isa)
+	: n_(n), log2n_(0), kernels_(fft_kernels(isa)) {
+	if (n < 1 || (n & (n - 1)) != 0) {
+		throw invalid_argument("FftStockham: n must be a power of 2");
+	}
+	while ((1 << log2n_) < n) log2n_++;
+
+	// the same twiddles as FftPlan, subsampled from the whole circle
+	int c = (n < 8) ? 8 : n;
+	if (n >= 4) {
+		tw4_.assign(3 * (n / 2 - 1), Complex(0, 0));
+		tw4_inv_.assign(3 * (n / 2 - 1), Complex(0, 0));
+	}
+	for (int m = 1; 4 * m <= n; m <<= 1) {
+		int step = c / (4 * m);
+		Complex *w = &tw4_[3 * (m - 1)];
+		Complex *wi = &tw4_inv_[3 * (m - 1)];
+		for (int p = 0; p < m; p++) {
+			for (int k = 1; k <= 3; k++) {
+				w[(k - 1) * m + p] = root_of_unity(k * p * step, c);
+				wi[(k - 1) * m + p] = conj(w[(k - 1) * m + p]);
+			}
+		}
+	}
+}
+
+Complex *FftStockham::passes(Complex *x, Complex *tmp, bool inverse) const {
+	fft_pass_fn pass4 = inverse ? kernels_.stockham4_inv : kernels_.stockham4_fwd;
+	const vector<Complex> &tw4 = inverse ? tw4_inv_ : tw4_;
+	Complex *src = x, *dst = tmp;
+	int m = n_, s = 1;
+	for (; m >= 4; s <<= 2) {
+		m >>= 2;
+		pass4(src, dst, m, s, &tw4[3 * (m - 1)]);
+		Complex *t = src;
+		src = dst;
+		dst = t;
+	}
+	if (m == 2) {
+		// W(0, 2) = 1 in both directions
+		const Complex one(1, 0);
+		kernels_.stockham_pass(src, dst, 1, s, &one);
+		src = dst;
+	}
+	return src;
+}
+
+void FftStockham::forward(Complex *x, Complex *tmp) const {
+	Complex *y = passes(x, tmp, false);
+	if (y != x) {
+		for (int i = 0; i < n_; i++) {
+			x[i] = y[i];
+		}
+	}
+}
+
+void FftStockham::inverse(Complex *x, Complex *tmp) const {
+	const double *y = (const double *)passes(x, tmp, true);
+
+	// 1 / n is a power of 2, the scaling is exact
+	const double scale = 1.0 / n_;
+	double *p = (double *)x;
+	for (int i = 0; i < 2 * n_; i++) {
+		p[i] = y[i] * scale;
+	}
+}
@@ -0,0 +1,56 @@
+/*
+ * FFT_stockham.h
+ *
+ * Description
+ * Stockham auto-sort FFT, natural order in and natural order out
+ * FFT_org.cpp pays for reverse() before its loops, FFT_GSCT.cpp and FftPlan avoid
+ * it by leaving the spectrum in bit-reversed order
+ * Here every pass reads x and writes y (ping-pong), the index arithmetic of the
+ * pass does the reordering, so no permutation is needed and every access of
+ * every pass has unit stride (stockham_pass in FFT_kernels.h)
+ *
+ * Every pass streams the whole array through the cache, so the passes are
+ * radix-4 (stockham4_fwd / stockham4_inv), log2(n) / 2 of them, and one radix-2
+ * pass (stockham_pass) when log2(n) is odd
+ * When the number of passes is odd the result ends in tmp and is copied back,
+ * inverse() does this copy together with the 1 / n scaling
+ * Invalid sizes throw std::invalid_argument
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * */
+
+#ifndef FFT_STOCKHAM_H
+#define FFT_STOCKHAM_H
+
+#include <vector>
+
+#include "FFT_kernels.h"
+
+class FftStockham {
+public:
+	// n : power of 2, isa : ISA_AUTO or the highest ISA the plan may use
+	explicit FftStockham(int n, cpu_isa isa = ISA_AUTO);
+
+	int size() const { return n_; }
+	int log2n() const { return log2n_; }
+	cpu_isa isa() const { return kernels_.isa; }
+
+	// in-place transforms on n values in natural order, tmp must hold n values
+	void forward(Complex *x, Complex *tmp) const;
+	void inverse(Complex *x, Complex *tmp) const;
+
+private:
+	// all the passes, returns the buffer that holds the result
+	Complex *passes(Complex *x, Complex *tmp, bool inverse) const;
+
+	int n_;
+	int log2n_;
+	FftKernels kernels_;
+
+	// radix-4 pass with m at [3 (m - 1), 3 (2m - 1)), W(p, 4m) | W(2p, 4m) | W(3p, 4m)
+	std::vector<Complex> tw4_;
+	std::vector<Complex> tw4_inv_;
+};
+
+#endif
@@ -0,0 +1,151 @@
+/*
+ * FFT_tft.cpp
+ *
+ * Description
+ * Implementation of FftTft, see FFT_tft.h
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * */
+
+#include "FFT_tft.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace std;
+
+static int check_size(int n) {
+	if (n < 2 || (n & (n - 1)) != 0 || n > (1 << 30)) {
+		throw invalid_argument("FftTft: n must be a power of 2 in [2, 2^30]");
+	}
+	return n;
+}
+
+FftTft::FftTft(int n, cpu_isa isa) : n_(check_size(n)) {
+	// root_of_unity() wants a multiple of 8
+	int m = max(n, 8);
+	w_.resize(n / 2);
+	for (int j = 0; j < n / 2; j++) {
+		w_[j] = root_of_unity(j * (m / n), m);
+	}
+	for (int size = 2; size <= n; size <<= 1) {
+		plans_.push_back(FftPlan(size, isa));
+	}
+}
+
+int FftTft::transform_size(int len) {
+	int n = 2;
+	while (n < len) n <<= 1;
+	return n;
+}
+
+void FftTft::forward_rec(Complex *x, int n, int z, int m) const {
+	if (m <= 0 || n == 1) return;
+	if (m == n) {
+		// every output wanted
+		int k = 0;
+		while ((2 << k) < n) k++;
+		plans_[k].forward(x);
+		return;
+	}
+
+	const int h = n / 2;
+	const int stride = n_ / n;
+	const int zh = min(z, h);
+	if (m <= h) {
+		// y0 only, x[j + h] = 0 from z on
+		for (int j = 0; j < z - h; j++) {
+			x[j] += x[j + h];
+		}
+		forward_rec(x, h, zh, m);
+		return;
+	}
+
+	// BFU_GS, both halves are zero from zh on
+	for (int j = 0; j < zh; j++) {
+		Complex u = x[j];
+		Complex v = (j + h < z) ? x[j + h] : Complex(0, 0);
+		x[j] = u + v;
+		x[j + h] = cmul(u - v, w_[j * stride]);
+	}
+	forward_rec(x, h, zh, h);
+	forward_rec(x + h, h, zh, m - h);
+}
+
+void FftTft::inverse_rec(Complex *x, int n, int m) const {
+	if (m <= 0 || n == 1) return;
+	if (m == n) {
+		int k = 0;
+		while ((2 << k) < n) k++;
+		plans_[k].inverse(x);
+		return;
+	}
+
+	const int h = n / 2;
+	const int stride = n_ / n;
+	if (m < h) {
+		// y0 = u + v where u is known, then u = y0 - v everywhere
+		for (int j = m; j < h; j++) {
+			x[j] += x[j + h];
+		}
+		inverse_rec(x, h, m);
+		for (int j = 0; j < h; j++) {
+			x[j] -= x[j + h];
+		}
+		return;
+	}
+
+	// y0 from the complete first half, y1 = (y0 - 2v) w^j where v is known
+	inverse_rec(x, h, h);
+	for (int j = m - h; j < h; j++) {
+		x[j + h] = cmul(x[j] - 2.0 * x[j + h], w_[j * stride]);
+	}
+	inverse_rec(x + h, h, m - h);
+
+	// BFU_CT with the 1 / 2 of this layer
+	for (int j = 0; j < h; j++) {
+		Complex y0 = x[j];
+		Complex t = cmul(x[j + h], conj(w_[j * stride]));
+		x[j] = 0.5 * (y0 + t);
+		x[j + h] = 0.5 * (y0 - t);
+	}
+}
+
+void FftTft::forward(Complex *x, int z, int m) const {
+	if (z < 0 || z > n_ || m < 0 || m > n_) {
+		throw invalid_argument("FftTft: z and m must be in [0, n]");
+	}
+	forward_rec(x, n_, z, m);
+}
+
+void FftTft::inverse(Complex *x, int m) const {
+	if (m < 0 || m > n_) {
+		throw invalid_argument("FftTft: m must be in [0, n]");
+	}
+	inverse_rec(x, n_, m);
+}
+
+void FftTft::multiply(Complex *out, const Complex *a, int la, const Complex *b, int lb, Complex *tmp) const {
+	if (la < 1 || lb < 1 || (long long)la + lb - 1 > n_) {
+		throw invalid_argument("FftTft: la + lb - 1 must be in [1, n]");
+	}
+	const int len = la + lb - 1;
+	const int n = transform_size(len);
+	Complex *x = tmp;
+	Complex *y = tmp + n;
+	copy(a, a + la, x);
+	fill(x + la, x + n, Complex(0, 0));
+	copy(b, b + lb, y);
+	fill(y + lb, y + n, Complex(0, 0));
+
+	// the sub-block of size n uses W(j, n), the stride of its twiddles
+	forward_rec(x, n, la, len);
+	forward_rec(y, n, lb, len);
+	for (int i = 0; i < len; i++) {
+		x[i] = cmul(x[i], y[i]);
+	}
+	fill(x + len, x + n, Complex(0, 0));
+	inverse_rec(x, n, len);
+	copy(x, x + len, out);
+}
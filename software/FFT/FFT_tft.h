@@ -0,0 +1,67 @@
+/*
+ * FFT_tft.h
+ *
+ * Description
+ * Truncated FFT (van der Hoeven's truncated Fourier transform) on the GS / CT
+ * butterflies of FFT_GSCT.cpp, the complex counterpart of NttTft (NTT_tft.h).
+ * A product of la + lb - 1 = 2^k + 1 values pays a full 2^(k+1) transform with
+ * FftPlan, here the cost follows the length :
+ *
+ *   forward(x, z, m)   x[z, n) zero, the first m values of the FFT in bit-reversed
+ *                      order (the order of FftPlan::forward()), a half of a GS layer
+ *                      without wanted outputs is not computed
+ *   inverse(x, m)      x[0, m) the first m values of forward(), x[m, n) the input
+ *                      values at those positions (zero for a product) : the input
+ *                      values at [0, m) into x[0, m), scaled like FftPlan::inverse()
+ *   multiply           out = a * b, complex linear convolution of la + lb - 1 <= n
+ *                      values, the transforms on the power of 2 above la + lb - 1
+ *                      truncated to la + lb - 1
+ * Blocks whose outputs are all wanted run the FftPlan of their size (its SIMD
+ * stages), only the layers above them are truncated
+ *
+ * Real inputs gain nothing here : multiply_real() packs two real inputs into one
+ * transform through the symmetry X[n - k] = conj(X[k]), and a truncated transform
+ * does not have X[n - k]. FftConvolver (FFT_convolve.h) stays on FftPlan
+ *
+ * The object is read-only after construction and can be shared between threads
+ * Invalid parameters throw std::invalid_argument
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * */
+
+#ifndef FFT_TFT_H
+#define FFT_TFT_H
+
+#include <vector>
+
+#include "FFT_plan.h"
+
+class FftTft {
+public:
+	// n : largest transform size, a power of 2
+	explicit FftTft(int n, cpu_isa isa = ISA_AUTO);
+
+	int size() const { return n_; }
+
+	// 0 <= z <= n, 0 <= m <= n, x holds n values
+	void forward(Complex *x, int z, int m) const;
+	void inverse(Complex *x, int m) const;
+
+	// out = a * b, la + lb - 1 <= n values, out may alias a or b
+	// tmp must hold 2 * transform_size(la + lb - 1) values
+	void multiply(Complex *out, const Complex *a, int la, const Complex *b, int lb, Complex *tmp) const;
+
+	// the power of 2 above len the truncated transforms of multiply() run on
+	static int transform_size(int len);
+
+private:
+	void forward_rec(Complex *x, int n, int z, int m) const;
+	void inverse_rec(Complex *x, int n, int m) const;
+
+	int n_;
+	std::vector<Complex> w_;		// W(j, n), j < n / 2
+	std::vector<FftPlan> plans_;	// plans_[k] : size 2^(k + 1)
+};
+
+#endif
@@ -11,11 +11,14 @@
  *
  * History
  * 2023/05/11	jorjor	First release
+ * 2026/10/17	jorjor	Twiddle tables built at compile time (NTT_constexpr.h)
  * */
 
 #include <iostream>
 #include <cmath>
 
+#include "NTT_constexpr.h"
+
 #define q 3329
 
 using namespace std;
@@ -36,43 +39,12 @@ int quickmod(int a, int b) {
 	return ans;
 }
 
-int findw(int n) {
-	// find primitive root
-	bool CONTINUE = true;
-	int pr;
-	for (pr = 2; pr < q; pr++){
-		for (int i = 1; i < q; i++) {
-			if (i == q - 1) {
-				CONTINUE = false;
-			}
-			else if (quickmod(pr, i) % q == 1) {
-				break;
-			}
-		}
-		if (CONTINUE == false) {
-			break;
-		}
-	}
-
-	int w = quickmod(pr, (int)(q - 1)/n);
-	return w;
-}
-
-int InverseMod(int a) {
-	for (int b = 2; b < q; b++) {
-		if ((a * b) % q == 1){
-			return b;
-		}
-	}
-	return -1;
-}
-
 void DIV2(int *a) {
 	int temp = (*a) ;
 	(*a) = (temp >> 1) + (temp & 1) * ((q + 1) / 2);
 }
 
-void print(int* arr, int len) {
+void print(const int* arr, int len) {
     cout << "[ ";
     for (int i = 0; i < len; i++) {
         cout << arr[i];
@@ -134,7 +106,7 @@ int main(){
 	// set seed to 0
 	srand(0);
 
-	int n = 8;
+	const int n = 8;
 	//int x1[] = {100, 100, 100, 100};
 	//int x2[] = {100, 200, 300, 400};
 	int x1[] = {100, 200, 200, 0, 100, 200, 500, 0};
@@ -152,23 +124,12 @@ int main(){
     cout << "x1: "; print(x1, n);
     cout << "x2: "; print(x2, n); cout << endl;
 
-	// build the array of w
-	int w = findw(n);
-	int winv = InverseMod(w);
-	
-	int *wn = new int[n];
-	wn[0] = 1;
-	for (int i = 1; i < n; i++){
-		wn[i] = (wn[i-1] * w) % q;
-	}
+	// the arrays of w and w^-1, w = 3^((q - 1) / n), 3 generates (Z/q)*
+	typedef CyclicConstTables<n, q, cx_root_of_unity(n, q), int> tables;
+	static_assert(tables::wn[1] == 749, "w = 749");
+	const int *wn = tables::wn;
+	const int *wn_inv = tables::wn_inv;
 
-	// build the array of w
-	int *wn_inv = new int[n];
-	wn_inv[0] = 1;
-	for (int i = 1; i < n; i++){
-		wn_inv[i] = (wn_inv[i-1] * winv) % q;
-	}
-    
     cout << "***** Wn array *****" << endl;
     cout << "wn: "; print(wn, n);
 	cout << "***** Wn_inv array *****" << endl;
@@ -271,15 +232,15 @@ int main(){
     cout << "x1_intt: "; print(x1_intt, n);
     cout << "x2_intt: "; print(x2_intt, n); cout << endl;
 
-	delete x1_intt;
-	delete x2_intt;
+	delete[] x1_intt;
+	delete[] x2_intt;
 #endif
 	
-	delete x1_ntt;
-	delete x2_ntt;
-	delete X_multi;
-	delete X_intt;
-	delete naive_result;
+	delete[] x1_ntt;
+	delete[] x2_ntt;
+	delete[] X_multi;
+	delete[] X_intt;
+	delete[] naive_result;
 
 	return 0;
 }
@@ -11,6 +11,7 @@
  *
  * History
  * 2023/05/11	jorjor	First release
+ * 2026/10/17	jorjor	findw() tests the prime factors of q - 1, InverseMod() by extended Euclid
  * */
 
 #include <iostream>
@@ -37,19 +38,25 @@ int quickmod(int a, int b) {
 }
 
 int findw(int n) {
-	// find primitive root
-	bool CONTINUE = true;
+	// find primitive root : pr ** ((q - 1) / p) != 1 for every prime p of q - 1
+	int factors[32];
+	int count = 0;
+	int m = q - 1;
+	for (int d = 2; d * d <= m; d++) {
+		if (m % d == 0) {
+			factors[count++] = d;
+			while (m % d == 0) m /= d;
+		}
+	}
+	if (m > 1) factors[count++] = m;
+
 	int pr;
-	for (pr = 2; pr < q; pr++){
-		for (int i = 1; i < q; i++) {
-			if (i == q - 1) {
-				CONTINUE = false;
-			}
-			else if (quickmod(pr, i) % q == 1) {
-				break;
-			}
+	for (pr = 2; pr < q; pr++) {
+		bool primitive = true;
+		for (int i = 0; i < count && primitive; i++) {
+			primitive = (quickmod(pr, (q - 1) / factors[i]) != 1);
 		}
-		if (CONTINUE == false) {
+		if (primitive) {
 			break;
 		}
 	}
@@ -59,12 +66,22 @@ int findw(int n) {
 }
 
 int InverseMod(int a) {
-	for (int b = 2; b < q; b++) {
-		if ((a * b) % q == 1){
-			return b;
-		}
+	// extended Euclid, t * a = r mod q on every row
+	int t0 = 0, t1 = 1;
+	int r0 = q, r1 = a % q;
+	while (r1 != 0) {
+		int k = r0 / r1;
+		int r2 = r0 - k * r1;
+		int t2 = t0 - k * t1;
+		r0 = r1;
+		r1 = r2;
+		t0 = t1;
+		t1 = t2;
+	}
+	if (r0 != 1) {
+		return -1;
 	}
-	return -1;
+	return (t0 < 0) ? t0 + q : t0;
 }
 
 void DIV2(int *a) {
@@ -271,15 +288,15 @@ int main(){
     cout << "x1_intt: "; print(x1_intt, n);
     cout << "x2_intt: "; print(x2_intt, n); cout << endl;
 
-	delete x1_intt;
-	delete x2_intt;
+	delete[] x1_intt;
+	delete[] x2_intt;
 #endif
 	
-	delete x1_ntt;
-	delete x2_ntt;
-	delete X_multi;
-	delete X_intt;
-	delete naive_result;
+	delete[] x1_ntt;
+	delete[] x2_ntt;
+	delete[] X_multi;
+	delete[] X_intt;
+	delete[] naive_result;
 
 	return 0;
 }
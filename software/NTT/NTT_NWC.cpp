@@ -15,19 +15,29 @@
  *
  * History
  * 2023/06/15	jorjor	First release
+ * 2026/10/17	jorjor	Twiddle reordering by bitrev.h
+ * 2026/10/17	jorjor	Twiddle and zeta tables built at compile time (NTT_constexpr.h)
  * */
 
 #include <iostream>
 #include <cmath>
 
+#include "NTT_constexpr.h"
+
 #define q 3329
 #define n 256
 
 using namespace std;
 
-int wn[n] = {0};
-int wn_inv[n] = {0};
-int wq[n] = {0};
+/* psi = 17 of order 256, see NTT_constexpr.h for the layout */
+typedef NwcConstTables<n, q, 17, int> tables;
+
+static_assert(tables::wn[1] == 1729, "wn[1] = 17^64");
+static_assert(tables::wq[0] == 17, "wq[0] = 17");
+
+const int (&wn)[n] = tables::wn;
+const int (&wn_inv)[n] = tables::wn_inv;
+const int (&wq)[n] = tables::wq;
 
 int gcd(int a, int b) {
 	if (b == 0) return a;
@@ -45,20 +55,11 @@ int quickmod(int a, int b) {
 	return ans;
 }
 
-int InverseMod(int a) {
-	for (int b = 2; b < q; b++) {
-		if ((a * b) % q == 1){
-			return b;
-		}
-	}
-	return -1;
-}
-
 int DIV2(int a) {
 	return (a >> 1) + (a & 1) * ((q + 1) / 2);
 }
 
-void print(int* arr) {
+void print(const int* arr) {
     cout << "[ ";
     for (int i = 0; i < n; i++) {
         cout << arr[i];
@@ -69,17 +70,6 @@ void print(int* arr) {
     cout << " ]" << endl;
 }
 
-int bitreverse(int num, int len) {
-	int result = 0;
-
-	for (int i = len - 1; i >= 0; i--) {
-		result += ((num & 1) * pow(2, i));
-		num >>= 1;
-	}
-
-	return result;
-}
-
 int modq(int num){
 	int modnum = num % q;
 	if (num < 0){
@@ -204,37 +194,6 @@ int main(){
     cout << "x1: "; print(x1);
     cout << "x2: "; print(x2); cout << endl;
 
-	/* build the array of w */
-	int w = 17;
-	
-	wn[0] = 1;
-	for (int i = 1; i < n; i++){
-		wn[i] = (wn[i-1] * w) % q;
-	}
-
-	/* build the array of winv */
-	int winv = InverseMod(w);
-	
-	wn_inv[0] = 1;
-	for (int i = 1; i < n; i++){
-		wn_inv[i] = (wn_inv[i-1] * winv) % q;
-	}
-    
-	for (int i = 0; i < n; i++){
-		wq[i] = wn[2*bitreverse(i, 7)+1];
-	}
-
-	/* bitreverse */
-	int temp[n] = {0};
-	for (int i = 0; i < n; i++) temp[i] = wn[i];
-	for (int i = 0; i < n; i++){
-		wn[i] = temp[bitreverse(i, 7)];
-	}
-
-	for (int i = 0; i < n; i++) temp[i] = wn_inv[i];
-	for (int i = 0; i < n; i++){
-		wn_inv[i] = temp[bitreverse(i, 7)+1];
-	}
 	cout << "***** Wn array *****" << endl;
     cout << "wn: "; print(wn);
 	
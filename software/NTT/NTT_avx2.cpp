@@ -0,0 +1,274 @@
+/*
+ * NTT_avx2.cpp
+ *
+ * Description
+ * Implementation of NttAvx2, see NTT_avx2.h
+ * The kernels are compiled with the AVX2 target attribute of cpu_target.h
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * 2026/10/17	jorjor	Pointwise multiplication and uint32_t entry points
+ * 2026/10/17	jorjor	Intrinsics and target attribute from cpu_target.h
+ * */
+
+#include "NTT_avx2.h"
+#include "cpu_target.h"
+
+static inline AVX2 __m256i fqmul(__m256i b, __m256i z, __m256i zq, __m256i Q) {
+	// b * z * 2^-16 mod q, in (-q, q)
+	__m256i lo = _mm256_mullo_epi16(b, zq);
+	__m256i hi = _mm256_mulhi_epi16(b, z);
+	lo = _mm256_mulhi_epi16(lo, Q);
+	return _mm256_sub_epi16(hi, lo);
+}
+
+static inline AVX2 __m256i fqmul_var(__m256i a, __m256i b, __m256i QINV, __m256i Q) {
+	// a * b * 2^-16 mod q without a precomputed b * q^-1
+	__m256i lo = _mm256_mullo_epi16(_mm256_mullo_epi16(a, b), QINV);
+	__m256i hi = _mm256_mulhi_epi16(a, b);
+	lo = _mm256_mulhi_epi16(lo, Q);
+	return _mm256_sub_epi16(hi, lo);
+}
+
+static inline AVX2 __m256i barrett(__m256i a, __m256i V, int shift, __m256i Q) {
+	// a mod q, in [0, q]
+	__m256i t = _mm256_mulhi_epi16(a, V);
+	t = _mm256_sra_epi16(t, _mm_cvtsi32_si128(shift));
+	t = _mm256_mullo_epi16(t, Q);
+	return _mm256_sub_epi16(a, t);
+}
+
+static inline AVX2 __m256i canonical(__m256i a, __m256i Q) {
+	// (-q, q) -> [0, q)
+	return _mm256_add_epi16(a, _mm256_and_si256(_mm256_srai_epi16(a, 15), Q));
+}
+
+static inline AVX2 __m256i swap_pairs(__m256i a) {
+	// (x0, x1, x2, x3, ...) -> (x1, x0, x3, x2, ...)
+	return _mm256_or_si256(_mm256_slli_epi32(a, 16), _mm256_srli_epi32(a, 16));
+}
+
+static inline AVX2 void BFU_CT(__m256i &a, __m256i &b, __m256i z, __m256i zq, __m256i Q) {
+	// DIT-FFT
+	// Cooley Tukey algorithm
+	__m256i t = fqmul(b, z, zq, Q);
+	b = _mm256_sub_epi16(a, t);
+	a = _mm256_add_epi16(a, t);
+}
+
+static inline AVX2 void BFU_GS(__m256i &a, __m256i &b, __m256i z, __m256i zq,
+								__m256i V, int shift, __m256i Q) {
+	// DIF-FFT
+	// Gentleman Sande algorithm
+	__m256i t = _mm256_sub_epi16(a, b);
+	a = barrett(_mm256_add_epi16(a, b), V, shift, Q);
+	b = fqmul(t, z, zq, Q);
+}
+
+/* every shuffle is its own inverse */
+static inline AVX2 void shuffle8(__m256i &a, __m256i &b) {
+	__m256i t = _mm256_permute2x128_si256(a, b, 0x20);
+	b = _mm256_permute2x128_si256(a, b, 0x31);
+	a = t;
+}
+
+static inline AVX2 void shuffle4(__m256i &a, __m256i &b) {
+	__m256i t = _mm256_unpacklo_epi64(a, b);
+	b = _mm256_unpackhi_epi64(a, b);
+	a = t;
+}
+
+static inline AVX2 void shuffle2(__m256i &a, __m256i &b) {
+	__m256i t = _mm256_blend_epi32(a, _mm256_slli_epi64(b, 32), 0xAA);
+	b = _mm256_blend_epi32(_mm256_srli_epi64(a, 32), b, 0xAA);
+	a = t;
+}
+
+static inline AVX2 void shuffle1(__m256i &a, __m256i &b) {
+	__m256i t = _mm256_blend_epi16(a, _mm256_slli_epi32(b, 16), 0xAA);
+	b = _mm256_blend_epi16(_mm256_srli_epi32(a, 16), b, 0xAA);
+	a = t;
+}
+
+static inline AVX2 void shuffle(__m256i &a, __m256i &b, int d) {
+	switch (d) {
+	case 8: shuffle8(a, b); break;
+	case 4: shuffle4(a, b); break;
+	case 2: shuffle2(a, b); break;
+	default: shuffle1(a, b); break;
+	}
+}
+
+static inline AVX2 __m256i load(const int16_t *p) {
+	return _mm256_loadu_si256((const __m256i *)p);
+}
+
+static inline AVX2 void store(int16_t *p, __m256i a) {
+	_mm256_storeu_si256((__m256i *)p, a);
+}
+
+static inline AVX2 __m256i load_narrow(const uint32_t *p) {
+	// 16 uint32_t in [0, 2^15) -> 16 int16_t
+	__m256i lo = _mm256_loadu_si256((const __m256i *)p);
+	__m256i hi = _mm256_loadu_si256((const __m256i *)(p + 8));
+	return _mm256_permute4x64_epi64(_mm256_packus_epi32(lo, hi), 0xD8);
+}
+
+static inline AVX2 void store_widen(uint32_t *p, __m256i a) {
+	_mm256_storeu_si256((__m256i *)p, _mm256_cvtepu16_epi32(_mm256_castsi256_si128(a)));
+	_mm256_storeu_si256((__m256i *)(p + 8), _mm256_cvtepu16_epi32(_mm256_extracti128_si256(a, 1)));
+}
+
+static AVX2 void narrow(uint32_t *x, int n) {
+	// in place, the int16_t copy fills the first half of the buffer
+	int16_t *y = (int16_t *)x;
+	for (int i = 0; i < n; i += 16) {
+		store(y + i, load_narrow(x + i));
+	}
+}
+
+static AVX2 void widen(uint32_t *x, int n) {
+	int16_t *y = (int16_t *)x;
+	for (int i = n - 16; i >= 0; i -= 16) {
+		store_widen(x + i, load(y + i));
+	}
+}
+
+AVX2 void NttAvx2::forward(int16_t *x) const {
+	const __m256i Q = _mm256_set1_epi16(t_.q);
+	const __m256i V = _mm256_set1_epi16(t_.barrett);
+	const int shift = t_.shift;
+	const int n = t_.n;
+
+	/* layers with distance >= 16 : whole registers */
+	int k = 1;
+	for (int len = n / 2; len >= 16; len >>= 1) {
+		for (int s = 0; s < n; s += 2 * len) {
+			__m256i z = _mm256_set1_epi16(t_.zetas[k]);
+			__m256i zq = _mm256_set1_epi16(t_.zetas_qinv[k]);
+			k++;
+			for (int j = s; j < s + len; j += 16) {
+				__m256i a = load(x + j);
+				__m256i b = load(x + j + len);
+				BFU_CT(a, b, z, zq, Q);
+				store(x + j, a);
+				store(x + j + len, b);
+			}
+		}
+	}
+
+	/* distance 8, 4, 2 (, 1) : shuffled register pairs */
+	const int small = t_.small;
+	const int16_t *lz = t_.lanes.data();
+	const int16_t *lzq = t_.lanes_qinv.data();
+	for (int p = 0; p < n; p += 32) {
+		__m256i a = load(x + p);
+		__m256i b = load(x + p + 16);
+		for (int l = 0; l < small; l++) {
+			shuffle(a, b, 8 >> l);
+			BFU_CT(a, b, load(lz), load(lzq), Q);
+			shuffle(a, b, 8 >> l);
+			lz += 16;
+			lzq += 16;
+		}
+
+		// |x| < (layers + 1) q -> [0, q)
+		a = barrett(a, V, shift, Q);
+		b = barrett(b, V, shift, Q);
+		store(x + p, canonical(_mm256_sub_epi16(a, Q), Q));
+		store(x + p + 16, canonical(_mm256_sub_epi16(b, Q), Q));
+	}
+}
+
+AVX2 void NttAvx2::inverse(int16_t *x) const {
+	const __m256i Q = _mm256_set1_epi16(t_.q);
+	const __m256i V = _mm256_set1_epi16(t_.barrett);
+	const int shift = t_.shift;
+	const int n = t_.n;
+
+	/* distance (1,) 2, 4, 8 : shuffled register pairs */
+	const int small = t_.small;
+	for (int p = 0; p < n; p += 32) {
+		const int16_t *lz = &t_.lanes_inv[(p / 32) * small * 16];
+		const int16_t *lzq = &t_.lanes_inv_qinv[(p / 32) * small * 16];
+		__m256i a = load(x + p);
+		__m256i b = load(x + p + 16);
+		for (int l = small - 1; l >= 0; l--) {
+			shuffle(a, b, 8 >> l);
+			BFU_GS(a, b, load(lz + 16 * l), load(lzq + 16 * l), V, shift, Q);
+			shuffle(a, b, 8 >> l);
+		}
+		store(x + p, a);
+		store(x + p + 16, b);
+	}
+
+	/* layers with distance >= 16 : whole registers */
+	for (int len = 16; len <= n / 2; len <<= 1) {
+		int k = n / (2 * len);
+		for (int s = 0; s < n; s += 2 * len) {
+			__m256i z = _mm256_set1_epi16(t_.zetas_inv[k]);
+			__m256i zq = _mm256_set1_epi16(t_.zetas_inv_qinv[k]);
+			k++;
+			for (int j = s; j < s + len; j += 16) {
+				__m256i a = load(x + j);
+				__m256i b = load(x + j + len);
+				BFU_GS(a, b, z, zq, V, shift, Q);
+				store(x + j, a);
+				store(x + j + len, b);
+			}
+		}
+	}
+
+	const __m256i f = _mm256_set1_epi16(t_.scale);
+	const __m256i fq = _mm256_set1_epi16(t_.scale_qinv);
+	for (int i = 0; i < n; i += 16) {
+		store(x + i, canonical(fqmul(load(x + i), f, fq, Q), Q));
+	}
+}
+
+static inline AVX2 __m256i PWM(__m256i a, __m256i b, const Ntt16Tables &t, int i) {
+	const __m256i Q = _mm256_set1_epi16(t.q);
+	const __m256i QINV = _mm256_set1_epi16(t.qinv);
+	const __m256i R2 = _mm256_set1_epi16(t.r2);
+	const __m256i R2Q = _mm256_set1_epi16(t.r2_qinv);
+
+	__m256i c;
+	if (t.leaf == 1) {
+		c = fqmul_var(a, b, QINV, Q);
+	}
+	else {
+		// pair (a0, a1) * (b0, b1) mod x^2 - w :
+		// c0 = a0 b0 + w a1 b1 in the even lane, c1 = a0 b1 + a1 b0 in the odd lane
+		__m256i p = fqmul_var(a, b, QINV, Q);
+		__m256i m = fqmul_var(a, swap_pairs(b), QINV, Q);
+		p = fqmul(p, load(&t.pairs[i]), load(&t.pairs_qinv[i]), Q);
+		p = _mm256_add_epi16(p, swap_pairs(p));
+		m = _mm256_add_epi16(m, swap_pairs(m));
+		c = _mm256_blend_epi16(p, m, 0xAA);
+	}
+	return canonical(fqmul(c, R2, R2Q, Q), Q);
+}
+
+AVX2 void NttAvx2::pointwise(int16_t *out, const int16_t *a, const int16_t *b) const {
+	for (int i = 0; i < t_.n; i += 16) {
+		store(out + i, PWM(load(a + i), load(b + i), t_, i));
+	}
+}
+
+AVX2 void NttAvx2::forward(uint32_t *x) const {
+	narrow(x, t_.n);
+	forward((int16_t *)x);
+	widen(x, t_.n);
+}
+
+AVX2 void NttAvx2::inverse(uint32_t *x) const {
+	narrow(x, t_.n);
+	inverse((int16_t *)x);
+	widen(x, t_.n);
+}
+
+AVX2 void NttAvx2::pointwise(uint32_t *out, const uint32_t *a, const uint32_t *b) const {
+	for (int i = 0; i < t_.n; i += 16) {
+		store_widen(out + i, PWM(load_narrow(a + i), load_narrow(b + i), t_, i));
+	}
+}
@@ -0,0 +1,56 @@
+/*
+ * NTT_avx2.h
+ *
+ * Description
+ * AVX2 kernel of NTT() / INTT() / PWM() in NTT_NWC.cpp for small moduli (Kyber, q = 3329)
+ * The coefficients are int16_t, 16 lanes per register, multiplied with the
+ * signed Montgomery trick (vpmullw / vpmulhw, R = 2^16)
+ * Layers with a distance of 16 or more work on whole registers,
+ * the last layers (distance 8, 4, 2 and 1) shuffle two registers so that
+ * every butterfly stays vertical
+ *
+ * The transforms use the twiddles of an NttTables (NTT_tables.h), inputs and outputs
+ * are in [0, q) and in the same order, so the results are bit-identical to
+ * the scalar NttPlan of the same parameter set
+ * The uint32_t entry points narrow the coefficients in place, they are used by NttPlan
+ *
+ * Supported : see Ntt16Tables::supported() in NTT_simd.h (width 16)
+ * the transforms need a CPU with AVX2 + FMA (ISA_AVX2 of cpu_dispatch.h)
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * 2026/10/17	jorjor	Pointwise multiplication and uint32_t entry points
+ * */
+
+#ifndef NTT_AVX2_H
+#define NTT_AVX2_H
+
+#include <stdint.h>
+
+#include "NTT_simd.h"
+
+class NttAvx2 {
+public:
+	static bool supported(const NttTables &tab) { return Ntt16Tables::supported(tab, 16); }
+
+	NttAvx2() {}
+
+	// throws std::invalid_argument when !supported(tab)
+	explicit NttAvx2(const NttTables &tab) : t_(tab, 16) {}
+
+	int size() const { return t_.n; }
+
+	// in-place transforms on n coefficients in [0, q)
+	void forward(int16_t *x) const;
+	void inverse(int16_t *x) const;
+	void pointwise(int16_t *out, const int16_t *a, const int16_t *b) const;
+
+	void forward(uint32_t *x) const;
+	void inverse(uint32_t *x) const;
+	void pointwise(uint32_t *out, const uint32_t *a, const uint32_t *b) const;
+
+private:
+	Ntt16Tables t_;
+};
+
+#endif
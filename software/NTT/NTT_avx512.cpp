@@ -0,0 +1,282 @@
+/*
+ * NTT_avx512.cpp
+ *
+ * Description
+ * Implementation of NttAvx512, see NTT_avx512.h
+ * The kernels are compiled with the AVX512 target attribute of cpu_target.h
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * 2026/10/17	jorjor	Intrinsics and target attribute from cpu_target.h
+ * */
+
+#include "NTT_avx512.h"
+#include "cpu_target.h"
+
+static inline AVX512 __m512i fqmul(__m512i b, __m512i z, __m512i zq, __m512i Q) {
+	// b * z * 2^-16 mod q, in (-q, q)
+	__m512i lo = _mm512_mullo_epi16(b, zq);
+	__m512i hi = _mm512_mulhi_epi16(b, z);
+	lo = _mm512_mulhi_epi16(lo, Q);
+	return _mm512_sub_epi16(hi, lo);
+}
+
+static inline AVX512 __m512i fqmul_var(__m512i a, __m512i b, __m512i QINV, __m512i Q) {
+	// a * b * 2^-16 mod q without a precomputed b * q^-1
+	__m512i lo = _mm512_mullo_epi16(_mm512_mullo_epi16(a, b), QINV);
+	__m512i hi = _mm512_mulhi_epi16(a, b);
+	lo = _mm512_mulhi_epi16(lo, Q);
+	return _mm512_sub_epi16(hi, lo);
+}
+
+static inline AVX512 __m512i barrett(__m512i a, __m512i V, int shift, __m512i Q) {
+	// a mod q, in [0, q]
+	__m512i t = _mm512_mulhi_epi16(a, V);
+	t = _mm512_sra_epi16(t, _mm_cvtsi32_si128(shift));
+	t = _mm512_mullo_epi16(t, Q);
+	return _mm512_sub_epi16(a, t);
+}
+
+static inline AVX512 __m512i canonical(__m512i a, __m512i Q) {
+	// (-q, q) -> [0, q)
+	return _mm512_add_epi16(a, _mm512_and_si512(_mm512_srai_epi16(a, 15), Q));
+}
+
+static inline AVX512 __m512i swap_pairs(__m512i a) {
+	// (x0, x1, x2, x3, ...) -> (x1, x0, x3, x2, ...)
+	return _mm512_or_si512(_mm512_slli_epi32(a, 16), _mm512_srli_epi32(a, 16));
+}
+
+static inline AVX512 void BFU_CT(__m512i &a, __m512i &b, __m512i z, __m512i zq, __m512i Q) {
+	// DIT-FFT
+	// Cooley Tukey algorithm
+	__m512i t = fqmul(b, z, zq, Q);
+	b = _mm512_sub_epi16(a, t);
+	a = _mm512_add_epi16(a, t);
+}
+
+static inline AVX512 void BFU_GS(__m512i &a, __m512i &b, __m512i z, __m512i zq,
+								__m512i V, int shift, __m512i Q) {
+	// DIF-FFT
+	// Gentleman Sande algorithm
+	__m512i t = _mm512_sub_epi16(a, b);
+	a = barrett(_mm512_add_epi16(a, b), V, shift, Q);
+	b = fqmul(t, z, zq, Q);
+}
+
+/* every shuffle is its own inverse */
+static inline AVX512 void shuffle16(__m512i &a, __m512i &b) {
+	__m512i t = _mm512_shuffle_i64x2(a, b, 0x44);
+	b = _mm512_shuffle_i64x2(a, b, 0xEE);
+	a = t;
+}
+
+static inline AVX512 void shuffle8(__m512i &a, __m512i &b) {
+	const __m512i lo = _mm512_set_epi64(13, 12, 5, 4, 9, 8, 1, 0);
+	const __m512i hi = _mm512_set_epi64(15, 14, 7, 6, 11, 10, 3, 2);
+	__m512i t = _mm512_permutex2var_epi64(a, lo, b);
+	b = _mm512_permutex2var_epi64(a, hi, b);
+	a = t;
+}
+
+static inline AVX512 void shuffle4(__m512i &a, __m512i &b) {
+	__m512i t = _mm512_unpacklo_epi64(a, b);
+	b = _mm512_unpackhi_epi64(a, b);
+	a = t;
+}
+
+static inline AVX512 void shuffle2(__m512i &a, __m512i &b) {
+	__m512i t = _mm512_mask_blend_epi32(0xAAAA, a, _mm512_slli_epi64(b, 32));
+	b = _mm512_mask_blend_epi32(0xAAAA, _mm512_srli_epi64(a, 32), b);
+	a = t;
+}
+
+static inline AVX512 void shuffle1(__m512i &a, __m512i &b) {
+	__m512i t = _mm512_mask_blend_epi16(0xAAAAAAAA, a, _mm512_slli_epi32(b, 16));
+	b = _mm512_mask_blend_epi16(0xAAAAAAAA, _mm512_srli_epi32(a, 16), b);
+	a = t;
+}
+
+static inline AVX512 void shuffle(__m512i &a, __m512i &b, int d) {
+	switch (d) {
+	case 16: shuffle16(a, b); break;
+	case 8: shuffle8(a, b); break;
+	case 4: shuffle4(a, b); break;
+	case 2: shuffle2(a, b); break;
+	default: shuffle1(a, b); break;
+	}
+}
+
+static inline AVX512 __m512i load(const int16_t *p) {
+	return _mm512_loadu_si512((const void *)p);
+}
+
+static inline AVX512 void store(int16_t *p, __m512i a) {
+	_mm512_storeu_si512((void *)p, a);
+}
+
+static inline AVX512 __m512i load_narrow(const uint32_t *p) {
+	// 32 uint32_t in [0, 2^15) -> 32 int16_t
+	__m256i lo = _mm512_cvtepi32_epi16(_mm512_loadu_si512((const void *)p));
+	__m256i hi = _mm512_cvtepi32_epi16(_mm512_loadu_si512((const void *)(p + 16)));
+	return _mm512_inserti64x4(_mm512_castsi256_si512(lo), hi, 1);
+}
+
+static inline AVX512 void store_widen(uint32_t *p, __m512i a) {
+	_mm512_storeu_si512((void *)p, _mm512_cvtepu16_epi32(_mm512_castsi512_si256(a)));
+	_mm512_storeu_si512((void *)(p + 16), _mm512_cvtepu16_epi32(_mm512_extracti64x4_epi64(a, 1)));
+}
+
+static AVX512 void narrow(uint32_t *x, int n) {
+	// in place, the int16_t copy fills the first half of the buffer
+	int16_t *y = (int16_t *)x;
+	for (int i = 0; i < n; i += 32) {
+		store(y + i, load_narrow(x + i));
+	}
+}
+
+static AVX512 void widen(uint32_t *x, int n) {
+	int16_t *y = (int16_t *)x;
+	for (int i = n - 32; i >= 0; i -= 32) {
+		store_widen(x + i, load(y + i));
+	}
+}
+
+AVX512 void NttAvx512::forward(int16_t *x) const {
+	const __m512i Q = _mm512_set1_epi16(t_.q);
+	const __m512i V = _mm512_set1_epi16(t_.barrett);
+	const int shift = t_.shift;
+	const int n = t_.n;
+
+	/* layers with distance >= 32 : whole registers */
+	int k = 1;
+	for (int len = n / 2; len >= 32; len >>= 1) {
+		for (int s = 0; s < n; s += 2 * len) {
+			__m512i z = _mm512_set1_epi16(t_.zetas[k]);
+			__m512i zq = _mm512_set1_epi16(t_.zetas_qinv[k]);
+			k++;
+			for (int j = s; j < s + len; j += 32) {
+				__m512i a = load(x + j);
+				__m512i b = load(x + j + len);
+				BFU_CT(a, b, z, zq, Q);
+				store(x + j, a);
+				store(x + j + len, b);
+			}
+		}
+	}
+
+	/* distance 16, 8, 4, 2 (, 1) : shuffled register pairs */
+	const int small = t_.small;
+	const int16_t *lz = t_.lanes.data();
+	const int16_t *lzq = t_.lanes_qinv.data();
+	for (int p = 0; p < n; p += 64) {
+		__m512i a = load(x + p);
+		__m512i b = load(x + p + 32);
+		for (int l = 0; l < small; l++) {
+			shuffle(a, b, 16 >> l);
+			BFU_CT(a, b, load(lz), load(lzq), Q);
+			shuffle(a, b, 16 >> l);
+			lz += 32;
+			lzq += 32;
+		}
+
+		// |x| < (layers + 1) q -> [0, q)
+		a = barrett(a, V, shift, Q);
+		b = barrett(b, V, shift, Q);
+		store(x + p, canonical(_mm512_sub_epi16(a, Q), Q));
+		store(x + p + 32, canonical(_mm512_sub_epi16(b, Q), Q));
+	}
+}
+
+AVX512 void NttAvx512::inverse(int16_t *x) const {
+	const __m512i Q = _mm512_set1_epi16(t_.q);
+	const __m512i V = _mm512_set1_epi16(t_.barrett);
+	const int shift = t_.shift;
+	const int n = t_.n;
+
+	/* distance (1,) 2, 4, 8, 16 : shuffled register pairs */
+	const int small = t_.small;
+	for (int p = 0; p < n; p += 64) {
+		const int16_t *lz = &t_.lanes_inv[(p / 64) * small * 32];
+		const int16_t *lzq = &t_.lanes_inv_qinv[(p / 64) * small * 32];
+		__m512i a = load(x + p);
+		__m512i b = load(x + p + 32);
+		for (int l = small - 1; l >= 0; l--) {
+			shuffle(a, b, 16 >> l);
+			BFU_GS(a, b, load(lz + 32 * l), load(lzq + 32 * l), V, shift, Q);
+			shuffle(a, b, 16 >> l);
+		}
+		store(x + p, a);
+		store(x + p + 32, b);
+	}
+
+	/* layers with distance >= 32 : whole registers */
+	for (int len = 32; len <= n / 2; len <<= 1) {
+		int k = n / (2 * len);
+		for (int s = 0; s < n; s += 2 * len) {
+			__m512i z = _mm512_set1_epi16(t_.zetas_inv[k]);
+			__m512i zq = _mm512_set1_epi16(t_.zetas_inv_qinv[k]);
+			k++;
+			for (int j = s; j < s + len; j += 32) {
+				__m512i a = load(x + j);
+				__m512i b = load(x + j + len);
+				BFU_GS(a, b, z, zq, V, shift, Q);
+				store(x + j, a);
+				store(x + j + len, b);
+			}
+		}
+	}
+
+	const __m512i f = _mm512_set1_epi16(t_.scale);
+	const __m512i fq = _mm512_set1_epi16(t_.scale_qinv);
+	for (int i = 0; i < n; i += 32) {
+		store(x + i, canonical(fqmul(load(x + i), f, fq, Q), Q));
+	}
+}
+
+static inline AVX512 __m512i PWM(__m512i a, __m512i b, const Ntt16Tables &t, int i) {
+	const __m512i Q = _mm512_set1_epi16(t.q);
+	const __m512i QINV = _mm512_set1_epi16(t.qinv);
+	const __m512i R2 = _mm512_set1_epi16(t.r2);
+	const __m512i R2Q = _mm512_set1_epi16(t.r2_qinv);
+
+	__m512i c;
+	if (t.leaf == 1) {
+		c = fqmul_var(a, b, QINV, Q);
+	}
+	else {
+		// pair (a0, a1) * (b0, b1) mod x^2 - w :
+		// c0 = a0 b0 + w a1 b1 in the even lane, c1 = a0 b1 + a1 b0 in the odd lane
+		__m512i p = fqmul_var(a, b, QINV, Q);
+		__m512i m = fqmul_var(a, swap_pairs(b), QINV, Q);
+		p = fqmul(p, load(&t.pairs[i]), load(&t.pairs_qinv[i]), Q);
+		p = _mm512_add_epi16(p, swap_pairs(p));
+		m = _mm512_add_epi16(m, swap_pairs(m));
+		c = _mm512_mask_blend_epi16(0xAAAAAAAA, p, m);
+	}
+	return canonical(fqmul(c, R2, R2Q, Q), Q);
+}
+
+AVX512 void NttAvx512::pointwise(int16_t *out, const int16_t *a, const int16_t *b) const {
+	for (int i = 0; i < t_.n; i += 32) {
+		store(out + i, PWM(load(a + i), load(b + i), t_, i));
+	}
+}
+
+AVX512 void NttAvx512::forward(uint32_t *x) const {
+	narrow(x, t_.n);
+	forward((int16_t *)x);
+	widen(x, t_.n);
+}
+
+AVX512 void NttAvx512::inverse(uint32_t *x) const {
+	narrow(x, t_.n);
+	inverse((int16_t *)x);
+	widen(x, t_.n);
+}
+
+AVX512 void NttAvx512::pointwise(uint32_t *out, const uint32_t *a, const uint32_t *b) const {
+	for (int i = 0; i < t_.n; i += 32) {
+		store_widen(out + i, PWM(load_narrow(a + i), load_narrow(b + i), t_, i));
+	}
+}
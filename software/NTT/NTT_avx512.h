@@ -0,0 +1,48 @@
+/*
+ * NTT_avx512.h
+ *
+ * Description
+ * AVX-512 kernel of NTT() / INTT() / PWM() in NTT_NWC.cpp for small moduli (Kyber, q = 3329)
+ * Same algorithm as NTT_avx2.h on 32 int16_t lanes (AVX-512 BW),
+ * the shuffled layers are distance 16, 8, 4, 2 (and 1)
+ * Results are bit-identical to NttAvx2 and to the scalar NttPlan
+ *
+ * Supported : see Ntt16Tables::supported() in NTT_simd.h (width 32)
+ * the transforms need a CPU with AVX-512 F and BW
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * */
+
+#ifndef NTT_AVX512_H
+#define NTT_AVX512_H
+
+#include <stdint.h>
+
+#include "NTT_simd.h"
+
+class NttAvx512 {
+public:
+	static bool supported(const NttTables &tab) { return Ntt16Tables::supported(tab, 32); }
+
+	NttAvx512() {}
+
+	// throws std::invalid_argument when !supported(tab)
+	explicit NttAvx512(const NttTables &tab) : t_(tab, 32) {}
+
+	int size() const { return t_.n; }
+
+	// in-place transforms on n coefficients in [0, q)
+	void forward(int16_t *x) const;
+	void inverse(int16_t *x) const;
+	void pointwise(int16_t *out, const int16_t *a, const int16_t *b) const;
+
+	void forward(uint32_t *x) const;
+	void inverse(uint32_t *x) const;
+	void pointwise(uint32_t *out, const uint32_t *a, const uint32_t *b) const;
+
+private:
+	Ntt16Tables t_;
+};
+
+#endif
@@ -0,0 +1,459 @@
+/*
+ * NTT_batch.cpp
+ *
+ * Description
+ * Implementation of NttBatch, see NTT_batch.h
+ * The loops are the ones of NttPlanT<ShoupReduce, 1>::forward() / inverse(),
+ * one row of the interleaved block (width values) per butterfly input
+ * The SIMD kernels are compiled with the target attributes of cpu_target.h
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * 2026/10/17	jorjor	Intrinsics and target attributes from cpu_target.h
+ * */
+
+#include "NTT_batch.h"
+#include "NTT_reduce.h"
+#include "cpu_target.h"
+
+#include <stdexcept>
+#include <algorithm>
+
+using namespace std;
+
+NttBatch::NttBatch(int n, uint32_t q, ntt_mode mode, uint32_t root, cpu_isa isa)
+	: tab_(n, q, mode, root) {
+	isa_ = cpu_resolve_isa(isa);
+	width_ = (isa_ == ISA_AVX512) ? 16 : 8;
+
+	ShoupReduce red(q);
+	ShoupReduce::twiddle t;
+	size_t blocks = tab_.zetas.size();
+	w_.resize(blocks);
+	wp_.resize(blocks);
+	w_inv_.resize(blocks);
+	wp_inv_.resize(blocks);
+	for (size_t k = 0; k < blocks; k++) {
+		t = red.prepare(tab_.zetas[k]);
+		w_[k] = t.w;
+		wp_[k] = t.wp;
+		t = red.prepare(tab_.zetas_inv[k]);
+		w_inv_[k] = t.w;
+		wp_inv_[k] = t.wp;
+	}
+	leaf_w_.resize(tab_.leaf_w.size());
+	leaf_wp_.resize(tab_.leaf_w.size());
+	for (size_t i = 0; i < tab_.leaf_w.size(); i++) {
+		t = red.prepare(tab_.leaf_w[i]);
+		leaf_w_[i] = t.w;
+		leaf_wp_[i] = t.wp;
+	}
+	t = red.prepare(tab_.scale);
+	scale_ = t.w;
+	scale_p_ = t.wp;
+
+	qinv_ = MontgomeryReduce(q).qinv;
+	t = red.prepare((uint32_t)((1ull << 32) % q));
+	r_ = t.w;
+	r_p_ = t.wp;
+}
+
+void NttBatch::forward(uint32_t *x) const {
+	switch (isa_) {
+	case ISA_AVX512:	forward_avx512(x); break;
+	case ISA_AVX2:		forward_avx2(x); break;
+	default:			forward_scalar(x); break;
+	}
+}
+
+void NttBatch::inverse(uint32_t *x) const {
+	switch (isa_) {
+	case ISA_AVX512:	inverse_avx512(x); break;
+	case ISA_AVX2:		inverse_avx2(x); break;
+	default:			inverse_scalar(x); break;
+	}
+}
+
+void NttBatch::pointwise(uint32_t *out, const uint32_t *a, const uint32_t *b) const {
+	switch (isa_) {
+	case ISA_AVX512:	pointwise_avx512(out, a, b); break;
+	case ISA_AVX2:		pointwise_avx2(out, a, b); break;
+	default:			pointwise_scalar(out, a, b); break;
+	}
+}
+
+void NttBatch::multiply(uint32_t *out, const uint32_t *a, const uint32_t *b, int count, uint32_t *tmp) const {
+	const int n = tab_.n;
+	uint32_t *ta = tmp;
+	uint32_t *tb = tmp + (size_t)width_ * n;
+	for (int p = 0; p < count; p += width_) {
+		int m = min(width_, count - p);
+		interleave(ta, a + (size_t)p * n, m);
+		interleave(tb, b + (size_t)p * n, m);
+		forward(ta);
+		forward(tb);
+		pointwise(ta, ta, tb);
+		inverse(ta);
+		deinterleave(out + (size_t)p * n, ta, m);
+	}
+}
+
+/* transposes */
+
+static AVX2 void transpose8x8(uint32_t *dst, size_t dst_stride, const uint32_t *src, size_t src_stride) {
+	// 8 rows of 8 uint32_t, row r of dst = column r of src
+	__m256i r[8], t[8];
+	for (int i = 0; i < 8; i++) {
+		r[i] = _mm256_loadu_si256((const __m256i *)(src + i * src_stride));
+	}
+	for (int i = 0; i < 8; i += 2) {
+		t[i] = _mm256_unpacklo_epi32(r[i], r[i + 1]);
+		t[i + 1] = _mm256_unpackhi_epi32(r[i], r[i + 1]);
+	}
+	for (int i = 0; i < 8; i += 4) {
+		r[i] = _mm256_unpacklo_epi64(t[i], t[i + 2]);
+		r[i + 1] = _mm256_unpackhi_epi64(t[i], t[i + 2]);
+		r[i + 2] = _mm256_unpacklo_epi64(t[i + 1], t[i + 3]);
+		r[i + 3] = _mm256_unpackhi_epi64(t[i + 1], t[i + 3]);
+	}
+	for (int i = 0; i < 4; i++) {
+		_mm256_storeu_si256((__m256i *)(dst + i * dst_stride), _mm256_permute2x128_si256(r[i], r[i + 4], 0x20));
+		_mm256_storeu_si256((__m256i *)(dst + (i + 4) * dst_stride), _mm256_permute2x128_si256(r[i], r[i + 4], 0x31));
+	}
+}
+
+void NttBatch::interleave(uint32_t *block, const uint32_t *polys, int count) const {
+	const int n = tab_.n;
+	const int W = width_;
+	if (isa_ >= ISA_AVX2 && count == W && n % 8 == 0) {
+		// 8 x 8 tiles, 8 polynomials x 8 coefficients -> 8 rows x 8 lanes
+		for (int g = 0; g < W; g += 8) {
+			for (int c = 0; c < n; c += 8) {
+				transpose8x8(block + (size_t)c * W + g, W, polys + (size_t)g * n + c, n);
+			}
+		}
+		return;
+	}
+
+	for (int i = 0; i < n; i++) {
+		for (int lane = 0; lane < W; lane++) {
+			block[(size_t)i * W + lane] = (lane < count) ? polys[(size_t)lane * n + i] : 0;
+		}
+	}
+}
+
+void NttBatch::deinterleave(uint32_t *polys, const uint32_t *block, int count) const {
+	const int n = tab_.n;
+	const int W = width_;
+	if (isa_ >= ISA_AVX2 && count == W && n % 8 == 0) {
+		for (int g = 0; g < W; g += 8) {
+			for (int c = 0; c < n; c += 8) {
+				transpose8x8(polys + (size_t)g * n + c, n, block + (size_t)c * W + g, W);
+			}
+		}
+		return;
+	}
+
+	for (int lane = 0; lane < count; lane++) {
+		for (int i = 0; i < n; i++) {
+			polys[(size_t)lane * n + i] = block[(size_t)i * W + lane];
+		}
+	}
+}
+
+/* scalar, 8 lanes */
+
+void NttBatch::forward_scalar(uint32_t *x) const {
+	const ShoupReduce red(tab_.q);
+	const int n = tab_.n;
+	const int W = width_;
+	const uint32_t q = tab_.q;
+	int k = 1;
+	for (int len = n / 2; len >= tab_.leaf; len >>= 1) {
+		for (int s = 0; s < n; s += 2 * len) {
+			ShoupReduce::twiddle w = { w_[k], wp_[k] };
+			k++;
+			for (int j = s * W; j < (s + len) * W; j++) {
+				// BFU_CT
+				uint32_t temp1 = x[j];
+				uint32_t temp2 = csub(red.mul(x[j + len * W], w), q);
+				x[j] = csub(temp1 + temp2, q);
+				x[j + len * W] = csub(temp1 + q - temp2, q);
+			}
+		}
+	}
+}
+
+void NttBatch::inverse_scalar(uint32_t *x) const {
+	const ShoupReduce red(tab_.q);
+	const int n = tab_.n;
+	const int W = width_;
+	const uint32_t q = tab_.q;
+	for (int len = tab_.leaf; len <= n / 2; len <<= 1) {
+		int k = n / (2 * len);
+		for (int s = 0; s < n; s += 2 * len) {
+			ShoupReduce::twiddle w = { w_inv_[k], wp_inv_[k] };
+			k++;
+			for (int j = s * W; j < (s + len) * W; j++) {
+				// BFU_GS
+				uint32_t temp1 = x[j];
+				uint32_t temp2 = x[j + len * W];
+				x[j] = csub(temp1 + temp2, q);
+				x[j + len * W] = csub(red.mul(temp1 + q - temp2, w), q);
+			}
+		}
+	}
+
+	ShoupReduce::twiddle f = { scale_, scale_p_ };
+	for (int i = 0; i < n * W; i++) {
+		x[i] = csub(red.mul(x[i], f), q);
+	}
+}
+
+void NttBatch::pointwise_scalar(uint32_t *out, const uint32_t *a, const uint32_t *b) const {
+	const ShoupReduce red(tab_.q);
+	const int n = tab_.n;
+	const int W = width_;
+	const uint32_t q = tab_.q;
+	if (tab_.leaf == 1) {
+		for (int i = 0; i < n * W; i++) {
+			out[i] = red.mulmod(a[i], b[i]);
+		}
+		return;
+	}
+
+	for (int i = 0; i < n / 2; i++) {
+		ShoupReduce::twiddle w = { leaf_w_[i], leaf_wp_[i] };
+		for (int lane = 0; lane < W; lane++) {
+			int j0 = 2 * i * W + lane;
+			int j1 = j0 + W;
+			uint32_t a0 = a[j0], a1 = a[j1];
+			uint32_t b0 = b[j0], b1 = b[j1];
+
+			uint32_t c0 = red.mulmod(a0, b0) + csub(red.mul(red.mulmod(a1, b1), w), q);
+			uint32_t c1 = red.mulmod(a0, b1) + red.mulmod(a1, b0);
+			out[j0] = csub(c0, q);
+			out[j1] = csub(c1, q);
+		}
+	}
+}
+
+/* AVX2, 8 lanes */
+
+static inline AVX2 __m256i csub(__m256i a, __m256i Q) {
+	// [0, 2q) -> [0, q)
+	return _mm256_min_epu32(a, _mm256_sub_epi32(a, Q));
+}
+
+static inline AVX2 __m256i shoup(__m256i a, __m256i W, __m256i WP, __m256i Q) {
+	// a * w mod q in [0, 2q), W / WP hold the same twiddle in every lane
+	__m256i e = _mm256_srli_epi64(_mm256_mul_epu32(a, WP), 32);
+	__m256i o = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), WP);
+	__m256i qhat = _mm256_blend_epi32(e, o, 0xAA);
+	return _mm256_sub_epi32(_mm256_mullo_epi32(a, W), _mm256_mullo_epi32(qhat, Q));
+}
+
+static inline AVX2 __m256i montgomery(__m256i a, __m256i b, __m256i QINV, __m256i Q) {
+	// a * b * 2^-32 mod q in [0, 2q), for a, b in [0, q)
+	__m256i te = _mm256_mul_epu32(a, b);
+	__m256i to = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32));
+	te = _mm256_add_epi64(te, _mm256_mul_epu32(_mm256_mul_epu32(te, QINV), Q));
+	to = _mm256_add_epi64(to, _mm256_mul_epu32(_mm256_mul_epu32(to, QINV), Q));
+	return _mm256_blend_epi32(_mm256_srli_epi64(te, 32), to, 0xAA);
+}
+
+static inline AVX2 __m256i load(const uint32_t *p) {
+	return _mm256_loadu_si256((const __m256i *)p);
+}
+
+static inline AVX2 void store(uint32_t *p, __m256i a) {
+	_mm256_storeu_si256((__m256i *)p, a);
+}
+
+AVX2 void NttBatch::forward_avx2(uint32_t *x) const {
+	const __m256i Q = _mm256_set1_epi32(tab_.q);
+	const int n = tab_.n;
+	int k = 1;
+	for (int len = n / 2; len >= tab_.leaf; len >>= 1) {
+		for (int s = 0; s < n; s += 2 * len) {
+			__m256i w = _mm256_set1_epi32(w_[k]);
+			__m256i wp = _mm256_set1_epi32(wp_[k]);
+			k++;
+			for (int j = s; j < s + len; j++) {
+				// BFU_CT
+				__m256i temp1 = load(x + 8 * j);
+				__m256i temp2 = csub(shoup(load(x + 8 * (j + len)), w, wp, Q), Q);
+				store(x + 8 * j, csub(_mm256_add_epi32(temp1, temp2), Q));
+				store(x + 8 * (j + len), csub(_mm256_sub_epi32(_mm256_add_epi32(temp1, Q), temp2), Q));
+			}
+		}
+	}
+}
+
+AVX2 void NttBatch::inverse_avx2(uint32_t *x) const {
+	const __m256i Q = _mm256_set1_epi32(tab_.q);
+	const int n = tab_.n;
+	for (int len = tab_.leaf; len <= n / 2; len <<= 1) {
+		int k = n / (2 * len);
+		for (int s = 0; s < n; s += 2 * len) {
+			__m256i w = _mm256_set1_epi32(w_inv_[k]);
+			__m256i wp = _mm256_set1_epi32(wp_inv_[k]);
+			k++;
+			for (int j = s; j < s + len; j++) {
+				// BFU_GS
+				__m256i temp1 = load(x + 8 * j);
+				__m256i temp2 = load(x + 8 * (j + len));
+				store(x + 8 * j, csub(_mm256_add_epi32(temp1, temp2), Q));
+				__m256i d = _mm256_sub_epi32(_mm256_add_epi32(temp1, Q), temp2);
+				store(x + 8 * (j + len), csub(shoup(d, w, wp, Q), Q));
+			}
+		}
+	}
+
+	const __m256i f = _mm256_set1_epi32(scale_);
+	const __m256i fp = _mm256_set1_epi32(scale_p_);
+	for (int i = 0; i < n; i++) {
+		store(x + 8 * i, csub(shoup(load(x + 8 * i), f, fp, Q), Q));
+	}
+}
+
+AVX2 void NttBatch::pointwise_avx2(uint32_t *out, const uint32_t *a, const uint32_t *b) const {
+	const __m256i Q = _mm256_set1_epi32(tab_.q);
+	const __m256i QINV = _mm256_set1_epi32(qinv_);
+	const __m256i R = _mm256_set1_epi32(r_);
+	const __m256i RP = _mm256_set1_epi32(r_p_);
+	const int n = tab_.n;
+	if (tab_.leaf == 1) {
+		for (int i = 0; i < n; i++) {
+			__m256i c = montgomery(load(a + 8 * i), load(b + 8 * i), QINV, Q);
+			store(out + 8 * i, csub(shoup(c, R, RP, Q), Q));
+		}
+		return;
+	}
+
+	// pair (a0, a1) * (b0, b1) mod x^2 - w, rows 2i and 2i + 1
+	for (int i = 0; i < n / 2; i++) {
+		__m256i w = _mm256_set1_epi32(leaf_w_[i]);
+		__m256i wp = _mm256_set1_epi32(leaf_wp_[i]);
+		__m256i a0 = load(a + 16 * i), a1 = load(a + 16 * i + 8);
+		__m256i b0 = load(b + 16 * i), b1 = load(b + 16 * i + 8);
+
+		__m256i c0 = csub(montgomery(a0, b0, QINV, Q), Q);
+		__m256i t = csub(shoup(montgomery(a1, b1, QINV, Q), w, wp, Q), Q);
+		c0 = csub(_mm256_add_epi32(c0, t), Q);
+		__m256i c1 = csub(montgomery(a0, b1, QINV, Q), Q);
+		t = csub(montgomery(a1, b0, QINV, Q), Q);
+		c1 = csub(_mm256_add_epi32(c1, t), Q);
+
+		store(out + 16 * i, csub(shoup(c0, R, RP, Q), Q));
+		store(out + 16 * i + 8, csub(shoup(c1, R, RP, Q), Q));
+	}
+}
+
+/* AVX-512, 16 lanes */
+
+static inline AVX512 __m512i csub(__m512i a, __m512i Q) {
+	return _mm512_min_epu32(a, _mm512_sub_epi32(a, Q));
+}
+
+static inline AVX512 __m512i shoup(__m512i a, __m512i W, __m512i WP, __m512i Q) {
+	__m512i e = _mm512_srli_epi64(_mm512_mul_epu32(a, WP), 32);
+	__m512i o = _mm512_mul_epu32(_mm512_srli_epi64(a, 32), WP);
+	__m512i qhat = _mm512_mask_blend_epi32(0xAAAA, e, o);
+	return _mm512_sub_epi32(_mm512_mullo_epi32(a, W), _mm512_mullo_epi32(qhat, Q));
+}
+
+static inline AVX512 __m512i montgomery(__m512i a, __m512i b, __m512i QINV, __m512i Q) {
+	__m512i te = _mm512_mul_epu32(a, b);
+	__m512i to = _mm512_mul_epu32(_mm512_srli_epi64(a, 32), _mm512_srli_epi64(b, 32));
+	te = _mm512_add_epi64(te, _mm512_mul_epu32(_mm512_mul_epu32(te, QINV), Q));
+	to = _mm512_add_epi64(to, _mm512_mul_epu32(_mm512_mul_epu32(to, QINV), Q));
+	return _mm512_mask_blend_epi32(0xAAAA, _mm512_srli_epi64(te, 32), to);
+}
+
+static inline AVX512 __m512i load16(const uint32_t *p) {
+	return _mm512_loadu_si512((const void *)p);
+}
+
+static inline AVX512 void store16(uint32_t *p, __m512i a) {
+	_mm512_storeu_si512((void *)p, a);
+}
+
+AVX512 void NttBatch::forward_avx512(uint32_t *x) const {
+	const __m512i Q = _mm512_set1_epi32(tab_.q);
+	const int n = tab_.n;
+	int k = 1;
+	for (int len = n / 2; len >= tab_.leaf; len >>= 1) {
+		for (int s = 0; s < n; s += 2 * len) {
+			__m512i w = _mm512_set1_epi32(w_[k]);
+			__m512i wp = _mm512_set1_epi32(wp_[k]);
+			k++;
+			for (int j = s; j < s + len; j++) {
+				// BFU_CT
+				__m512i temp1 = load16(x + 16 * j);
+				__m512i temp2 = csub(shoup(load16(x + 16 * (j + len)), w, wp, Q), Q);
+				store16(x + 16 * j, csub(_mm512_add_epi32(temp1, temp2), Q));
+				store16(x + 16 * (j + len), csub(_mm512_sub_epi32(_mm512_add_epi32(temp1, Q), temp2), Q));
+			}
+		}
+	}
+}
+
+AVX512 void NttBatch::inverse_avx512(uint32_t *x) const {
+	const __m512i Q = _mm512_set1_epi32(tab_.q);
+	const int n = tab_.n;
+	for (int len = tab_.leaf; len <= n / 2; len <<= 1) {
+		int k = n / (2 * len);
+		for (int s = 0; s < n; s += 2 * len) {
+			__m512i w = _mm512_set1_epi32(w_inv_[k]);
+			__m512i wp = _mm512_set1_epi32(wp_inv_[k]);
+			k++;
+			for (int j = s; j < s + len; j++) {
+				// BFU_GS
+				__m512i temp1 = load16(x + 16 * j);
+				__m512i temp2 = load16(x + 16 * (j + len));
+				store16(x + 16 * j, csub(_mm512_add_epi32(temp1, temp2), Q));
+				__m512i d = _mm512_sub_epi32(_mm512_add_epi32(temp1, Q), temp2);
+				store16(x + 16 * (j + len), csub(shoup(d, w, wp, Q), Q));
+			}
+		}
+	}
+
+	const __m512i f = _mm512_set1_epi32(scale_);
+	const __m512i fp = _mm512_set1_epi32(scale_p_);
+	for (int i = 0; i < n; i++) {
+		store16(x + 16 * i, csub(shoup(load16(x + 16 * i), f, fp, Q), Q));
+	}
+}
+
+AVX512 void NttBatch::pointwise_avx512(uint32_t *out, const uint32_t *a, const uint32_t *b) const {
+	const __m512i Q = _mm512_set1_epi32(tab_.q);
+	const __m512i QINV = _mm512_set1_epi32(qinv_);
+	const __m512i R = _mm512_set1_epi32(r_);
+	const __m512i RP = _mm512_set1_epi32(r_p_);
+	const int n = tab_.n;
+	if (tab_.leaf == 1) {
+		for (int i = 0; i < n; i++) {
+			__m512i c = montgomery(load16(a + 16 * i), load16(b + 16 * i), QINV, Q);
+			store16(out + 16 * i, csub(shoup(c, R, RP, Q), Q));
+		}
+		return;
+	}
+
+	for (int i = 0; i < n / 2; i++) {
+		__m512i w = _mm512_set1_epi32(leaf_w_[i]);
+		__m512i wp = _mm512_set1_epi32(leaf_wp_[i]);
+		__m512i a0 = load16(a + 32 * i), a1 = load16(a + 32 * i + 16);
+		__m512i b0 = load16(b + 32 * i), b1 = load16(b + 32 * i + 16);
+
+		__m512i c0 = csub(montgomery(a0, b0, QINV, Q), Q);
+		__m512i t = csub(shoup(montgomery(a1, b1, QINV, Q), w, wp, Q), Q);
+		c0 = csub(_mm512_add_epi32(c0, t), Q);
+		__m512i c1 = csub(montgomery(a0, b1, QINV, Q), Q);
+		t = csub(montgomery(a1, b0, QINV, Q), Q);
+		c1 = csub(_mm512_add_epi32(c1, t), Q);
+
+		store16(out + 32 * i, csub(shoup(c0, R, RP, Q), Q));
+		store16(out + 32 * i + 16, csub(shoup(c1, R, RP, Q), Q));
+	}
+}
@@ -0,0 +1,88 @@
+/*
+ * NTT_batch.h
+ *
+ * Description
+ * Batch NTT for many independent small transforms, lane-per-polynomial layout
+ * width polynomials are interleaved, x[i * width + lane] is coefficient i of polynomial lane,
+ * so every SIMD lane owns one polynomial and every layer of NTT() / INTT() / PWM()
+ * in NTT_NWC.cpp is a plain vertical butterfly, without the shuffles of the last
+ * layers in NTT_avx2.h
+ *
+ *   AVX-512   16 polynomials, uint32_t lanes
+ *   AVX2       8 polynomials, uint32_t lanes
+ *   scalar     8 polynomials, same layout, for CPUs without AVX2
+ *
+ * The butterflies use Shoup twiddles (NTT_reduce.h) on 32-bit lanes, so every q of
+ * NttPlan is accepted (odd prime below 2^31), not only the Kyber-sized moduli
+ * of the int16 kernels. Results are bit-identical to NttPlan, polynomial by polynomial
+ *
+ * interleave() / deinterleave() convert between the natural layout (polynomials
+ * one after the other, n coefficients each) and one interleaved block
+ * multiply() does the whole batch : transpose in, NTT, PWM, INTT, transpose out
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * */
+
+#ifndef NTT_BATCH_H
+#define NTT_BATCH_H
+
+#include <stdint.h>
+#include <vector>
+
+#include "cpu_dispatch.h"
+#include "NTT_tables.h"
+
+class NttBatch {
+public:
+	// isa : ISA_AUTO or the highest ISA the batch may use
+	NttBatch(int n, uint32_t q, ntt_mode mode, uint32_t root = 0, cpu_isa isa = ISA_AUTO);
+
+	int size() const { return tab_.n; }
+	int width() const { return width_; }
+	cpu_isa isa() const { return isa_; }
+	const NttTables &tables() const { return tab_; }
+
+	// in-place transforms on one interleaved block of width polynomials, n * width values
+	void forward(uint32_t *x) const;
+	void inverse(uint32_t *x) const;
+
+	// out = a . b in the NTT domain on interleaved blocks, out may alias a or b
+	void pointwise(uint32_t *out, const uint32_t *a, const uint32_t *b) const;
+
+	// count polynomials of n coefficients (natural layout) <-> one interleaved block
+	// count <= width, the missing polynomials of the block are zero
+	void interleave(uint32_t *block, const uint32_t *polys, int count) const;
+	void deinterleave(uint32_t *polys, const uint32_t *block, int count) const;
+
+	// out[p] = a[p] * b[p] mod (x^n -/+ 1) for count polynomials in natural layout
+	// tmp must hold 2 * width * n values, out may alias a or b
+	void multiply(uint32_t *out, const uint32_t *a, const uint32_t *b, int count, uint32_t *tmp) const;
+
+private:
+	void forward_scalar(uint32_t *x) const;
+	void inverse_scalar(uint32_t *x) const;
+	void pointwise_scalar(uint32_t *out, const uint32_t *a, const uint32_t *b) const;
+	void forward_avx2(uint32_t *x) const;
+	void inverse_avx2(uint32_t *x) const;
+	void pointwise_avx2(uint32_t *out, const uint32_t *a, const uint32_t *b) const;
+	void forward_avx512(uint32_t *x) const;
+	void inverse_avx512(uint32_t *x) const;
+	void pointwise_avx512(uint32_t *out, const uint32_t *a, const uint32_t *b) const;
+
+	NttTables tab_;
+	cpu_isa isa_;
+	int width_;
+
+	// Shoup twiddles, w and floor(w * 2^32 / q)
+	std::vector<uint32_t> w_, wp_;
+	std::vector<uint32_t> w_inv_, wp_inv_;
+	std::vector<uint32_t> leaf_w_, leaf_wp_;
+	uint32_t scale_, scale_p_;
+
+	// pointwise : Montgomery product (R = 2^32) then * R mod q with a Shoup twiddle
+	uint32_t qinv_;		// -q^-1 mod 2^32
+	uint32_t r_, r_p_;	// 2^32 mod q
+};
+
+#endif
@@ -0,0 +1,211 @@
+/*
+ * NTT_constexpr.h
+ *
+ * Description
+ * Twiddle and zeta tables generated at compile time
+ * main() of NTT_NWC.cpp built wn, wn_inv and wq at every start (InverseMod() is a
+ * linear search, then a bit-reversal pass) and NTT.cpp searched its root with the
+ * brute-force findw(), here the tables are constexpr arrays of template classes,
+ * they are emitted in .rodata and nothing runs at startup
+ *
+ *   cx_powmod, cx_inverse, cx_bitrev, cx_log2     constexpr helpers (C++11, one return each)
+ *   cx_primitive_root(q)      smallest generator of (Z/q)*, q prime, the root of findw()
+ *   cx_root_of_unity(n, q)    element of order n, cx_primitive_root(q)^((q - 1) / n)
+ *
+ *   NwcConstTables<N, Q, PSI>        the tables of NTT_NWC.cpp (incomplete negacyclic NTT,
+ *                                    PSI of order N, log2(N) - 1 layers)
+ *     wn[i]       PSI^rev(i mod N/2)                     zeta of butterfly block i
+ *     wn_inv[i]   PSI^-(rev(i mod N/2) + 1)              inverse zetas
+ *     wq[i]       PSI^(2 rev(i mod N/2) + 1)             x^2 - wq[i] of pair i
+ *   CyclicConstTables<N, Q, W>       the tables of NTT.cpp, W of order N
+ *     wn[i] = W^i, wn_inv[i] = W^-i
+ *   NttConstTables<N, Q, Negacyclic> the tables of NttTables (NTT_tables.h), same values,
+ *                                    zetas, zetas_inv, leaf_w, scale, used by Poly (NTT_poly.h),
+ *                                    with the Shoup quotients floor(w * 2^32 / Q) of the zetas
+ * rev() reverses log2(N) - 1 bits, T is the element type (uint32_t, or int for the demos)
+ * The parameters are checked with static_assert, the entries can be as well
+ *
+ * The arrays are filled by a pack expansion over 0 ... N - 1, the index pack is built
+ * by halving, so its template depth is log2(N)
+ * cx_primitive_root() factors q - 1 by recursive trial division, q - 1 = c * 2^k with
+ * a small c keeps it within the default constexpr depth
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * 2026/10/17	jorjor	NttConstTables
+ * */
+
+#ifndef NTT_CONSTEXPR_H
+#define NTT_CONSTEXPR_H
+
+#include <stdint.h>
+
+constexpr uint32_t cx_mulmod(uint32_t a, uint32_t b, uint32_t m) {
+	return (uint32_t)((uint64_t)a * b % m);
+}
+
+constexpr uint32_t cx_powmod(uint32_t a, uint64_t e, uint32_t m) {
+	// a ** e % m
+	return (e == 0) ? 1 % m : cx_mulmod((e & 1) ? a : 1, cx_powmod(cx_mulmod(a, a, m), e >> 1, m), m);
+}
+
+constexpr uint32_t cx_inverse(uint32_t a, uint32_t m) {
+	// m prime
+	return cx_powmod(a, m - 2, m);
+}
+
+constexpr uint32_t cx_bitrev(uint32_t x, int bits) {
+	return (bits == 0) ? 0 : ((x & 1) << (bits - 1)) | cx_bitrev(x >> 1, bits - 1);
+}
+
+constexpr int cx_log2(uint32_t x) {
+	return (x <= 1) ? 0 : 1 + cx_log2(x / 2);
+}
+
+constexpr uint32_t cx_strip(uint32_t x, uint32_t d) {
+	// x without its factors d
+	return (x % d != 0) ? x : cx_strip(x / d, d);
+}
+
+constexpr bool cx_generates(uint32_t g, uint32_t m, uint32_t rest, uint32_t d) {
+	// g^((m - 1) / p) != 1 for every prime p of rest, trial division from d
+	return ((uint64_t)d * d > rest) ? (rest == 1 || cx_powmod(g, (m - 1) / rest, m) != 1)
+		: (rest % d == 0) ? (cx_powmod(g, (m - 1) / d, m) != 1 && cx_generates(g, m, cx_strip(rest, d), d + 1))
+		: cx_generates(g, m, rest, d + 1);
+}
+
+constexpr uint32_t cx_primitive_root(uint32_t m, uint32_t g = 2) {
+	return cx_generates(g, m, m - 1, 2) ? g : cx_primitive_root(m, g + 1);
+}
+
+constexpr uint32_t cx_root_of_unity(uint32_t n, uint32_t m) {
+	return cx_powmod(cx_primitive_root(m), (m - 1) / n, m);
+}
+
+constexpr uint32_t cx_nwc_zeta(int i, int n, uint32_t m, uint32_t psi) {
+	return cx_powmod(psi, cx_bitrev(i % (n / 2), cx_log2(n) - 1), m);
+}
+
+constexpr uint32_t cx_nwc_zeta_inv(int i, int n, uint32_t m, uint32_t psi) {
+	return cx_powmod(cx_inverse(psi, m), cx_bitrev(i % (n / 2), cx_log2(n) - 1) + 1, m);
+}
+
+constexpr uint32_t cx_nwc_leaf(int i, int n, uint32_t m, uint32_t psi) {
+	return cx_powmod(psi, 2 * cx_bitrev(i % (n / 2), cx_log2(n) - 1) + 1, m);
+}
+
+constexpr uint32_t cx_shoup(uint32_t w, uint32_t m) {
+	// floor(w * 2^32 / m), the ShoupReduce companion of w (NTT_reduce.h)
+	return (uint32_t)(((uint64_t)w << 32) / m);
+}
+
+constexpr int cx_leaf(int n, uint32_t m, bool negacyclic) {
+	// 2 : incomplete negacyclic NTT, 2n does not divide m - 1 (Kyber)
+	return (negacyclic && (m - 1) % (2 * (uint64_t)n) != 0) ? 2 : 1;
+}
+
+constexpr uint32_t cx_zeta_exp(int k, int layers, bool negacyclic) {
+	// exponent of zetas[k] in NttTables, block k = 2^d + i of layer d
+	return (k == 0) ? 0
+		: negacyclic ? cx_bitrev(k, layers)
+		: cx_bitrev(k - (1 << cx_log2(k)), cx_log2(k)) << (layers - cx_log2(k) - 1);
+}
+
+// 0, 1, ..., N - 1 as a template pack
+template <int... I> struct CxIndex {};
+
+template <class A, class B> struct CxConcat;
+
+template <int... I, int... J>
+struct CxConcat<CxIndex<I...>, CxIndex<J...> > {
+	typedef CxIndex<I..., (int)sizeof...(I) + J...> type;
+};
+
+template <int N>
+struct CxSequence {
+	typedef typename CxConcat<typename CxSequence<N / 2>::type, typename CxSequence<N - N / 2>::type>::type type;
+};
+
+template <> struct CxSequence<0> { typedef CxIndex<> type; };
+template <> struct CxSequence<1> { typedef CxIndex<0> type; };
+
+template <int N, uint32_t Q, uint32_t PSI, class T = uint32_t, class Seq = typename CxSequence<N>::type>
+struct NwcConstTables;
+
+template <int N, uint32_t Q, uint32_t PSI, class T, int... I>
+struct NwcConstTables<N, Q, PSI, T, CxIndex<I...> > {
+	static_assert(N >= 4 && (N & (N - 1)) == 0, "N must be a power of 2");
+	static_assert(Q % 2 == 1 && PSI > 0 && PSI < Q, "PSI must be in (0, Q), Q odd");
+	static_assert(cx_powmod(PSI, N / 2, Q) == Q - 1, "PSI must have order N");
+
+	static constexpr T wn[N] = { (T)cx_nwc_zeta(I, N, Q, PSI)... };
+	static constexpr T wn_inv[N] = { (T)cx_nwc_zeta_inv(I, N, Q, PSI)... };
+	static constexpr T wq[N] = { (T)cx_nwc_leaf(I, N, Q, PSI)... };
+};
+
+template <int N, uint32_t Q, uint32_t PSI, class T, int... I>
+constexpr T NwcConstTables<N, Q, PSI, T, CxIndex<I...> >::wn[N];
+template <int N, uint32_t Q, uint32_t PSI, class T, int... I>
+constexpr T NwcConstTables<N, Q, PSI, T, CxIndex<I...> >::wn_inv[N];
+template <int N, uint32_t Q, uint32_t PSI, class T, int... I>
+constexpr T NwcConstTables<N, Q, PSI, T, CxIndex<I...> >::wq[N];
+
+template <int N, uint32_t Q, uint32_t W = cx_root_of_unity(N, Q), class T = uint32_t,
+	class Seq = typename CxSequence<N>::type>
+struct CyclicConstTables;
+
+template <int N, uint32_t Q, uint32_t W, class T, int... I>
+struct CyclicConstTables<N, Q, W, T, CxIndex<I...> > {
+	static_assert(N >= 2 && (N & (N - 1)) == 0, "N must be a power of 2");
+	static_assert((Q - 1) % N == 0, "N must divide Q - 1");
+	static_assert(cx_powmod(W, N / 2, Q) == Q - 1, "W must have order N");
+
+	static constexpr T wn[N] = { (T)cx_powmod(W, I, Q)... };
+	static constexpr T wn_inv[N] = { (T)cx_powmod(cx_inverse(W, Q), I, Q)... };
+};
+
+template <int N, uint32_t Q, uint32_t W, class T, int... I>
+constexpr T CyclicConstTables<N, Q, W, T, CxIndex<I...> >::wn[N];
+template <int N, uint32_t Q, uint32_t W, class T, int... I>
+constexpr T CyclicConstTables<N, Q, W, T, CxIndex<I...> >::wn_inv[N];
+
+// zetas and zetas_inv hold N / leaf values, zetas[0] is unused
+template <int N, uint32_t Q, bool Negacyclic, class Seq = typename CxSequence<N / cx_leaf(N, Q, Negacyclic)>::type,
+	class Half = typename CxSequence<N / 2>::type>
+struct NttConstTables;
+
+template <int N, uint32_t Q, bool Negacyclic, int... K, int... I>
+struct NttConstTables<N, Q, Negacyclic, CxIndex<K...>, CxIndex<I...> > {
+	static constexpr int leaf = cx_leaf(N, Q, Negacyclic);
+	static constexpr int layers = cx_log2(N / leaf);
+	static constexpr int blocks = N / leaf;
+
+	static_assert(N >= 2 && (N & (N - 1)) == 0, "N must be a power of 2");
+	static_assert(Q % 2 == 1 && Q < (1u << 31), "Q must be an odd prime below 2^31");
+	static_assert((Q - 1) % (Negacyclic ? 2 * N / leaf : N) == 0, "Q - 1 is not divisible by the transform size");
+
+	static constexpr uint32_t root = cx_root_of_unity(Negacyclic ? 2 * N / leaf : N, Q);
+	static constexpr uint32_t scale = cx_inverse(blocks % Q, Q);
+
+	static constexpr uint32_t zetas[N / leaf] = { cx_powmod(root, cx_zeta_exp(K, layers, Negacyclic), Q)... };
+	static constexpr uint32_t zetas_inv[N / leaf] =
+		{ cx_powmod(cx_inverse(root, Q), cx_zeta_exp(K, layers, Negacyclic), Q)... };
+	static constexpr uint32_t zetas_shoup[N / leaf] = { cx_shoup(zetas[K], Q)... };
+	static constexpr uint32_t zetas_inv_shoup[N / leaf] = { cx_shoup(zetas_inv[K], Q)... };
+
+	// x^2 - leaf_w[i] for pair i, leaf = 2 only
+	static constexpr uint32_t leaf_w[N / 2] = { (uint32_t)((I & 1) ? Q - zetas[N / 4 + I / 2] : zetas[N / 4 + I / 2])... };
+};
+
+template <int N, uint32_t Q, bool Negacyclic, int... K, int... I>
+constexpr uint32_t NttConstTables<N, Q, Negacyclic, CxIndex<K...>, CxIndex<I...> >::zetas[N / leaf];
+template <int N, uint32_t Q, bool Negacyclic, int... K, int... I>
+constexpr uint32_t NttConstTables<N, Q, Negacyclic, CxIndex<K...>, CxIndex<I...> >::zetas_inv[N / leaf];
+template <int N, uint32_t Q, bool Negacyclic, int... K, int... I>
+constexpr uint32_t NttConstTables<N, Q, Negacyclic, CxIndex<K...>, CxIndex<I...> >::zetas_shoup[N / leaf];
+template <int N, uint32_t Q, bool Negacyclic, int... K, int... I>
+constexpr uint32_t NttConstTables<N, Q, Negacyclic, CxIndex<K...>, CxIndex<I...> >::zetas_inv_shoup[N / leaf];
+template <int N, uint32_t Q, bool Negacyclic, int... K, int... I>
+constexpr uint32_t NttConstTables<N, Q, Negacyclic, CxIndex<K...>, CxIndex<I...> >::leaf_w[N / 2];
+
+#endif
@@ -0,0 +1,106 @@
+/*
+ * NTT_convolve.cpp
+ *
+ * Description
+ * Implementation of NttConvolver and convolve(), see NTT_convolve.h
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * 2026/10/17	jorjor	Truncated transforms below 7/8 of the power of 2
+ * 2026/10/17	jorjor	school_multiply() of NTT_mul.h, PlanCache of plan_cache.h
+ * */
+
+#include "NTT_convolve.h"
+#include "NTT_mul.h"
+#include "NTT_params.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace std;
+
+static uint32_t check_modulus(uint32_t q) {
+	if (q < 3 || q >= (1u << 31) || !is_prime_u64(q)) {
+		throw invalid_argument("NttConvolver: q must be an odd prime below 2^31");
+	}
+	return q;
+}
+
+NttConvolver::NttConvolver(uint32_t q, cpu_isa isa) : red_(check_modulus(q)), isa_(isa), max_len_(1) {
+	fold_ = school_fold(q);
+	while (max_len_ < (1 << 30) && (q - 1) % (2 * (uint32_t)max_len_) == 0) {
+		max_len_ *= 2;
+	}
+}
+
+int NttConvolver::transform_size(int la, int lb) const {
+	if (la < 1 || lb < 1) {
+		throw invalid_argument("NttConvolver: la and lb must be at least 1");
+	}
+	if (min(la, lb) < NTT_CONVOLVE_DIRECT) {
+		return 0;
+	}
+	if ((long long)la + lb - 1 > max_len_) {
+		throw invalid_argument("NttConvolver: q - 1 is not divisible by the transform size");
+	}
+	int n = 2;
+	while (n < la + lb - 1) n <<= 1;
+	return n;
+}
+
+const NttPlan &NttConvolver::plan(int n) {
+	return plans_.get(n, [this](int m) { return new NttPlan(m, red_.q, NTT_CYCLIC, 0, isa_); });
+}
+
+const NttTft &NttConvolver::tft(int n) {
+	return tfts_.get(n, [this](int m) { return new NttTft(m, red_.q, isa_); });
+}
+
+void NttConvolver::convolve(const uint32_t *a, int la, const uint32_t *b, int lb, uint32_t *out) {
+	const int n = transform_size(la, lb);
+	const int len = la + lb - 1;
+
+	if (n == 0) {
+		// rows of the short operand over the long one
+		if (la < lb) {
+			swap(a, b);
+			swap(la, lb);
+		}
+		acc_.resize(len);
+		school_multiply(out, a, la, b, lb, red_, fold_, acc_.data());
+		return;
+	}
+
+	if ((long long)len * 8 <= (long long)n * NTT_CONVOLVE_TFT) {
+		a_.resize(2 * n);
+		tft(n).multiply(out, a, la, b, lb, a_.data());
+		return;
+	}
+
+	const NttPlan &p = plan(n);
+	const bool square = (a == b && la == lb);
+	a_.resize(n);
+	copy(a, a + la, a_.begin());
+	fill(a_.begin() + la, a_.end(), 0);
+	p.forward_padded(a_.data(), la);
+	if (square) {
+		p.pointwise(a_.data(), a_.data(), a_.data());
+	}
+	else {
+		b_.resize(n);
+		copy(b, b + lb, b_.begin());
+		fill(b_.begin() + lb, b_.end(), 0);
+		p.forward_padded(b_.data(), lb);
+		p.pointwise(a_.data(), a_.data(), b_.data());
+	}
+	p.inverse(a_.data());
+	copy(a_.begin(), a_.begin() + len, out);
+}
+
+void convolve(const uint32_t *a, int la, const uint32_t *b, int lb, uint32_t *out, uint32_t q) {
+	static thread_local unique_ptr<NttConvolver> conv;
+	if (!conv || conv->modulus() != q) {
+		conv.reset(new NttConvolver(q));
+	}
+	conv->convolve(a, la, b, lb, out);
+}
@@ -0,0 +1,84 @@
+/*
+ * NTT_convolve.h
+ *
+ * Description
+ * Linear convolution modulo q of sequences of any lengths with the NTT
+ * NttPlan::multiply() and the NTT programs compute cyclic or negacyclic products
+ * of two equal power-of-2 lengths, the caller pads both operands by hand.
+ * convolve() takes la and lb coefficients :
+ *
+ *   size     the smallest power of 2 n >= la + lb - 1, cyclic, q - 1 must be
+ *            divisible by n
+ *   padding  a and b are copied into the convolver's buffers, zero above la and lb,
+ *            the buffers and the plan of every size are kept for the next calls
+ *   zeros    NttPlan::forward_padded() : while the distance of a layer is at
+ *            least la (lb), the upper half of every block is zero and the layer
+ *            is a copy, a short operand of a long product skips most of its layers
+ *   square   a == b with la == lb runs one forward transform
+ *   TFT      when la + lb - 1 is at most NTT_CONVOLVE_TFT / 8 of n, the transforms
+ *            are truncated to la + lb - 1 points (NttTft, NTT_tft.h), so the cost
+ *            follows the length instead of jumping at every power of 2
+ *   direct   below NTT_CONVOLVE_DIRECT coefficients in the shorter operand the
+ *            sum out[k] = sum a[i] b[k - i] mod q runs directly
+ *
+ * All coefficients are uint32_t in [0, q), q must be an odd prime below 2^31
+ * An NttConvolver owns its buffers, use one per thread, the free function
+ * convolve() keeps one per thread and rebuilds it when q changes
+ * Invalid parameters throw std::invalid_argument
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * 2026/10/17	jorjor	Truncated transforms below 7/8 of the power of 2
+ * 2026/10/17	jorjor	school_multiply() of NTT_mul.h, PlanCache of plan_cache.h
+ * */
+
+#ifndef NTT_CONVOLVE_H
+#define NTT_CONVOLVE_H
+
+#include <stdint.h>
+#include <memory>
+#include <vector>
+
+#include "NTT_plan.h"
+#include "NTT_tft.h"
+#include "plan_cache.h"
+
+// shorter operand below this : direct sum
+#define NTT_CONVOLVE_DIRECT 32
+// la + lb - 1 <= n * NTT_CONVOLVE_TFT / 8 : truncated transforms
+#define NTT_CONVOLVE_TFT 7
+
+class NttConvolver {
+public:
+	explicit NttConvolver(uint32_t q, cpu_isa isa = ISA_AUTO);
+
+	uint32_t modulus() const { return red_.q; }
+
+	// largest la + lb - 1 the transforms of q can hold
+	int max_length() const { return max_len_; }
+
+	// transform size of an la x lb product, 0 when it runs directly
+	int transform_size(int la, int lb) const;
+
+	// out = a * b mod q, la + lb - 1 coefficients, out may alias a or b
+	void convolve(const uint32_t *a, int la, const uint32_t *b, int lb, uint32_t *out);
+
+private:
+	const NttPlan &plan(int n);
+	const NttTft &tft(int n);
+
+	BarrettReduce red_;
+	uint64_t fold_;		// rows of products a 64-bit accumulator below 2q can take
+	cpu_isa isa_;
+	int max_len_;
+	PlanCache<NttPlan> plans_;
+	PlanCache<NttTft> tfts_;
+	std::vector<uint32_t> a_;
+	std::vector<uint32_t> b_;
+	std::vector<uint64_t> acc_;
+};
+
+// NttConvolver::convolve() on a convolver of the calling thread
+void convolve(const uint32_t *a, int la, const uint32_t *b, int lb, uint32_t *out, uint32_t q);
+
+#endif
@@ -0,0 +1,283 @@
+/*
+ * NTT_crt.cpp
+ *
+ * Description
+ * Implementation of NttCrt and bigint_multiply(), see NTT_crt.h
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * */
+
+#include "NTT_crt.h"
+
+#include <cmath>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+
+using namespace std;
+
+// largest primes below 2^31 with q = 1 mod 2^24, largest first
+static const uint32_t crt_primes[NTT_CRT_MAX_PRIMES] = {
+	2130706433u,	// 127 * 2^24 + 1
+	2113929217u,	//  63 * 2^25 + 1
+	2013265921u,	//  15 * 2^27 + 1
+	1811939329u,	//  27 * 2^26 + 1
+	1711276033u		//  51 * 2^25 + 1
+};
+
+// smallest primitive root of every modulus, so the plans skip the root search
+static const uint32_t crt_generators[NTT_CRT_MAX_PRIMES] = { 3, 5, 31, 13, 29 };
+
+static uint32_t powmod(uint32_t a, uint32_t e, const ShoupReduce &red) {
+	uint32_t r = 1;
+	while (e != 0) {
+		if (e & 1) r = red.mulmod(r, a);
+		a = red.mulmod(a, a);
+		e >>= 1;
+	}
+	return r;
+}
+
+static int check_args(int n, int primes) {
+	if (n < 2 || (n & (n - 1)) != 0 || n > (1 << NTT_CRT_MAX_LOG)) {
+		throw invalid_argument("NttCrt: n must be a power of 2 in [2, 2^24]");
+	}
+	if (primes < 2 || primes > NTT_CRT_MAX_PRIMES) {
+		throw invalid_argument("NttCrt: primes must be in [2, 5]");
+	}
+	return n;
+}
+
+NttCrt::NttCrt(int n, int primes, cpu_isa isa) : n_(check_args(n, primes)) {
+	for (int i = 0; i < primes; i++) {
+		red_.push_back(ShoupReduce(crt_primes[i]));
+		uint32_t root = powmod(crt_generators[i], (crt_primes[i] - 1) / n, red_[i]);
+		plans_.push_back(NttPlan(n, crt_primes[i], NTT_CYCLIC, root, isa));
+	}
+
+	// q^-1 = q^(qi - 2) mod qi, qi prime
+	inv_.resize(NTT_CRT_MAX_PRIMES * NTT_CRT_MAX_PRIMES);
+	for (int i = 1; i < primes; i++) {
+		for (int j = 0; j < i; j++) {
+			uint32_t qj = crt_primes[j] % crt_primes[i];
+			inv_[i * NTT_CRT_MAX_PRIMES + j] = red_[i].prepare(powmod(qj, crt_primes[i] - 2, red_[i]));
+		}
+	}
+}
+
+double NttCrt::bits() const {
+	double b = 0;
+	for (int i = 0; i < primes(); i++) {
+		b += log2((double)prime(i));
+	}
+	return b;
+}
+
+int NttCrt::primes_for(int la, int lb, int bits_a, int bits_b) {
+	double need = bits_a + bits_b + log2((double)min(la, lb));
+	double have = 0;
+	for (int k = 1; k <= NTT_CRT_MAX_PRIMES; k++) {
+		have += log2((double)crt_primes[k - 1]);
+		if (k >= 2 && have >= need) return k;
+	}
+	throw invalid_argument("NttCrt: the product needs more than 5 moduli");
+}
+
+void NttCrt::check(int la, int lb) const {
+	if (la < 1 || lb < 1 || la + lb - 1 > n_) {
+		throw invalid_argument("NttCrt: la + lb - 1 must be in [1, n]");
+	}
+}
+
+void NttCrt::residues(uint32_t *r, const uint64_t *a, int la, const uint64_t *b, int lb, ThreadPool *pool) const {
+	const int n = n_;
+	vector<uint32_t> tmp((size_t)primes() * n);
+
+	auto run = [&](long lo, long hi, int) {
+		for (long i = lo; i < hi; i++) {
+			const ShoupReduce &red = red_[i];
+			const uint32_t q = red.q;
+			// x mod q = (hi * 2^32 + lo) mod q
+			ShoupReduce::twiddle one = red.prepare(1);
+			ShoupReduce::twiddle r32 = red.prepare((uint32_t)(((uint64_t)1 << 32) % q));
+			uint32_t *ra = r + i * n;
+			uint32_t *rb = &tmp[i * n];
+			for (int j = 0; j < n; j++) {
+				ra[j] = 0;
+				rb[j] = 0;
+			}
+			for (int j = 0; j < la; j++) {
+				uint32_t s = csub(red.mul((uint32_t)(a[j] >> 32), r32), q) + csub(red.mul((uint32_t)a[j], one), q);
+				ra[j] = csub(s, q);
+			}
+			for (int j = 0; j < lb; j++) {
+				uint32_t s = csub(red.mul((uint32_t)(b[j] >> 32), r32), q) + csub(red.mul((uint32_t)b[j], one), q);
+				rb[j] = csub(s, q);
+			}
+
+			const NttPlan &plan = plans_[i];
+			plan.forward(ra);
+			plan.forward(rb);
+			plan.pointwise(ra, ra, rb);
+			plan.inverse(ra);
+		}
+	};
+
+	if (pool) {
+		pool->parallel_for(0, primes(), 1, run);
+	}
+	else {
+		run(0, primes(), 0);
+	}
+}
+
+void NttCrt::garner(uint32_t *v, const uint32_t *r, int j) const {
+	const int k = primes();
+	v[0] = r[j];
+	for (int i = 1; i < k; i++) {
+		const ShoupReduce &red = red_[i];
+		const uint32_t q = red.q;
+		uint32_t t = r[i * n_ + j];
+		for (int l = 0; l < i; l++) {
+			// vl < ql < 2 qi
+			t = csub(t + q - csub(v[l], q), q);
+			t = csub(red.mul(t, inv_[i * NTT_CRT_MAX_PRIMES + l]), q);
+		}
+		v[i] = t;
+	}
+}
+
+template <class F>
+void NttCrt::for_coefficients(int len, ThreadPool *pool, F f) const {
+	if (pool) {
+		pool->parallel_for(0, len, 0, [&](long lo, long hi, int) { f((int)lo, (int)hi); });
+	}
+	else {
+		f(0, len);
+	}
+}
+
+void NttCrt::multiply(uint64_t *out, const uint64_t *a, int la, const uint64_t *b, int lb, ThreadPool *pool) const {
+	check(la, lb);
+	vector<uint32_t> r((size_t)primes() * n_);
+	residues(&r[0], a, la, b, lb, pool);
+
+	const int k = primes();
+	for_coefficients(la + lb - 1, pool, [&](int lo, int hi) {
+		uint32_t v[NTT_CRT_MAX_PRIMES];
+		for (int j = lo; j < hi; j++) {
+			garner(v, &r[0], j);
+			uint64_t x = v[k - 1];
+			for (int i = k - 2; i >= 0; i--) {
+				x = x * prime(i) + v[i];
+			}
+			out[j] = x;
+		}
+	});
+}
+
+void NttCrt::multiply(unsigned __int128 *out, const uint64_t *a, int la, const uint64_t *b, int lb, ThreadPool *pool) const {
+	check(la, lb);
+	vector<uint32_t> r((size_t)primes() * n_);
+	residues(&r[0], a, la, b, lb, pool);
+
+	const int k = primes();
+	for_coefficients(la + lb - 1, pool, [&](int lo, int hi) {
+		uint32_t v[NTT_CRT_MAX_PRIMES];
+		for (int j = lo; j < hi; j++) {
+			garner(v, &r[0], j);
+			unsigned __int128 x = v[k - 1];
+			for (int i = k - 2; i >= 0; i--) {
+				x = x * prime(i) + v[i];
+			}
+			out[j] = x;
+		}
+	});
+}
+
+void NttCrt::multiply_words(uint32_t *out, int words, const uint64_t *a, int la, const uint64_t *b, int lb,
+	ThreadPool *pool) const {
+	check(la, lb);
+	if (words < 1) {
+		throw invalid_argument("NttCrt: words must be positive");
+	}
+	vector<uint32_t> r((size_t)primes() * n_);
+	residues(&r[0], a, la, b, lb, pool);
+
+	const int k = primes();
+	for_coefficients(la + lb - 1, pool, [&](int lo, int hi) {
+		uint32_t v[NTT_CRT_MAX_PRIMES];
+		for (int j = lo; j < hi; j++) {
+			garner(v, &r[0], j);
+			uint32_t *x = out + (size_t)j * words;
+			x[0] = v[k - 1];
+			for (int w = 1; w < words; w++) {
+				x[w] = 0;
+			}
+			for (int i = k - 2; i >= 0; i--) {
+				// x = x * qi + vi, word by word
+				uint64_t carry = v[i];
+				for (int w = 0; w < words; w++) {
+					uint64_t t = (uint64_t)x[w] * prime(i) + carry;
+					x[w] = (uint32_t)t;
+					carry = t >> 32;
+				}
+			}
+		}
+	});
+}
+
+void bigint_multiply(uint32_t *z, const uint32_t *x, int nx, const uint32_t *y, int ny, ThreadPool *pool) {
+	if (nx < 1 || ny < 1) {
+		throw invalid_argument("bigint_multiply: empty operand");
+	}
+	const int len = nx + ny - 1;
+
+	if (min(nx, ny) < NTT_CRT_SCHOOL) {
+		for (int i = 0; i < nx + ny; i++) {
+			z[i] = 0;
+		}
+		for (int i = 0; i < nx; i++) {
+			uint64_t carry = 0;
+			for (int j = 0; j < ny; j++) {
+				uint64_t t = (uint64_t)x[i] * y[j] + z[i + j] + carry;
+				z[i + j] = (uint32_t)t;
+				carry = t >> 32;
+			}
+			z[i + ny] = (uint32_t)carry;
+		}
+		return;
+	}
+
+	int n = 2;
+	while (n < len) n <<= 1;
+	if (n > (1 << NTT_CRT_MAX_LOG)) {
+		throw invalid_argument("bigint_multiply: nx + ny - 1 must be at most 2^24 words");
+	}
+
+	// coefficients below min(nx, ny) * 2^64 <= 2^88, 3 moduli hold 92.8 bits
+	// the engines are read-only, one per size is built on first use and kept
+	static mutex lock;
+	static unique_ptr<NttCrt> engines[NTT_CRT_MAX_LOG + 1];
+	int lg = 0;
+	while ((1 << lg) < n) lg++;
+	const NttCrt *crt;
+	{
+		lock_guard<mutex> hold(lock);
+		if (!engines[lg]) engines[lg].reset(new NttCrt(n, 3));
+		crt = engines[lg].get();
+	}
+
+	vector<uint64_t> a(x, x + nx), b(y, y + ny);
+	vector<unsigned __int128> c(len);
+	crt->multiply(&c[0], &a[0], nx, &b[0], ny, pool);
+
+	unsigned __int128 carry = 0;
+	for (int i = 0; i < len; i++) {
+		carry += c[i];
+		z[i] = (uint32_t)carry;
+		carry >>= 32;
+	}
+	z[len] = (uint32_t)carry;
+}
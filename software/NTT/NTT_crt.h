@@ -0,0 +1,108 @@
+/*
+ * NTT_crt.h
+ *
+ * Description
+ * Multi-modulus NTT for exact products of polynomials with large coefficients
+ * NTT.cpp and NttPlan give the product modulo one q (3329 there), here the
+ * cyclic product is computed modulo 2 to 5 primes of 31 bits and every coefficient
+ * is rebuilt from its residues with Garner's algorithm (Chinese remainder theorem)
+ *
+ *   residues   one NttPlan per prime, the moduli are independent and run
+ *              as tasks of a ThreadPool (thread_pool.h) when one is given
+ *   Garner     v0 = r0, vi = (((ri - v0) q0^-1 - v1) q1^-1 - ...) qi-1^-1 mod qi,
+ *              the coefficient is v0 + v1 q0 + v2 q0 q1 + ..., by Horner into
+ *              64 bits, 128 bits or any number of 32-bit words (little endian),
+ *              in every case modulo the size of the result
+ * The result is exact when every coefficient of the product is below P = q0 ... qk-1 :
+ * la x lb products of coefficients below 2^b need 2b + log2(min(la, lb)) < bits(),
+ * primes_for() gives the smallest number of moduli for this bound
+ *
+ * The moduli are the largest primes below 2^31 with q = 1 mod 2^24, so n <= 2^24,
+ * 3 of them hold 32-bit coefficients (92.8 bits), 5 hold 64-bit ones (154.3 bits)
+ *
+ * bigint_multiply() multiplies two natural numbers given as 32-bit words (little endian)
+ * with 3 moduli, the product coefficients are below 2^86, then propagates the carries
+ * Below NTT_CRT_SCHOOL words in the shorter operand it runs schoolbook instead,
+ * the NttCrt of every transform size is built once and kept for the next calls
+ *
+ * The object is read-only after construction and can be shared between threads,
+ * multiply() allocates its own buffers
+ * Invalid parameters throw std::invalid_argument
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * */
+
+#ifndef NTT_CRT_H
+#define NTT_CRT_H
+
+#include <stdint.h>
+#include <vector>
+
+#include "NTT_plan.h"
+#include "thread_pool.h"
+
+// number of moduli available
+#define NTT_CRT_MAX_PRIMES 5
+
+// log2 of the largest transform, every modulus is 1 mod 2^NTT_CRT_MAX_LOG
+#define NTT_CRT_MAX_LOG 24
+
+// bigint_multiply() runs schoolbook below this many words in the shorter operand,
+// the measured crossover of bench/NTT_crt_bench.cpp
+#define NTT_CRT_SCHOOL 256
+
+class NttCrt {
+public:
+	// n : cyclic transform size, power of 2 up to 2^NTT_CRT_MAX_LOG
+	// primes : number of moduli, 2 ... NTT_CRT_MAX_PRIMES
+	NttCrt(int n, int primes, cpu_isa isa = ISA_AUTO);
+
+	int size() const { return n_; }
+	int primes() const { return (int)plans_.size(); }
+	uint32_t prime(int i) const { return plans_[i].modulus(); }
+
+	// log2(P), P the product of the moduli
+	double bits() const;
+
+	// smallest number of moduli for la x lb products of coefficients below 2^bits_a and 2^bits_b,
+	// throws when NTT_CRT_MAX_PRIMES are not enough
+	static int primes_for(int la, int lb, int bits_a, int bits_b);
+
+	// out = a * b, la + lb - 1 <= n coefficients, the linear product (cyclic when la + lb - 1 > n
+	// is rejected), out must not alias a or b, pool : moduli and Garner in parallel when given
+	void multiply(uint64_t *out, const uint64_t *a, int la, const uint64_t *b, int lb,
+		ThreadPool *pool = 0) const;
+	void multiply(unsigned __int128 *out, const uint64_t *a, int la, const uint64_t *b, int lb,
+		ThreadPool *pool = 0) const;
+
+	// the same with words 32-bit words per coefficient, out holds (la + lb - 1) * words words
+	void multiply_words(uint32_t *out, int words, const uint64_t *a, int la, const uint64_t *b, int lb,
+		ThreadPool *pool = 0) const;
+
+private:
+	// r[i * n + j] = coefficient j of the product modulo prime i, r holds primes() * n values
+	void residues(uint32_t *r, const uint64_t *a, int la, const uint64_t *b, int lb, ThreadPool *pool) const;
+
+	// mixed-radix digits v[0 ... primes() - 1] of coefficient j
+	void garner(uint32_t *v, const uint32_t *r, int j) const;
+
+	// f(lo, hi) on the coefficients [0, len), on the pool when given
+	template <class F>
+	void for_coefficients(int len, ThreadPool *pool, F f) const;
+
+	void check(int la, int lb) const;
+
+	int n_;
+	std::vector<NttPlan> plans_;
+	std::vector<ShoupReduce> red_;
+
+	// inv_[i * NTT_CRT_MAX_PRIMES + j] = qj^-1 mod qi for j < i, Shoup form of red_[i]
+	std::vector<ShoupReduce::twiddle> inv_;
+};
+
+// z = x * y for nx and ny 32-bit words, z holds nx + ny words, z must not alias x or y
+void bigint_multiply(uint32_t *z, const uint32_t *x, int nx, const uint32_t *y, int ny,
+	ThreadPool *pool = 0);
+
+#endif
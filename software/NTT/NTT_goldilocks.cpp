@@ -0,0 +1,145 @@
+/*
+ * NTT_goldilocks.cpp
+ *
+ * Description
+ * Implementation of NttGoldilocks, see NTT_goldilocks.h
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * */
+
+#include "NTT_goldilocks.h"
+
+#include <stdexcept>
+
+using namespace std;
+
+uint64_t gl_pow(uint64_t a, uint64_t e) {
+	uint64_t r = 1;
+	while (e != 0) {
+		if (e & 1) r = gl_mul(r, a);
+		a = gl_mul(a, a);
+		e >>= 1;
+	}
+	return r;
+}
+
+NttGoldilocks::NttGoldilocks(size_t n, ntt_mode mode) : n_(n), log2n_(0), mode_(mode) {
+	const size_t max = (mode == NTT_CYCLIC) ? ((size_t)1 << 32) : ((size_t)1 << 31);
+	if (n < 1 || (n & (n - 1)) != 0 || n > max) {
+		throw invalid_argument("NttGoldilocks: n must be a power of 2 up to 2^32 (cyclic) or 2^31 (negacyclic)");
+	}
+	while (((size_t)1 << log2n_) < n) log2n_++;
+
+	// w of order n, psi of order 2n with psi^2 = w
+	size_t order = (mode == NTT_CYCLIC) ? n : 2 * n;
+	root_ = gl_pow(GOLDILOCKS_GENERATOR, (GOLDILOCKS_P - 1) / order);
+	uint64_t w = (mode == NTT_CYCLIC) ? root_ : gl_mul(root_, root_);
+	scale_ = gl_pow(n, GOLDILOCKS_P - 2);
+
+	// W(j, 2 half) = w^(j n / (2 half)), the stage half = n / 2 holds every power
+	tw_.assign(n, 0);
+	tw_inv_.assign(n, 0);
+	if (n >= 2) {
+		uint64_t w_inv = gl_pow(w, GOLDILOCKS_P - 2);
+		size_t h = n / 2;
+		tw_[h] = 1;
+		tw_inv_[h] = 1;
+		for (size_t j = 1; j < h; j++) {
+			tw_[h + j] = gl_mul(tw_[h + j - 1], w);
+			tw_inv_[h + j] = gl_mul(tw_inv_[h + j - 1], w_inv);
+		}
+		for (size_t half = h / 2; half >= 1; half /= 2) {
+			for (size_t j = 0; j < half; j++) {
+				tw_[half + j] = tw_[2 * half + 2 * j];
+				tw_inv_[half + j] = tw_inv_[2 * half + 2 * j];
+			}
+		}
+	}
+
+	if (mode == NTT_NEGACYCLIC) {
+		uint64_t psi_inv = gl_pow(root_, GOLDILOCKS_P - 2);
+		twist_.assign(n, 0);
+		untwist_.assign(n, 0);
+		twist_[0] = 1;
+		untwist_[0] = scale_;
+		for (size_t j = 1; j < n; j++) {
+			twist_[j] = gl_mul(twist_[j - 1], root_);
+			untwist_[j] = gl_mul(untwist_[j - 1], psi_inv);
+		}
+	}
+}
+
+void NttGoldilocks::forward(uint64_t *x) const {
+	const size_t n = n_;
+	if (mode_ == NTT_NEGACYCLIC) {
+		for (size_t j = 0; j < n; j++) {
+			x[j] = gl_mul(x[j], twist_[j]);
+		}
+	}
+
+	for (size_t half = n / 2; half >= 1; half /= 2) {
+		const uint64_t *w = &tw_[half];
+		for (size_t start = 0; start < n; start += 2 * half) {
+			uint64_t *a = x + start;
+			uint64_t *b = a + half;
+			for (size_t j = 0; j < half; j++) {
+				// BFU_GS
+				uint64_t u = a[j], v = b[j];
+				a[j] = gl_add(u, v);
+				b[j] = gl_mul(gl_sub(u, v), w[j]);
+			}
+		}
+	}
+}
+
+void NttGoldilocks::inverse(uint64_t *x) const {
+	const size_t n = n_;
+	for (size_t half = 1; half < n; half *= 2) {
+		const uint64_t *w = &tw_inv_[half];
+		for (size_t start = 0; start < n; start += 2 * half) {
+			uint64_t *a = x + start;
+			uint64_t *b = a + half;
+			for (size_t j = 0; j < half; j++) {
+				// BFU_CT
+				uint64_t u = a[j], v = gl_mul(b[j], w[j]);
+				a[j] = gl_add(u, v);
+				b[j] = gl_sub(u, v);
+			}
+		}
+	}
+
+	if (mode_ == NTT_NEGACYCLIC) {
+		for (size_t j = 0; j < n; j++) {
+			x[j] = gl_mul(x[j], untwist_[j]);
+		}
+	}
+	else {
+		for (size_t j = 0; j < n; j++) {
+			x[j] = gl_mul(x[j], scale_);
+		}
+	}
+}
+
+void NttGoldilocks::pointwise(uint64_t *out, const uint64_t *a, const uint64_t *b) const {
+	for (size_t j = 0; j < n_; j++) {
+		out[j] = gl_mul(a[j], b[j]);
+	}
+}
+
+void NttGoldilocks::multiply(uint64_t *out, const uint64_t *a, const uint64_t *b, uint64_t *tmp) const {
+	const size_t n = n_;
+	for (size_t j = 0; j < n; j++) {
+		tmp[j] = b[j];
+	}
+	if (out != a) {
+		for (size_t j = 0; j < n; j++) {
+			out[j] = a[j];
+		}
+	}
+
+	forward(out);
+	forward(tmp);
+	pointwise(out, out, tmp);
+	inverse(out);
+}
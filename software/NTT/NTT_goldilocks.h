@@ -0,0 +1,130 @@
+/*
+ * NTT_goldilocks.h
+ *
+ * Description
+ * NTT over the Goldilocks prime p = 2^64 - 2^32 + 1, 64-bit coefficients
+ * NTT.cpp multiplies int values and overflows wn * temp2 once q passes 2^15,
+ * NttPlan stops below 2^31, so large coefficients needed several primes (NTT_crt.h)
+ * Here one transform holds them : p - 1 = 2^32 * 3 * 5 * 17 * 257 * 65537,
+ * every power of 2 up to 2^32 divides p - 1 and 7 generates the multiplicative group
+ *
+ * Reduction without division and without Montgomery form, 2^64 = 2^32 - 1 and
+ * 2^96 = -1 mod p, so x = hh * 2^96 + hl * 2^64 + lo reduces to
+ * lo - hh + hl * (2^32 - 1), two 64-bit adds with their carries folded back
+ * Every value stays in [0, p)
+ *
+ * Same arrangement as FftPlan (FFT_plan.h)
+ *   forward : DIF (Gentleman-Sande), natural order in, bit-reversed order out
+ *   inverse : DIT (Cooley-Tukey), bit-reversed order in, natural order out, scaled by n^-1
+ *   cyclic       X[k] = a(w^k), w of order n, n <= 2^32
+ *   negacyclic   X[k] = a(psi^(2k + 1)), psi of order 2n, the input is multiplied
+ *                by psi^j first, the output of inverse() by psi^-j, n <= 2^31
+ * bitrev_permute() (bitrev.h) gives the natural order when it is needed
+ *
+ * The plan is read-only after construction and can be shared between threads
+ * Invalid parameters throw std::invalid_argument
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * */
+
+#ifndef NTT_GOLDILOCKS_H
+#define NTT_GOLDILOCKS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+
+#include "NTT_tables.h"
+
+#define GOLDILOCKS_P 0xffffffff00000001ull
+
+// 2^64 mod p
+#define GOLDILOCKS_EPS 0xffffffffull
+
+// generator of the multiplicative group
+#define GOLDILOCKS_GENERATOR 7
+
+// the carries and the final p are masks, random data makes branches mispredict
+
+static inline uint64_t gl_canonical(uint64_t s) {
+	// s in [0, 2^64) -> [0, p), s + 2^32 - 1 carries exactly when s >= p
+	uint64_t t = s + GOLDILOCKS_EPS;
+	return (t < s) ? t : s;
+}
+
+static inline uint64_t gl_add(uint64_t a, uint64_t b) {
+	// a, b in [0, p), a carry out of 2^64 is worth 2^32 - 1
+	uint64_t s = a + b;
+	s += GOLDILOCKS_EPS & (0 - (uint64_t)(s < a));
+	return gl_canonical(s);
+}
+
+static inline uint64_t gl_sub(uint64_t a, uint64_t b) {
+	// a, b in [0, p), a borrow is the same as adding p
+	uint64_t d = a - b;
+	return d - (GOLDILOCKS_EPS & (0 - (uint64_t)(a < b)));
+}
+
+static inline uint64_t gl_reduce(unsigned __int128 x) {
+	// x = hh * 2^96 + hl * 2^64 + lo = lo - hh + hl * (2^32 - 1) mod p
+	uint64_t lo = (uint64_t)x;
+	uint64_t hi = (uint64_t)(x >> 64);
+	uint64_t hh = hi >> 32;
+	uint64_t hl = hi & GOLDILOCKS_EPS;
+
+	uint64_t t = lo - hh;
+	t -= GOLDILOCKS_EPS & (0 - (uint64_t)(lo < hh));
+	uint64_t m = hl * GOLDILOCKS_EPS;
+	uint64_t s = t + m;
+	s += GOLDILOCKS_EPS & (0 - (uint64_t)(s < t));
+	return gl_canonical(s);
+}
+
+static inline uint64_t gl_mul(uint64_t a, uint64_t b) {
+	return gl_reduce((unsigned __int128)a * b);
+}
+
+// a^e mod p
+uint64_t gl_pow(uint64_t a, uint64_t e);
+
+class NttGoldilocks {
+public:
+	// n : power of 2, up to 2^32 (cyclic) or 2^31 (negacyclic)
+	explicit NttGoldilocks(size_t n, ntt_mode mode = NTT_CYCLIC);
+
+	size_t size() const { return n_; }
+	int log2n() const { return log2n_; }
+	ntt_mode mode() const { return mode_; }
+
+	// w of order n (cyclic) or psi of order 2n (negacyclic)
+	uint64_t root() const { return root_; }
+
+	// in-place transforms on n values in [0, p)
+	void forward(uint64_t *x) const;
+	void inverse(uint64_t *x) const;
+
+	// out = a . b in the NTT domain, out may alias a or b
+	void pointwise(uint64_t *out, const uint64_t *a, const uint64_t *b) const;
+
+	// out = a * b mod (x^n -/+ 1) mod p, tmp must hold n values
+	// out may alias a, tmp must not alias anything
+	void multiply(uint64_t *out, const uint64_t *a, const uint64_t *b, uint64_t *tmp) const;
+
+private:
+	size_t n_;
+	int log2n_;
+	ntt_mode mode_;
+	uint64_t root_;
+	uint64_t scale_;	// n^-1
+
+	// stage with distance half at [half, 2 * half), W(j, 2 half) and its inverse
+	std::vector<uint64_t> tw_;
+	std::vector<uint64_t> tw_inv_;
+
+	// negacyclic only, psi^j and psi^-j n^-1
+	std::vector<uint64_t> twist_;
+	std::vector<uint64_t> untwist_;
+};
+
+#endif
@@ -0,0 +1,399 @@
+/*
+ * NTT_mul.cpp
+ *
+ * Description
+ * Implementation of PolyMul, see NTT_mul.h
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * 2026/10/17	jorjor	school_multiply() shared with NTT_convolve.cpp
+ * */
+
+#include "NTT_mul.h"
+#include "NTT_params.h"
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <stdexcept>
+
+using namespace std;
+
+const char *mul_algo_name(mul_algo algo) {
+	switch (algo) {
+	case MUL_SCHOOL:
+		return "school";
+	case MUL_KARATSUBA:
+		return "karatsuba";
+	case MUL_TOOM3:
+		return "toom3";
+	case MUL_NTT:
+		return "ntt";
+	}
+	return "unknown";
+}
+
+static uint32_t check_modulus(uint32_t q) {
+	if (q < 5 || q >= (1u << 31) || !is_prime_u64(q)) {
+		throw invalid_argument("PolyMul: q must be a prime in [5, 2^31)");
+	}
+	return q;
+}
+
+static inline uint32_t add_mod(uint32_t a, uint32_t b, uint32_t q) {
+	return csub(a + b, q);
+}
+
+static inline uint32_t sub_mod(uint32_t a, uint32_t b, uint32_t q) {
+	return csub(a + q - b, q);
+}
+
+uint64_t school_fold(uint32_t q) {
+	return (~(uint64_t)0 - 2 * (uint64_t)q) / ((uint64_t)(q - 1) * (q - 1));
+}
+
+void school_multiply(uint32_t *out, const uint32_t *a, int la, const uint32_t *b, int lb,
+	const BarrettReduce &red, uint64_t fold, uint64_t *acc) {
+	// rows of b over a, the rows since the last reduction touch
+	// acc[last, j + la) and are reduced every fold rows
+	const int len = la + lb - 1;
+	for (int k = 0; k < len; k++) {
+		acc[k] = 0;
+	}
+	int last = 0;
+	for (int j = 0; j < lb; j++) {
+		const uint64_t bj = b[j];
+		uint64_t *o = &acc[j];
+		for (int i = 0; i < la; i++) {
+			o[i] += a[i] * bj;
+		}
+		if ((uint64_t)(j - last + 1) == fold || j == lb - 1) {
+			for (int k = last; k < j + la; k++) {
+				acc[k] = red.reduce(acc[k]);
+			}
+			last = j + 1;
+		}
+	}
+	for (int k = 0; k < len; k++) {
+		out[k] = csub((uint32_t)acc[k], red.q);
+	}
+}
+
+static int transform_log(int n) {
+	// log2 of the power of 2 above 2n - 1
+	int k = 1;
+	while ((1 << k) < 2 * n - 1) k++;
+	return k;
+}
+
+PolyMul::PolyMul(uint32_t q, int max_n, cpu_isa isa)
+	: red_(check_modulus(q)), karatsuba_(POLYMUL_KARATSUBA), toom3_(POLYMUL_TOOM3), ntt_(POLYMUL_NTT),
+	  max_n_(max_n) {
+	if (max_n < 1) {
+		throw invalid_argument("PolyMul: max_n must be at least 1");
+	}
+
+	fold_ = school_fold(q);
+	inv2_ = (q + 1) / 2;
+	inv3_ = (uint32_t)inverse_mod(3, q);
+
+	// cyclic plans up to the size of a max_n product, as long as q - 1 has the roots
+	int top = transform_log(max_n);
+	for (int k = 1; k <= top && (q - 1) % (1u << k) == 0; k++) {
+		plans_.push_back(NttPlan(1 << k, q, NTT_CYCLIC, 0, isa));
+	}
+}
+
+void PolyMul::set_thresholds(int karatsuba, int toom3, int ntt) {
+	if (karatsuba < 2 || karatsuba > POLYMUL_SCHOOL_MAX + 1 || toom3 < 3 || ntt < 1) {
+		throw invalid_argument("PolyMul: thresholds must be in [2, 257] (karatsuba), at least 3 (toom3) and 1 (ntt)");
+	}
+	karatsuba_ = karatsuba;
+	toom3_ = toom3;
+	ntt_ = ntt;
+}
+
+bool PolyMul::has_ntt(int n) const {
+	return n >= 1 && transform_log(n) <= (int)plans_.size();
+}
+
+mul_algo PolyMul::algorithm(int n) const {
+	if (n < karatsuba_ && n <= POLYMUL_SCHOOL_MAX) return MUL_SCHOOL;
+	if (n >= ntt_ && has_ntt(n)) return MUL_NTT;
+	if (n < toom3_) return MUL_KARATSUBA;
+	return MUL_TOOM3;
+}
+
+size_t PolyMul::scratch_of(mul_algo algo, int n) const {
+	switch (algo) {
+	case MUL_SCHOOL:
+		return 0;
+	case MUL_KARATSUBA: {
+		// a1, b1 padded to h, a0 + a1, b0 + b1, z1 and z2
+		int h = (n + 1) / 2;
+		return 8 * (size_t)h + scratch_of(algorithm(h), h);
+	}
+	case MUL_TOOM3: {
+		// a and b padded to 3k, 3 pairs of evaluations, 5 products of 2k
+		int k = (n + 2) / 3;
+		return 22 * (size_t)k + scratch_of(algorithm(k), k);
+	}
+	case MUL_NTT:
+		return 2 * ((size_t)1 << transform_log(n));
+	}
+	return 0;
+}
+
+size_t PolyMul::scratch_size(int n) const {
+	if (n < 1) return 0;
+	size_t s = 0;
+	if (n >= 2) s = max(s, scratch_of(MUL_KARATSUBA, n));
+	if (n >= 3) s = max(s, scratch_of(MUL_TOOM3, n));
+	if (has_ntt(n)) s = max(s, scratch_of(MUL_NTT, n));
+	// the linear product of multiply_mod()
+	return s + 2 * (size_t)n;
+}
+
+void PolyMul::run(mul_algo algo, uint32_t *out, const uint32_t *a, const uint32_t *b, int n, uint32_t *tmp) const {
+	switch (algo) {
+	case MUL_SCHOOL:
+		school(out, a, b, n);
+		break;
+	case MUL_KARATSUBA:
+		karatsuba(out, a, b, n, tmp);
+		break;
+	case MUL_TOOM3:
+		toom3(out, a, b, n, tmp);
+		break;
+	case MUL_NTT:
+		ntt(out, a, b, n, tmp);
+		break;
+	}
+}
+
+void PolyMul::dispatch(uint32_t *out, const uint32_t *a, const uint32_t *b, int n, uint32_t *tmp) const {
+	run(algorithm(n), out, a, b, n, tmp);
+}
+
+void PolyMul::multiply(uint32_t *out, const uint32_t *a, const uint32_t *b, int n, uint32_t *tmp) const {
+	multiply_with(algorithm(max(n, 1)), out, a, b, n, tmp);
+}
+
+void PolyMul::multiply_with(mul_algo algo, uint32_t *out, const uint32_t *a, const uint32_t *b, int n,
+	uint32_t *tmp) const {
+	if (n < 1) {
+		throw invalid_argument("PolyMul: n must be at least 1");
+	}
+	if ((algo == MUL_SCHOOL && n > POLYMUL_SCHOOL_MAX) || (algo == MUL_KARATSUBA && n < 2) || (algo == MUL_TOOM3 && n < 3) || (algo == MUL_NTT && !has_ntt(n))) {
+		throw invalid_argument("PolyMul: the algorithm does not apply to this size");
+	}
+	vector<uint32_t> own;
+	if (tmp == NULL) {
+		own.resize(scratch_size(n));
+		tmp = own.data();
+	}
+	run(algo, out, a, b, n, tmp);
+}
+
+void PolyMul::multiply_mod(uint32_t *out, const uint32_t *a, const uint32_t *b, int n, ntt_mode mode,
+	uint32_t *tmp) const {
+	if (n < 1) {
+		throw invalid_argument("PolyMul: n must be at least 1");
+	}
+	vector<uint32_t> own;
+	if (tmp == NULL) {
+		own.resize(scratch_size(n));
+		tmp = own.data();
+	}
+	// x^n = 1 or -1, the linear product sits at the top of tmp
+	uint32_t *c = tmp + scratch_size(n) - 2 * n;
+	dispatch(c, a, b, n, tmp);
+	const uint32_t q = red_.q;
+	out[n - 1] = c[n - 1];
+	for (int i = 0; i < n - 1; i++) {
+		out[i] = (mode == NTT_CYCLIC) ? add_mod(c[i], c[i + n], q) : sub_mod(c[i], c[i + n], q);
+	}
+}
+
+void PolyMul::school(uint32_t *out, const uint32_t *a, const uint32_t *b, int n) const {
+	uint64_t acc[2 * POLYMUL_SCHOOL_MAX];
+	school_multiply(out, a, n, b, n, red_, fold_, acc);
+}
+
+void PolyMul::karatsuba(uint32_t *out, const uint32_t *a, const uint32_t *b, int n, uint32_t *tmp) const {
+	// a b = z0 + (z1 - z0 - z2) x^h + z2 x^2h, z1 = (a0 + a1)(b0 + b1)
+	const uint32_t q = red_.q;
+	const int h = (n + 1) / 2;
+	const int l = n - h;
+	const int len = 2 * h - 1;
+	uint32_t *a1 = tmp;
+	uint32_t *b1 = a1 + h;
+	uint32_t *sa = b1 + h;
+	uint32_t *sb = sa + h;
+	uint32_t *z1 = sb + h;
+	uint32_t *z2 = z1 + 2 * h;
+	uint32_t *sub = z2 + 2 * h;
+
+	for (int i = 0; i < h; i++) {
+		a1[i] = (i < l) ? a[h + i] : 0;
+		b1[i] = (i < l) ? b[h + i] : 0;
+		sa[i] = add_mod(a[i], a1[i], q);
+		sb[i] = add_mod(b[i], b1[i], q);
+	}
+
+	// z0 straight into out, the top of out is filled from z2
+	dispatch(out, a, b, h, sub);
+	dispatch(z2, a1, b1, h, sub);
+	dispatch(z1, sa, sb, h, sub);
+
+	for (int i = 0; i < len; i++) {
+		z1[i] = sub_mod(z1[i], add_mod(out[i], z2[i], q), q);
+	}
+	out[len] = 0;
+	for (int i = 0; i < 2 * l - 1; i++) {
+		out[2 * h + i] = z2[i];
+	}
+	for (int i = 0; i < len; i++) {
+		out[h + i] = add_mod(out[h + i], z1[i], q);
+	}
+}
+
+void PolyMul::toom3(uint32_t *out, const uint32_t *a, const uint32_t *b, int n, uint32_t *tmp) const {
+	// a(x) = a0 + a1 x^k + a2 x^2k, the 5 products r(0), r(1), r(-1), r(-2), r(inf)
+	// give the 5 parts of a b by Bodrato's interpolation sequence
+	const uint32_t q = red_.q;
+	const int k = (n + 2) / 3;
+	const int len = 2 * k - 1;
+	uint32_t *pa = tmp;
+	uint32_t *pb = pa + 3 * k;
+	uint32_t *ea = pb + 3 * k;
+	uint32_t *eb = ea + 3 * k;
+	uint32_t *r = eb + 3 * k;	// r0, r1, rm1, rm2, rinf, 2k each
+	uint32_t *sub = r + 10 * k;
+
+	for (int i = 0; i < 3 * k; i++) {
+		pa[i] = (i < n) ? a[i] : 0;
+		pb[i] = (i < n) ? b[i] : 0;
+	}
+
+	const uint32_t *p[2] = { pa, pb };
+	uint32_t *e[2] = { ea, eb };
+	for (int t = 0; t < 2; t++) {
+		const uint32_t *x0 = p[t], *x1 = p[t] + k, *x2 = p[t] + 2 * k;
+		uint32_t *e1 = e[t], *em1 = e[t] + k, *em2 = e[t] + 2 * k;
+		for (int i = 0; i < k; i++) {
+			uint32_t s = add_mod(x0[i], x2[i], q);
+			e1[i] = add_mod(s, x1[i], q);
+			em1[i] = sub_mod(s, x1[i], q);
+			// p(-2) = 2 (p(-1) + x2) - x0
+			uint32_t d = add_mod(em1[i], x2[i], q);
+			em2[i] = sub_mod(add_mod(d, d, q), x0[i], q);
+		}
+	}
+
+	uint32_t *r0 = r, *r1 = r + 2 * k, *rm1 = r + 4 * k, *rm2 = r + 6 * k, *rinf = r + 8 * k;
+	dispatch(r0, pa, pb, k, sub);
+	dispatch(r1, ea, eb, k, sub);
+	dispatch(rm1, ea + k, eb + k, k, sub);
+	dispatch(rm2, ea + 2 * k, eb + 2 * k, k, sub);
+	dispatch(rinf, pa + 2 * k, pb + 2 * k, k, sub);
+
+	// r3 = (r(-2) - r(1)) / 3, r1 = (r(1) - r(-1)) / 2, r2 = r(-1) - r(0)
+	// r3 = (r2 - r3) / 2 + 2 r(inf), r2 = r2 + r1 - r(inf), r1 = r1 - r3
+	for (int i = 0; i < len; i++) {
+		uint32_t t3 = red_.mulmod(sub_mod(rm2[i], r1[i], q), inv3_);
+		uint32_t t1 = red_.mulmod(sub_mod(r1[i], rm1[i], q), inv2_);
+		uint32_t t2 = sub_mod(rm1[i], r0[i], q);
+		t3 = add_mod(red_.mulmod(sub_mod(t2, t3, q), inv2_), add_mod(rinf[i], rinf[i], q), q);
+		t2 = sub_mod(add_mod(t2, t1, q), rinf[i], q);
+		t1 = sub_mod(t1, t3, q);
+		r1[i] = t1;
+		rm1[i] = t2;
+		rm2[i] = t3;
+	}
+
+	const int total = 2 * n - 1;
+	for (int i = 0; i < total; i++) {
+		out[i] = 0;
+	}
+	const uint32_t *parts[5] = { r0, r1, rm1, rm2, rinf };
+	for (int j = 0; j < 5; j++) {
+		int end = min(len, total - j * k);
+		for (int i = 0; i < end; i++) {
+			out[j * k + i] = add_mod(out[j * k + i], parts[j][i], q);
+		}
+	}
+}
+
+void PolyMul::ntt(uint32_t *out, const uint32_t *a, const uint32_t *b, int n, uint32_t *tmp) const {
+	const int lg = transform_log(n);
+	const int size = 1 << lg;
+	const NttPlan &plan = plans_[lg - 1];
+	uint32_t *x = tmp;
+	uint32_t *y = tmp + size;
+	for (int i = 0; i < size; i++) {
+		x[i] = (i < n) ? a[i] : 0;
+		y[i] = (i < n) ? b[i] : 0;
+	}
+	plan.forward(x);
+	plan.forward(y);
+	plan.pointwise(x, x, y);
+	plan.inverse(x);
+	for (int i = 0; i < 2 * n - 1; i++) {
+		out[i] = x[i];
+	}
+}
+
+// best of 3 rounds, ns per product
+static double time_product(const PolyMul &pm, mul_algo algo, const uint32_t *a, const uint32_t *b, int n,
+	uint32_t *out, uint32_t *tmp) {
+	int iters = max(4, (1 << 18) / (n * n));
+	double ns = 0;
+	for (int round = 0; round < 3; round++) {
+		chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+		for (int i = 0; i < iters; i++) {
+			pm.multiply_with(algo, out, a, b, n, tmp);
+		}
+		chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+		double t = chrono::duration<double, nano>(t1 - t0).count() / iters;
+		if (round == 0 || t < ns) ns = t;
+	}
+	return ns;
+}
+
+void PolyMul::tune() {
+	// sizes 4, 6, 8, 12, 16, 24, ..., one level of the new kernel over the
+	// current dispatch, a threshold is the first of two sizes in a row where
+	// the new kernel wins, so one noisy sample does not move it
+	const int limit = 4096;
+	vector<int> sizes;
+	for (int s = 4; s <= limit; s *= 2) {
+		sizes.push_back(s);
+		sizes.push_back(s + s / 2);
+	}
+
+	const uint32_t q = red_.q;
+	vector<uint32_t> a(limit), b(limit), out(2 * limit);
+	for (int i = 0; i < limit; i++) {
+		a[i] = (uint32_t)((i * 2654435761u + 12345u) % q);
+		b[i] = (uint32_t)((i * 40503u + 977u) % q);
+	}
+	vector<uint32_t> tmp;
+
+	mul_algo order[3] = { MUL_KARATSUBA, MUL_TOOM3, MUL_NTT };
+	int *threshold[3] = { &karatsuba_, &toom3_, &ntt_ };
+	karatsuba_ = toom3_ = ntt_ = INT_MAX;
+	for (int t = 0; t < 3; t++) {
+		int wins = 0;
+		for (size_t s = 0; s < sizes.size() && *threshold[t] == INT_MAX; s++) {
+			int n = sizes[s];
+			if ((order[t] == MUL_KARATSUBA && n > POLYMUL_SCHOOL_MAX) || (order[t] == MUL_NTT && !has_ntt(n))) break;
+			tmp.resize(max(tmp.size(), scratch_size(n)));
+			double t_old = time_product(*this, algorithm(n), a.data(), b.data(), n, out.data(), tmp.data());
+			double t_new = time_product(*this, order[t], a.data(), b.data(), n, out.data(), tmp.data());
+			wins = (t_new < t_old) ? wins + 1 : 0;
+			if (wins == 2) *threshold[t] = sizes[s - 1];
+		}
+	}
+	karatsuba_ = min(karatsuba_, POLYMUL_SCHOOL_MAX + 1);
+}
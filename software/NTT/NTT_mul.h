@@ -0,0 +1,138 @@
+/*
+ * NTT_mul.h
+ *
+ * Description
+ * Polynomial multiplication modulo q with a dispatcher over four algorithms
+ * NttPlan::multiply() always pays two forward transforms and one inverse of the
+ * padded size, for the small products most callers have (n <= 64) a quadratic or
+ * sub-quadratic kernel is faster :
+ *
+ *   MUL_SCHOOL      O(n^2), row by row into 64-bit accumulators on the stack,
+ *                   reduced once every few rows, n <= POLYMUL_SCHOOL_MAX
+ *   MUL_KARATSUBA   3 half-size products, a(x) = a0 + a1 x^h
+ *   MUL_TOOM3       5 third-size products, evaluation at 0, 1, -1, -2, inf and
+ *                   Bodrato's interpolation (divisions by 2 and 3 modulo q)
+ *   MUL_NTT         cyclic NttPlan of the power of 2 above 2n - 1
+ *
+ * algorithm(n) picks the kernel of one product of n coefficients per operand :
+ * schoolbook below the Karatsuba threshold, the NTT from the NTT threshold on when
+ * q - 1 is divisible by the transform size, Karatsuba below the Toom-3 threshold and
+ * Toom-3 above it. Karatsuba and Toom-3 call the dispatcher again on their
+ * sub-products, so a large product splits down to NTT-sized, Toom-3 or Karatsuba
+ * pieces and ends in schoolbook. A q without large power-of-2 roots (Kyber) runs
+ * its large products through Karatsuba / Toom-3 down to the largest NTT it has
+ *
+ * The default thresholds POLYMUL_* were measured with bench/NTT_mul_bench.cpp on
+ * 23- to 31-bit primes, tune() measures them again on the running machine and q
+ * (about 0.1 s), e.g. the NTT wins from n = 16 on when the plans run the int16
+ * AVX-512 kernels of a Kyber-sized q
+ *
+ * school_multiply() is the schoolbook kernel on its own, for operands of different
+ * lengths, NttConvolver (NTT_convolve.h) runs its short products with it
+ *
+ * All coefficients are uint32_t in [0, q), q must be a prime in [5, 2^31)
+ * max_n bounds the NTT plans that are built, not the size of the products
+ * The object is read-only after construction (and after tune() / set_thresholds())
+ * and can be shared between threads when every thread passes its own tmp
+ * Invalid parameters throw std::invalid_argument
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * 2026/10/17	jorjor	school_multiply() shared with NTT_convolve.cpp
+ * */
+
+#ifndef NTT_MUL_H
+#define NTT_MUL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+
+#include "NTT_plan.h"
+
+// largest schoolbook product, the accumulators live on the stack
+#define POLYMUL_SCHOOL_MAX 256
+// n below this : schoolbook
+#define POLYMUL_KARATSUBA 48
+// n below this : Karatsuba, above : Toom-3
+#define POLYMUL_TOOM3 192
+// n from this on : NTT, when q has the roots of unity
+#define POLYMUL_NTT 128
+
+enum mul_algo {
+	MUL_SCHOOL,
+	MUL_KARATSUBA,
+	MUL_TOOM3,
+	MUL_NTT
+};
+
+const char *mul_algo_name(mul_algo algo);
+
+// rows of products a 64-bit accumulator below 2q can take : 2q + fold (q - 1)^2 < 2^64
+uint64_t school_fold(uint32_t q);
+
+// out = a * b mod red.q, la + lb - 1 coefficients, row by row into the la + lb - 1
+// accumulators of acc, reduced every fold rows, out may alias a or b
+void school_multiply(uint32_t *out, const uint32_t *a, int la, const uint32_t *b, int lb,
+	const BarrettReduce &red, uint64_t fold, uint64_t *acc);
+
+class PolyMul {
+public:
+	PolyMul(uint32_t q, int max_n, cpu_isa isa = ISA_AUTO);
+
+	uint32_t modulus() const { return red_.q; }
+	int karatsuba_threshold() const { return karatsuba_; }
+	int toom3_threshold() const { return toom3_; }
+	int ntt_threshold() const { return ntt_; }
+
+	// karatsuba in [2, POLYMUL_SCHOOL_MAX + 1], toom3 >= 3, ntt >= 1
+	void set_thresholds(int karatsuba, int toom3, int ntt);
+
+	// times the kernels one level at a time and sets the three thresholds
+	void tune();
+
+	// kernel of a product of n coefficients per operand
+	mul_algo algorithm(int n) const;
+
+	// true when the NTT of a product of n coefficients per operand is available
+	bool has_ntt(int n) const;
+
+	// coefficients of tmp needed by multiply() and multiply_mod() on n,
+	// changes with the thresholds
+	size_t scratch_size(int n) const;
+
+	// out = a * b, 2n - 1 coefficients, out must not alias a or b
+	// tmp holds scratch_size(n) coefficients, or is NULL and allocated here
+	void multiply(uint32_t *out, const uint32_t *a, const uint32_t *b, int n, uint32_t *tmp = NULL) const;
+
+	// same with algo forced on the top level, the sub-products are dispatched
+	void multiply_with(mul_algo algo, uint32_t *out, const uint32_t *a, const uint32_t *b, int n,
+		uint32_t *tmp = NULL) const;
+
+	// out = a * b mod (x^n - 1) (NTT_CYCLIC) or (x^n + 1) (NTT_NEGACYCLIC), n coefficients
+	// out may alias a or b
+	void multiply_mod(uint32_t *out, const uint32_t *a, const uint32_t *b, int n, ntt_mode mode,
+		uint32_t *tmp = NULL) const;
+
+private:
+	size_t scratch_of(mul_algo algo, int n) const;
+	void run(mul_algo algo, uint32_t *out, const uint32_t *a, const uint32_t *b, int n, uint32_t *tmp) const;
+	void dispatch(uint32_t *out, const uint32_t *a, const uint32_t *b, int n, uint32_t *tmp) const;
+
+	void school(uint32_t *out, const uint32_t *a, const uint32_t *b, int n) const;
+	void karatsuba(uint32_t *out, const uint32_t *a, const uint32_t *b, int n, uint32_t *tmp) const;
+	void toom3(uint32_t *out, const uint32_t *a, const uint32_t *b, int n, uint32_t *tmp) const;
+	void ntt(uint32_t *out, const uint32_t *a, const uint32_t *b, int n, uint32_t *tmp) const;
+
+	BarrettReduce red_;
+	uint64_t fold_;			// rows of products a 64-bit accumulator below 2q can take
+	uint32_t inv2_;
+	uint32_t inv3_;
+	int karatsuba_;
+	int toom3_;
+	int ntt_;
+	int max_n_;
+	std::vector<NttPlan> plans_;	// plans_[k] : cyclic, size 2^(k + 1)
+};
+
+#endif
@@ -10,11 +10,15 @@
  *
  * History
  * 2023/05/10	jorjor	First release
+ * 2026/10/17	jorjor	Bit-reverse permutation from bitrev.h
+ * 2026/10/17	jorjor	findw() tests the prime factors of q - 1, InverseMod() by extended Euclid
  * */
 
 #include <iostream>
 #include <cmath>
 
+#include "../bitrev.h"
+
 #define q 3329
 
 using namespace std;
@@ -36,19 +40,25 @@ int quickmod(int a, int b) {
 }
 
 int findw(int n) {
-	// find primitive root
-	bool CONTINUE = true;
+	// find primitive root : pr ** ((q - 1) / p) != 1 for every prime p of q - 1
+	int factors[32];
+	int count = 0;
+	int m = q - 1;
+	for (int d = 2; d * d <= m; d++) {
+		if (m % d == 0) {
+			factors[count++] = d;
+			while (m % d == 0) m /= d;
+		}
+	}
+	if (m > 1) factors[count++] = m;
+
 	int pr;
-	for (pr = 2; pr < q; pr++){
-		for (int i = 1; i < q; i++) {
-			if (i == q - 1) {
-				CONTINUE = false;
-			}
-			else if (quickmod(pr, i) % q == 1) {
-				break;
-			}
+	for (pr = 2; pr < q; pr++) {
+		bool primitive = true;
+		for (int i = 0; i < count && primitive; i++) {
+			primitive = (quickmod(pr, (q - 1) / factors[i]) != 1);
 		}
-		if (CONTINUE == false) {
+		if (primitive) {
 			break;
 		}
 	}
@@ -58,12 +68,22 @@ int findw(int n) {
 }
 
 int InverseMod(int a) {
-	for (int b = 2; b < q; b++) {
-		if ((a * b) % q == 1){
-			return b;
-		}
+	// extended Euclid, t * a = r mod q on every row
+	int t0 = 0, t1 = 1;
+	int r0 = q, r1 = a % q;
+	while (r1 != 0) {
+		int k = r0 / r1;
+		int r2 = r0 - k * r1;
+		int t2 = t0 - k * t1;
+		r0 = r1;
+		r1 = r2;
+		t0 = t1;
+		t1 = t2;
 	}
-	return -1;
+	if (r0 != 1) {
+		return -1;
+	}
+	return (t0 < 0) ? t0 + q : t0;
 }
 
 void DIV2(int *a) {
@@ -82,17 +102,6 @@ void print(int* arr, int len) {
     cout << " ]" << endl;
 }
 
-int bitreverse(int num, int len) {
-	int result = 0;
-
-	for (int i = len - 1; i >= 0; i--) {
-		result += ((num & 1) * pow(2, i));
-		num >>= 1;
-	}
-
-	return result;
-}
-
 void BFU_CT(int *arr, int i, int j, int wn) {
 	// DIT-FFT
 	// Cooley Tukey algorithm
@@ -122,6 +131,8 @@ int main(){
 	srand(0);
 
 	int n = 8;
+	int logn = 0;
+	while ((1 << logn) < n) logn++;
 	//int x1[] = {100, 100, 100, 100};
 	//int x2[] = {100, 200, 300, 400};
 	int x1[] = {100, 200, 200, 0, 100, 200, 500, 0};
@@ -166,9 +177,11 @@ int main(){
 
 	// reverse
 	for(int i = 0; i < n; i++) {
-		x1_ntt[i] = x1[bitreverse(i, log2(n))];
-		x2_ntt[i] = x2[bitreverse(i, log2(n))];
+		x1_ntt[i] = x1[i];
+		x2_ntt[i] = x2[i];
 	}
+	bitrev_permute(x1_ntt, logn);
+	bitrev_permute(x2_ntt, logn);
 	
 	// NTT
 	for (int step = 1; step <= log2(n); step++) {
@@ -198,8 +211,9 @@ int main(){
 	
 	// reverse 
 	for (int i = 0; i < n; i++) {
-		X_intt[i] = X_multi[bitreverse(i, log2(n))];
+		X_intt[i] = X_multi[i];
 	}
+	bitrev_permute(X_intt, logn);
 
 
 	// INTT
@@ -234,9 +248,11 @@ int main(){
 
 	// reverse
 	for(int i = 0; i < n; i++) {
-		x1_intt[i] = x1_ntt[bitreverse(i, log2(n))];
-		x2_intt[i] = x2_ntt[bitreverse(i, log2(n))];
+		x1_intt[i] = x1_ntt[i];
+		x2_intt[i] = x2_ntt[i];
 	}
+	bitrev_permute(x1_intt, logn);
+	bitrev_permute(x2_intt, logn);
 
 
 	// INTT
@@ -261,15 +277,15 @@ int main(){
     cout << "x1_intt: "; print(x1_intt, n);
     cout << "x2_intt: "; print(x2_intt, n); cout << endl;
 
-	delete x1_intt;
-	delete x2_intt;
+	delete[] x1_intt;
+	delete[] x2_intt;
 #endif
 	
-	delete x1_ntt;
-	delete x2_ntt;
-	delete X_multi;
-	delete X_intt;
-	delete naive_result;
+	delete[] x1_ntt;
+	delete[] x2_ntt;
+	delete[] X_multi;
+	delete[] X_intt;
+	delete[] naive_result;
 
 	return 0;
 }
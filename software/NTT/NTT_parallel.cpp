@@ -0,0 +1,74 @@
+/*
+ * NTT_parallel.cpp
+ *
+ * Description
+ * Implementation of NttParallel, see NTT_parallel.h
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * */
+
+#include "NTT_parallel.h"
+
+#include <unistd.h>
+
+using namespace std;
+
+static long l2_cache_size() {
+#ifdef _SC_LEVEL2_CACHE_SIZE
+	long size = sysconf(_SC_LEVEL2_CACHE_SIZE);
+	if (size > 0) {
+		return size;
+	}
+#endif
+	return 256 * 1024;
+}
+
+NttParallel::Worker::Worker(const NttParallel &p) : plan(p.plan_) {
+	int n = plan.size();
+	if (p.use_batch_) {
+		batch.reset(new NttBatch(n, plan.modulus(), plan.mode(), plan.root()));
+		tmp.resize(2 * (size_t)batch->width() * n);
+	}
+	else {
+		tmp.resize(n);
+	}
+}
+
+NttParallel::NttParallel(const NttPlan &plan, ThreadPool &pool, int chunk)
+	: plan_(plan), pool_(pool), chunk_(chunk), workers_(pool.slots()) {
+	use_batch_ = (plan_.isa() == ISA_SCALAR && cpu_select_isa() >= ISA_AVX2);
+	int width = use_batch_ ? (cpu_select_isa() == ISA_AVX512 ? 16 : 8) : 1;
+
+	if (chunk_ <= 0) {
+		// a, b and out of a chunk in half of the L2 cache
+		long bytes = 3L * plan_.size() * sizeof(uint32_t);
+		chunk_ = (int)(l2_cache_size() / 2 / bytes);
+	}
+	// whole interleaved blocks
+	chunk_ = (chunk_ + width - 1) / width * width;
+	if (chunk_ < width) chunk_ = width;
+}
+
+void NttParallel::run(uint32_t *out, const uint32_t *a, const uint32_t *b, long lo, long hi, int slot) {
+	if (!workers_[slot]) {
+		// first touch by the thread that uses it
+		workers_[slot].reset(new Worker(*this));
+	}
+	Worker &w = *workers_[slot];
+	const size_t n = plan_.size();
+
+	if (w.batch) {
+		w.batch->multiply(out + lo * n, a + lo * n, b + lo * n, (int)(hi - lo), w.tmp.data());
+		return;
+	}
+	for (long p = lo; p < hi; p++) {
+		w.plan.multiply(out + p * n, a + p * n, b + p * n, w.tmp.data());
+	}
+}
+
+void NttParallel::multiply(uint32_t *out, const uint32_t *a, const uint32_t *b, long count) {
+	pool_.parallel_for(0, count, chunk_, [=](long lo, long hi, int slot) {
+		run(out, a, b, lo, hi, slot);
+	});
+}
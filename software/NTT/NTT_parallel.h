@@ -0,0 +1,64 @@
+/*
+ * NTT_parallel.h
+ *
+ * Description
+ * Multi-threaded batch of independent polynomial multiplications on a ThreadPool
+ * (thread_pool.h), for batches of many pairs, e.g. 10^5 n = 256 products
+ *
+ * The batch is split in chunks sized so that the polynomials of one chunk
+ * stay in the L2 cache, the chunks are spread over the threads and stolen by idle ones
+ * Every thread works with its own copy of the twiddle tables (NttPlan and NttBatch),
+ * made by that thread the first time it runs a chunk, and its own scratch buffers
+ *
+ * Kernel of a chunk : the NttPlan kernel when it is a SIMD one (int16, Kyber-sized q),
+ * otherwise NttBatch (NTT_batch.h) when the CPU has AVX2, the scalar plan else
+ * Results are bit-identical to NttPlan::multiply()
+ *
+ * One multiply() at a time per object
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * */
+
+#ifndef NTT_PARALLEL_H
+#define NTT_PARALLEL_H
+
+#include <stdint.h>
+#include <memory>
+#include <vector>
+
+#include "NTT_plan.h"
+#include "NTT_batch.h"
+#include "thread_pool.h"
+
+class NttParallel {
+public:
+	// chunk : polynomial pairs per task, 0 = sized from the L2 cache
+	NttParallel(const NttPlan &plan, ThreadPool &pool, int chunk = 0);
+
+	int chunk() const { return chunk_; }
+	bool uses_batch() const { return use_batch_; }
+
+	// out[p] = a[p] * b[p] for count pairs of n coefficients, one polynomial after the other
+	// out may alias a or b
+	void multiply(uint32_t *out, const uint32_t *a, const uint32_t *b, long count);
+
+private:
+	struct Worker {
+		explicit Worker(const NttParallel &p);
+
+		NttPlan plan;
+		std::unique_ptr<NttBatch> batch;
+		std::vector<uint32_t> tmp;
+	};
+
+	void run(uint32_t *out, const uint32_t *a, const uint32_t *b, long lo, long hi, int slot);
+
+	NttPlan plan_;
+	ThreadPool &pool_;
+	bool use_batch_;
+	int chunk_;
+	std::vector<std::unique_ptr<Worker> > workers_;	// one per pool slot
+};
+
+#endif
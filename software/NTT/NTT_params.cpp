@@ -0,0 +1,230 @@
+/*
+ * NTT_params.cpp
+ *
+ * Description
+ * Implementation of the NTT parameter generation, see NTT_params.h
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * */
+
+#include "NTT_params.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace std;
+
+uint64_t powmod_u64(uint64_t a, uint64_t e, uint64_t m) {
+	// a ** e % m
+	uint64_t ans = 1 % m;
+	a %= m;
+	while (e != 0) {
+		if (e & 1) ans = mulmod_u64(ans, a, m);
+		a = mulmod_u64(a, a, m);
+		e >>= 1;
+	}
+	return ans;
+}
+
+uint64_t inverse_mod(uint64_t a, uint64_t m) {
+	// extended Euclid, t * a = r mod m for every row, the coefficients stay below m in size
+	if (m < 2) {
+		throw invalid_argument("inverse_mod: m must be at least 2");
+	}
+	__int128 t0 = 0, t1 = 1;
+	uint64_t r0 = m, r1 = a % m;
+	while (r1 != 0) {
+		uint64_t k = r0 / r1;
+		uint64_t r2 = r0 - k * r1;
+		__int128 t2 = t0 - (__int128)k * t1;
+		r0 = r1;
+		r1 = r2;
+		t0 = t1;
+		t1 = t2;
+	}
+	if (r0 != 1) {
+		throw invalid_argument("inverse_mod: a is not invertible modulo m");
+	}
+	return (uint64_t)((t0 < 0) ? t0 + m : t0);
+}
+
+static const uint64_t small_primes[] = { 2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37 };
+
+bool is_prime_u64(uint64_t x) {
+	if (x < 2) return false;
+	for (size_t i = 0; i < sizeof(small_primes) / sizeof(small_primes[0]); i++) {
+		if (x % small_primes[i] == 0) return x == small_primes[i];
+	}
+	if (x < 37 * 37) return true;
+
+	// x - 1 = d * 2^s, the first 12 primes as bases are deterministic below 2^64
+	uint64_t d = x - 1;
+	int s = 0;
+	while ((d & 1) == 0) {
+		d >>= 1;
+		s++;
+	}
+	for (size_t i = 0; i < sizeof(small_primes) / sizeof(small_primes[0]); i++) {
+		uint64_t y = powmod_u64(small_primes[i], d, x);
+		if (y == 1 || y == x - 1) continue;
+		bool composite = true;
+		for (int r = 1; r < s && composite; r++) {
+			y = mulmod_u64(y, y, x);
+			if (y == x - 1) composite = false;
+		}
+		if (composite) return false;
+	}
+	return true;
+}
+
+static uint64_t gcd_u64(uint64_t a, uint64_t b) {
+	while (b != 0) {
+		uint64_t t = a % b;
+		a = b;
+		b = t;
+	}
+	return a;
+}
+
+static uint64_t rho_step(uint64_t v, uint64_t c, uint64_t x) {
+	return (uint64_t)(((unsigned __int128)v * v + c) % x);
+}
+
+static uint64_t pollard_brent(uint64_t x) {
+	// non-trivial factor of an odd composite x, the differences are multiplied
+	// together and one gcd is taken per batch of 128 steps
+	const uint64_t batch = 128;
+	for (uint64_t c = 1; ; c++) {
+		uint64_t y = 2, xs = 2, ys = 2, prod = 1, g = 1;
+		for (uint64_t r = 1; g == 1; r *= 2) {
+			xs = y;
+			for (uint64_t i = 0; i < r; i++) {
+				y = rho_step(y, c, x);
+			}
+			for (uint64_t k = 0; k < r && g == 1; k += batch) {
+				ys = y;
+				for (uint64_t i = 0; i < batch && i < r - k; i++) {
+					y = rho_step(y, c, x);
+					prod = mulmod_u64(prod, (xs > y) ? xs - y : y - xs, x);
+				}
+				g = gcd_u64(prod, x);
+			}
+		}
+		if (g == x) {
+			// the batch overshot, redo it one step at a time
+			do {
+				ys = rho_step(ys, c, x);
+				g = gcd_u64((xs > ys) ? xs - ys : ys - xs, x);
+			} while (g == 1);
+		}
+		if (g != x) return g;
+	}
+}
+
+static void factor_rec(uint64_t x, vector<uint64_t> &factors) {
+	if (x == 1) return;
+	if (is_prime_u64(x)) {
+		factors.push_back(x);
+		return;
+	}
+	uint64_t d = pollard_brent(x);
+	factor_rec(d, factors);
+	factor_rec(x / d, factors);
+}
+
+vector<uint64_t> factor_u64(uint64_t x) {
+	vector<uint64_t> factors;
+	if (x < 2) return factors;
+	for (uint64_t d = 2; d < 1024 && d * d <= x; d += (d == 2) ? 1 : 2) {
+		if (x % d == 0) {
+			factors.push_back(d);
+			while (x % d == 0) x /= d;
+		}
+	}
+	factor_rec(x, factors);
+	sort(factors.begin(), factors.end());
+	factors.erase(unique(factors.begin(), factors.end()), factors.end());
+	return factors;
+}
+
+static uint64_t primitive_root(uint64_t q, const vector<uint64_t> &factors) {
+	for (uint64_t g = 2; g < q; g++) {
+		bool primitive = true;
+		for (size_t i = 0; i < factors.size() && primitive; i++) {
+			primitive = powmod_u64(g, (q - 1) / factors[i], q) != 1;
+		}
+		if (primitive) return g;
+	}
+	return 1;	// q = 2
+}
+
+uint64_t primitive_root(uint64_t q) {
+	if (!is_prime_u64(q)) {
+		throw invalid_argument("primitive_root: q must be prime");
+	}
+	return primitive_root(q, factor_u64(q - 1));
+}
+
+uint64_t ntt_root_of_unity(uint64_t q, uint64_t order) {
+	if (!is_prime_u64(q) || order == 0 || (q - 1) % order != 0) {
+		throw invalid_argument("ntt_root_of_unity: q must be prime and order must divide q - 1");
+	}
+	return powmod_u64(primitive_root(q), (q - 1) / order, q);
+}
+
+static uint64_t transform_order(size_t n, ntt_mode mode) {
+	if (n < 2 || (n & (n - 1)) != 0) {
+		throw invalid_argument("ntt_params: n must be a power of two");
+	}
+	return (mode == NTT_CYCLIC) ? n : 2 * (uint64_t)n;
+}
+
+vector<uint64_t> ntt_primes(size_t n, ntt_mode mode, int bits, int count) {
+	uint64_t order = transform_order(n, mode);
+	if (bits < 2 || bits > 63) {
+		throw invalid_argument("ntt_primes: bits must be in [2, 63]");
+	}
+
+	// q = k * order + 1 in [2^(bits - 1), 2^bits), from the top down
+	uint64_t lo = (uint64_t)1 << (bits - 1);
+	uint64_t hi = ((uint64_t)1 << bits) - 1;
+	vector<uint64_t> primes;
+	if (order < hi) {
+		for (uint64_t c = hi - (hi - 1) % order; c >= lo && (int)primes.size() < count; c -= order) {
+			if (is_prime_u64(c)) primes.push_back(c);
+			if (c < order) break;
+		}
+	}
+	if ((int)primes.size() < count) {
+		throw invalid_argument("ntt_primes: not enough primes of this size for this transform");
+	}
+	return primes;
+}
+
+NttParams ntt_params(size_t n, ntt_mode mode, int bits) {
+	return ntt_params_for(n, mode, ntt_primes(n, mode, bits, 1)[0]);
+}
+
+NttParams ntt_params_for(size_t n, ntt_mode mode, uint64_t q) {
+	uint64_t order = transform_order(n, mode);
+	if (q < 3 || !is_prime_u64(q)) {
+		throw invalid_argument("ntt_params: q must be an odd prime");
+	}
+	if ((q - 1) % order != 0) {
+		throw invalid_argument("ntt_params: q - 1 is not divisible by the transform size");
+	}
+
+	NttParams p;
+	p.n = n;
+	p.mode = mode;
+	p.q = q;
+	p.bits = 0;
+	while (p.bits < 64 && (q >> p.bits) != 0) p.bits++;
+	p.factors = factor_u64(q - 1);
+	p.g = primitive_root(q, p.factors);
+	p.root = powmod_u64(p.g, (q - 1) / order, q);
+	p.root_inv = inverse_mod(p.root, q);
+	p.n_inv = inverse_mod(n % q, q);
+	return p;
+}
@@ -0,0 +1,79 @@
+/*
+ * NTT_params.h
+ *
+ * Description
+ * NTT parameter generation for moduli up to 63 bits
+ * findw() of NTT_GSCT.cpp tries every exponent of every candidate (O(q^2) quickmod
+ * calls on int values) and InverseMod() scans all of [2, q), NttTables factors
+ * q - 1 by trial division up to sqrt(q), none of them reaches a 30-60 bit modulus
+ * Here every step is polylog in q, with 128-bit products :
+ *
+ *   mulmod_u64, powmod_u64            a * b mod m, a^e mod m for any m < 2^64
+ *   inverse_mod(a, m)                 extended Euclid, any m, gcd(a, m) must be 1
+ *   is_prime_u64(x)                   deterministic Miller-Rabin (bases 2 ... 37 cover 2^64)
+ *   factor_u64(x)                     distinct prime factors, small primes by trial
+ *                                     division, the rest by Pollard-Brent rho
+ *   primitive_root(q)                 smallest generator g of (Z/q)*,
+ *                                     g^((q - 1) / p) != 1 for every prime p of q - 1
+ *   ntt_root_of_unity(q, order)       g^((q - 1) / order), exact order
+ *
+ *   ntt_primes(n, mode, bits, count)  the count largest primes of exactly `bits` bits
+ *                                     with 2n | q - 1 (negacyclic) or n | q - 1 (cyclic),
+ *                                     largest first
+ *   ntt_params(n, mode, bits)         NttParams of the largest of them
+ *   ntt_params_for(n, mode, q)        NttParams of a given prime q
+ *
+ * The roots are the ones NttTables (NTT_tables.h) would pick, so for q below 2^31
+ * NttParams::root can be passed to NttPlan as is
+ * Invalid parameters throw std::invalid_argument
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * 2026/10/17	jorjor	root_of_unity() renamed ntt_root_of_unity(), FFT_plan.h has its own
+ * */
+
+#ifndef NTT_PARAMS_H
+#define NTT_PARAMS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+
+#include "NTT_tables.h"
+
+static inline uint64_t mulmod_u64(uint64_t a, uint64_t b, uint64_t m) {
+	return (uint64_t)((unsigned __int128)a * b % m);
+}
+
+uint64_t powmod_u64(uint64_t a, uint64_t e, uint64_t m);
+
+uint64_t inverse_mod(uint64_t a, uint64_t m);
+
+bool is_prime_u64(uint64_t x);
+
+// distinct prime factors of x, increasing
+std::vector<uint64_t> factor_u64(uint64_t x);
+
+uint64_t primitive_root(uint64_t q);
+
+uint64_t ntt_root_of_unity(uint64_t q, uint64_t order);
+
+struct NttParams {
+	size_t n;
+	ntt_mode mode;
+	uint64_t q;
+	int bits;						// bits of q
+	std::vector<uint64_t> factors;	// distinct primes of q - 1
+	uint64_t g;						// smallest primitive root of q
+	uint64_t root;					// w of order n (cyclic) or psi of order 2n (negacyclic)
+	uint64_t root_inv;
+	uint64_t n_inv;
+};
+
+std::vector<uint64_t> ntt_primes(size_t n, ntt_mode mode, int bits, int count = 1);
+
+NttParams ntt_params(size_t n, ntt_mode mode, int bits);
+
+NttParams ntt_params_for(size_t n, ntt_mode mode, uint64_t q);
+
+#endif
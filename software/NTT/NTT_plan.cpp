@@ -0,0 +1,223 @@
+/*
+ * NTT_plan.cpp
+ *
+ * Description
+ * Implementation of NttPlan, see NTT_plan.h
+ * The butterflies are the same as BFU_CT / BFU_GS in NTT_GSCT.cpp,
+ * the twiddle tables are built like main() of NTT_NWC.cpp but once per plan
+ * The template is instantiated here for every reduction policy of NTT_reduce.h
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * 2026/10/17	jorjor	Reduction policy and lazy reduction template parameters
+ * 2026/10/17	jorjor	Runtime dispatch to the AVX2 / AVX-512 kernels
+ * 2026/10/17	jorjor	forward_padded() for zero-padded inputs
+ * */
+
+#include "NTT_plan.h"
+
+#include <stdexcept>
+
+using namespace std;
+
+template <class Reduce, int Lazy>
+NttPlanT<Reduce, Lazy>::NttPlanT(int n, uint32_t q, ntt_mode mode, uint32_t root, cpu_isa isa)
+	: tab_(n, q, mode, root), red_(q), isa_(ISA_SCALAR) {
+	if (Lazy > 1 && q >= (1u << 30)) {
+		throw invalid_argument("NttPlan: lazy reduction needs q below 2^30");
+	}
+
+	isa = cpu_resolve_isa(isa);
+	if (isa >= ISA_AVX512 && NttAvx512::supported(tab_)) {
+		avx512_ = NttAvx512(tab_);
+		isa_ = ISA_AVX512;
+	}
+	else if (isa >= ISA_AVX2 && NttAvx2::supported(tab_)) {
+		avx2_ = NttAvx2(tab_);
+		isa_ = ISA_AVX2;
+	}
+
+	scale_ = red_.prepare(tab_.scale);
+	zetas_.resize(tab_.zetas.size());
+	zetas_inv_.resize(tab_.zetas.size());
+	for (size_t k = 0; k < tab_.zetas.size(); k++) {
+		zetas_[k] = red_.prepare(tab_.zetas[k]);
+		zetas_inv_[k] = red_.prepare(tab_.zetas_inv[k]);
+	}
+}
+
+template <class Reduce, int Lazy>
+void NttPlanT<Reduce, Lazy>::forward(uint32_t *x) const {
+	switch (isa_) {
+	case ISA_AVX512:	avx512_.forward(x); break;
+	case ISA_AVX2:		avx2_.forward(x); break;
+	default:			forward_scalar(x, tab_.n); break;
+	}
+}
+
+template <class Reduce, int Lazy>
+void NttPlanT<Reduce, Lazy>::forward_padded(uint32_t *x, int len) const {
+	if (len < 1 || len > tab_.n) {
+		throw invalid_argument("NttPlan: len must be in [1, n]");
+	}
+	switch (isa_) {
+	case ISA_AVX512:	avx512_.forward(x); break;
+	case ISA_AVX2:		avx2_.forward(x); break;
+	default:			forward_scalar(x, len); break;
+	}
+}
+
+template <class Reduce, int Lazy>
+void NttPlanT<Reduce, Lazy>::forward_scalar(uint32_t *x, int used) const {
+	const Reduce red = red_;	// local copy, x may alias the members
+	const int n = tab_.n;
+	const uint32_t q = tab_.q;
+	const uint32_t q2 = 2 * q;
+	const twiddle *zetas = zetas_.data();
+	int k = 1;
+	int len = n / 2;
+
+	// x[j + len] = 0 : the butterfly gives x[j] twice, every block starts
+	// with the same used values and the rest stays zero
+	for (; len >= tab_.leaf && len >= used; len >>= 1) {
+		for (int s = 0; s < n; s += 2 * len) {
+			for (int j = s; j < s + used; j++) {
+				x[j + len] = x[j];
+			}
+		}
+		k += n / (2 * len);
+	}
+
+	for (; len >= tab_.leaf; len >>= 1) {
+		for (int s = 0; s < n; s += 2 * len) {
+			twiddle w = zetas[k++];
+			for (int j = s; j < s + len; j++) {
+				// BFU_CT
+				uint32_t temp1 = x[j];
+				uint32_t temp2 = red.mul(x[j + len], w);
+				if (Lazy == 1) {
+					temp2 = csub(temp2, q);
+					x[j] = csub(temp1 + temp2, q);
+					x[j + len] = csub(temp1 + q - temp2, q);
+				}
+				else if (Lazy == 2) {
+					x[j] = csub(temp1 + temp2, q2);
+					x[j + len] = csub(temp1 + q2 - temp2, q2);
+				}
+				else {
+					temp1 = csub(temp1, q2);
+					x[j] = temp1 + temp2;
+					x[j + len] = temp1 + q2 - temp2;
+				}
+			}
+		}
+	}
+
+	if (Lazy == 4) {
+		for (int i = 0; i < n; i++) x[i] = csub(csub(x[i], q2), q);
+	}
+	else if (Lazy == 2) {
+		for (int i = 0; i < n; i++) x[i] = csub(x[i], q);
+	}
+}
+
+template <class Reduce, int Lazy>
+void NttPlanT<Reduce, Lazy>::inverse(uint32_t *x) const {
+	switch (isa_) {
+	case ISA_AVX512:	avx512_.inverse(x); break;
+	case ISA_AVX2:		avx2_.inverse(x); break;
+	default:			inverse_scalar(x); break;
+	}
+}
+
+template <class Reduce, int Lazy>
+void NttPlanT<Reduce, Lazy>::inverse_scalar(uint32_t *x) const {
+	const Reduce red = red_;
+	const int n = tab_.n;
+	const uint32_t q = tab_.q;
+	const uint32_t q2 = 2 * q;
+	const twiddle *zetas_inv = zetas_inv_.data();
+	for (int len = tab_.leaf; len <= n / 2; len <<= 1) {
+		int k = n / (2 * len);
+		for (int s = 0; s < n; s += 2 * len) {
+			twiddle w = zetas_inv[k++];
+			for (int j = s; j < s + len; j++) {
+				// BFU_GS
+				uint32_t temp1 = x[j];
+				uint32_t temp2 = x[j + len];
+				if (Lazy == 1) {
+					x[j] = csub(temp1 + temp2, q);
+					x[j + len] = csub(red.mul(temp1 + q - temp2, w), q);
+				}
+				else {
+					x[j] = csub(temp1 + temp2, q2);
+					x[j + len] = red.mul(temp1 + q2 - temp2, w);
+				}
+			}
+		}
+	}
+
+	for (int i = 0; i < n; i++) {
+		x[i] = csub(red.mul(x[i], scale_), q);
+	}
+}
+
+template <class Reduce, int Lazy>
+void NttPlanT<Reduce, Lazy>::pointwise(uint32_t *out, const uint32_t *a, const uint32_t *b) const {
+	switch (isa_) {
+	case ISA_AVX512:	avx512_.pointwise(out, a, b); break;
+	case ISA_AVX2:		avx2_.pointwise(out, a, b); break;
+	default:			pointwise_scalar(out, a, b); break;
+	}
+}
+
+template <class Reduce, int Lazy>
+void NttPlanT<Reduce, Lazy>::pointwise_scalar(uint32_t *out, const uint32_t *a, const uint32_t *b) const {
+	const int n = tab_.n;
+	const uint32_t q = tab_.q;
+	if (tab_.leaf == 1) {
+		for (int i = 0; i < n; i++) {
+			out[i] = red_.mulmod(a[i], b[i]);
+		}
+		return;
+	}
+
+	for (int i = 0; i < n / 2; i++) {
+		uint32_t a0 = a[2*i], a1 = a[2*i+1];
+		uint32_t b0 = b[2*i], b1 = b[2*i+1];
+
+		uint32_t c0 = red_.mulmod(a0, b0) + red_.mulmod(red_.mulmod(a1, b1), tab_.leaf_w[i]);
+		uint32_t c1 = red_.mulmod(a0, b1) + red_.mulmod(a1, b0);
+		out[2*i] = csub(c0, q);
+		out[2*i+1] = csub(c1, q);
+	}
+}
+
+template <class Reduce, int Lazy>
+void NttPlanT<Reduce, Lazy>::multiply(uint32_t *out, const uint32_t *a, const uint32_t *b, uint32_t *tmp) const {
+	const int n = tab_.n;
+	for (int i = 0; i < n; i++) {
+		tmp[i] = b[i];
+	}
+	if (out != a) {
+		for (int i = 0; i < n; i++) {
+			out[i] = a[i];
+		}
+	}
+
+	forward(out);
+	forward(tmp);
+	pointwise(out, out, tmp);
+	inverse(out);
+}
+
+template class NttPlanT<ModReduce, 1>;
+template class NttPlanT<BarrettReduce, 1>;
+template class NttPlanT<BarrettReduce, 2>;
+template class NttPlanT<BarrettReduce, 4>;
+template class NttPlanT<MontgomeryReduce, 1>;
+template class NttPlanT<MontgomeryReduce, 2>;
+template class NttPlanT<MontgomeryReduce, 4>;
+template class NttPlanT<ShoupReduce, 1>;
+template class NttPlanT<ShoupReduce, 2>;
+template class NttPlanT<ShoupReduce, 4>;
@@ -0,0 +1,113 @@
+/*
+ * NTT_plan.h
+ *
+ * Description
+ * Reusable NTT plan extracted from NTT_NWC.cpp / NTT_GSCT.cpp
+ * A plan owns the twiddle tables of one (n, q, cyclic/negacyclic) parameter set,
+ * it is built once and then only read, so one plan can be shared by many threads
+ * and several plans with different parameters can live in the same program
+ *
+ * forward : DIT (Cooley-Tukey), natural order in, bit-reversed order out
+ * inverse : DIF (Gentleman-Sande), bit-reversed order in, natural order out
+ * no bit reverse permutation is done, same as NTT_GSCT.cpp and NTT_NWC.cpp
+ *
+ * When q - 1 is not divisible by 2n (e.g. Kyber, q = 3329, n = 256) the negacyclic
+ * transform stops one layer early (incomplete NTT) and pointwise() multiplies
+ * degree-1 pairs modulo x^2 - w, exactly like NTT() / PWM() in NTT_NWC.cpp
+ *
+ * All coefficients are uint32_t in [0, q), q must be an odd prime below 2^31
+ * Invalid parameters throw std::invalid_argument
+ *
+ * NttPlanT<Reduce, Lazy> picks the modular reduction of the butterflies (NTT_reduce.h)
+ * Lazy = 1 keeps every value in [0, q), Lazy = 2 keeps [0, 2q) between layers,
+ * Lazy = 4 keeps [0, 4q) in forward() (Harvey butterfly) and [0, 2q) in inverse()
+ * Lazy > 1 needs q below 2^30, inputs and outputs are always in [0, q)
+ *
+ * The plan picks its kernels once, when it is built (cpu_dispatch.h) :
+ * the int16 AVX-512 / AVX2 kernels when the CPU and the parameter set allow them
+ * (Kyber-sized moduli, NTT_simd.h), the scalar Reduce / Lazy butterflies otherwise
+ * All kernels give bit-identical results
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * 2026/10/17	jorjor	Reduction policy and lazy reduction template parameters
+ * 2026/10/17	jorjor	Runtime dispatch to the AVX2 / AVX-512 kernels
+ * 2026/10/17	jorjor	forward_padded() for zero-padded inputs
+ * */
+
+#ifndef NTT_PLAN_H
+#define NTT_PLAN_H
+
+#include <stdint.h>
+#include <vector>
+
+#include "cpu_dispatch.h"
+#include "NTT_tables.h"
+#include "NTT_reduce.h"
+#include "NTT_avx2.h"
+#include "NTT_avx512.h"
+
+template <class Reduce, int Lazy = 1>
+class NttPlanT {
+public:
+	// isa : ISA_AUTO or the highest ISA the plan may use
+	NttPlanT(int n, uint32_t q, ntt_mode mode, uint32_t root = 0, cpu_isa isa = ISA_AUTO);
+
+	int size() const { return tab_.n; }
+	uint32_t modulus() const { return tab_.q; }
+	ntt_mode mode() const { return tab_.mode; }
+	int leaf() const { return tab_.leaf; }
+	uint32_t root() const { return tab_.root; }
+	const NttTables &tables() const { return tab_; }
+	cpu_isa isa() const { return isa_; }
+
+	// in-place transforms on n coefficients
+	void forward(uint32_t *x) const;
+	void inverse(uint32_t *x) const;
+
+	// forward() of x with x[len, n) zero on entry, a layer of distance >= len
+	// only copies x[s, s + len) into the zero upper half of every block
+	// (every layer runs when the SIMD kernels are in use)
+	void forward_padded(uint32_t *x, int len) const;
+
+	// out = a . b in the NTT domain, out may alias a or b
+	void pointwise(uint32_t *out, const uint32_t *a, const uint32_t *b) const;
+
+	// out = a * b mod (x^n -/+ 1), tmp must hold n coefficients
+	// out may alias a, tmp must not alias anything
+	void multiply(uint32_t *out, const uint32_t *a, const uint32_t *b, uint32_t *tmp) const;
+
+private:
+	typedef typename Reduce::twiddle twiddle;
+
+	void forward_scalar(uint32_t *x, int used) const;
+	void inverse_scalar(uint32_t *x) const;
+	void pointwise_scalar(uint32_t *out, const uint32_t *a, const uint32_t *b) const;
+
+	NttTables tab_;
+	Reduce red_;
+	cpu_isa isa_;
+	NttAvx2 avx2_;
+	NttAvx512 avx512_;
+
+	// tab_ converted by Reduce::prepare()
+	twiddle scale_;
+	std::vector<twiddle> zetas_;
+	std::vector<twiddle> zetas_inv_;
+};
+
+extern template class NttPlanT<ModReduce, 1>;
+extern template class NttPlanT<BarrettReduce, 1>;
+extern template class NttPlanT<BarrettReduce, 2>;
+extern template class NttPlanT<BarrettReduce, 4>;
+extern template class NttPlanT<MontgomeryReduce, 1>;
+extern template class NttPlanT<MontgomeryReduce, 2>;
+extern template class NttPlanT<MontgomeryReduce, 4>;
+extern template class NttPlanT<ShoupReduce, 1>;
+extern template class NttPlanT<ShoupReduce, 2>;
+extern template class NttPlanT<ShoupReduce, 4>;
+
+// default plan, Shoup twiddles accept every q below 2^31
+typedef NttPlanT<ShoupReduce, 1> NttPlan;
+
+#endif
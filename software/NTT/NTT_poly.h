@@ -0,0 +1,208 @@
+/*
+ * NTT_poly.h
+ *
+ * Description
+ * Poly<N, Q, Mode> : polynomial of N coefficients modulo Q with an NTT fixed at compile time
+ * NttPlan takes (n, q) at run time, every loop bound, block offset and twiddle is read
+ * from the plan, and NTT_NWC.cpp computes its bounds with log2(n) and pow(2, ...) doubles
+ * Here the layers are unrolled by templates : the stride of every layer and the
+ * bounds of its loops are constants, the blocks of the first layers (up to
+ * POLY_UNROLL_BLOCKS per layer) are unrolled too, with their offset and twiddle
+ * (and its Shoup quotient) as immediates, Q is folded into the reductions (the
+ * compiler turns % Q into a multiplication) and the whole transform is inlined
+ * into the caller
+ *
+ * Same results as NttPlan (NTT_plan.h) built with (N, Q, Mode), bit for bit
+ *   forward : DIT (Cooley-Tukey), natural order in, bit-reversed order out
+ *   inverse : DIF (Gentleman-Sande), bit-reversed order in, natural order out
+ *   the tables are NttConstTables (NTT_constexpr.h), the values of NttTables,
+ *   Kyber (Q = 3329, N = 256) stops one layer early and basemul() works on
+ *   degree-1 pairs modulo x^2 - leaf_w[i], like PWM() in NTT_NWC.cpp
+ *
+ * All coefficients are uint32_t in [0, Q), Q must be an odd prime below 2^31,
+ * q - 1 = c * 2^k with a small c (cx_primitive_root()), checked with static_assert
+ * Every Poly<N, Q> is its own code, meant for the small fixed sizes of lattice schemes
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * */
+
+#ifndef NTT_POLY_H
+#define NTT_POLY_H
+
+#include <stdint.h>
+
+#include "NTT_constexpr.h"
+#include "NTT_tables.h"
+#include "NTT_reduce.h"
+
+#define POLY_INLINE __attribute__((always_inline)) inline
+
+// layers with up to this many blocks are unrolled block by block, the twiddles
+// become immediates, the deeper layers loop over their blocks with constant
+// bounds and read the twiddles from the constexpr tables
+#define POLY_UNROLL_BLOCKS 16
+
+template <uint32_t Q>
+static POLY_INLINE uint32_t poly_mul(uint32_t a, uint32_t w, uint32_t wp) {
+	// a * w mod Q in [0, Q), a < 2^32, wp = floor(w * 2^32 / Q)
+	uint32_t qhat = (uint32_t)(((uint64_t)a * wp) >> 32);
+	return csub(a * w - qhat * Q, Q);
+}
+
+template <uint32_t Q, int Len>
+static POLY_INLINE void poly_ct_block(uint32_t *a, uint32_t w, uint32_t wp) {
+	for (int j = 0; j < Len; j++) {
+		// BFU_CT
+		uint32_t temp1 = a[j];
+		uint32_t temp2 = poly_mul<Q>(a[j + Len], w, wp);
+		a[j] = csub(temp1 + temp2, Q);
+		a[j + Len] = csub(temp1 + Q - temp2, Q);
+	}
+}
+
+template <uint32_t Q, int Len>
+static POLY_INLINE void poly_gs_block(uint32_t *a, uint32_t w, uint32_t wp) {
+	for (int j = 0; j < Len; j++) {
+		// BFU_GS
+		uint32_t temp1 = a[j];
+		uint32_t temp2 = a[j + Len];
+		a[j] = csub(temp1 + temp2, Q);
+		a[j + Len] = poly_mul<Q>(temp1 + Q - temp2, w, wp);
+	}
+}
+
+// blocks [K, E) of the layer with distance Len, block K starts at (K - N / (2 Len)) * 2 Len
+template <class T, int N, uint32_t Q, int Len, int K, int E, bool One = (E - K == 1)>
+struct PolyBlocks {
+	static POLY_INLINE void forward(uint32_t *x) {
+		PolyBlocks<T, N, Q, Len, K, (K + E) / 2>::forward(x);
+		PolyBlocks<T, N, Q, Len, (K + E) / 2, E>::forward(x);
+	}
+
+	static POLY_INLINE void inverse(uint32_t *x) {
+		PolyBlocks<T, N, Q, Len, K, (K + E) / 2>::inverse(x);
+		PolyBlocks<T, N, Q, Len, (K + E) / 2, E>::inverse(x);
+	}
+};
+
+template <class T, int N, uint32_t Q, int Len, int K, int E>
+struct PolyBlocks<T, N, Q, Len, K, E, true> {
+	static POLY_INLINE void forward(uint32_t *x) {
+		poly_ct_block<Q, Len>(x + (K - N / (2 * Len)) * 2 * Len, T::zetas[K], T::zetas_shoup[K]);
+	}
+
+	static POLY_INLINE void inverse(uint32_t *x) {
+		poly_gs_block<Q, Len>(x + (K - N / (2 * Len)) * 2 * Len, T::zetas_inv[K], T::zetas_inv_shoup[K]);
+	}
+};
+
+template <class T, int N, uint32_t Q, int Len, bool Unroll = (N / (2 * Len) <= POLY_UNROLL_BLOCKS)>
+struct PolyLayer {
+	static POLY_INLINE void forward(uint32_t *x) {
+		PolyBlocks<T, N, Q, Len, N / (2 * Len), N / Len>::forward(x);
+	}
+
+	static POLY_INLINE void inverse(uint32_t *x) {
+		PolyBlocks<T, N, Q, Len, N / (2 * Len), N / Len>::inverse(x);
+	}
+};
+
+template <class T, int N, uint32_t Q, int Len>
+struct PolyLayer<T, N, Q, Len, false> {
+	static POLY_INLINE void forward(uint32_t *x) {
+		for (int k = N / (2 * Len); k < N / Len; k++) {
+			poly_ct_block<Q, Len>(x + (k - N / (2 * Len)) * 2 * Len, T::zetas[k], T::zetas_shoup[k]);
+		}
+	}
+
+	static POLY_INLINE void inverse(uint32_t *x) {
+		for (int k = N / (2 * Len); k < N / Len; k++) {
+			poly_gs_block<Q, Len>(x + (k - N / (2 * Len)) * 2 * Len, T::zetas_inv[k], T::zetas_inv_shoup[k]);
+		}
+	}
+};
+
+// layers Len = N / 2 down to the leaf size, then inverse back up
+template <class T, int N, uint32_t Q, int Len, bool Done = (Len < T::leaf)>
+struct PolyLayers {
+	static POLY_INLINE void forward(uint32_t *x) {
+		PolyLayer<T, N, Q, Len>::forward(x);
+		PolyLayers<T, N, Q, Len / 2>::forward(x);
+	}
+
+	static POLY_INLINE void inverse(uint32_t *x) {
+		PolyLayers<T, N, Q, Len / 2>::inverse(x);
+		PolyLayer<T, N, Q, Len>::inverse(x);
+	}
+};
+
+template <class T, int N, uint32_t Q, int Len>
+struct PolyLayers<T, N, Q, Len, true> {
+	static POLY_INLINE void forward(uint32_t *) {}
+	static POLY_INLINE void inverse(uint32_t *) {}
+};
+
+template <int N, uint32_t Q, ntt_mode Mode = NTT_NEGACYCLIC>
+struct Poly {
+	typedef NttConstTables<N, Q, Mode == NTT_NEGACYCLIC> tables;
+
+	uint32_t coeffs[N];
+
+	// in-place transforms of the coefficients
+	void ntt() { forward(coeffs); }
+	void intt() { inverse(coeffs); }
+
+	// out = a . b in the NTT domain, out may alias a or b
+	static void basemul(Poly &out, const Poly &a, const Poly &b) { pointwise(out.coeffs, a.coeffs, b.coeffs); }
+
+	// same operations on plain arrays of N coefficients, the interface of NttPlan
+	static POLY_INLINE void forward(uint32_t *x) {
+		PolyLayers<tables, N, Q, N / 2>::forward(x);
+	}
+
+	static POLY_INLINE void inverse(uint32_t *x) {
+		PolyLayers<tables, N, Q, N / 2>::inverse(x);
+		for (int i = 0; i < N; i++) {
+			x[i] = poly_mul<Q>(x[i], tables::scale, cx_shoup(tables::scale, Q));
+		}
+	}
+
+	static POLY_INLINE void pointwise(uint32_t *out, const uint32_t *a, const uint32_t *b) {
+		if (tables::leaf == 1) {
+			for (int i = 0; i < N; i++) {
+				out[i] = (uint32_t)((uint64_t)a[i] * b[i] % Q);
+			}
+			return;
+		}
+
+		for (int i = 0; i < N / 2; i++) {
+			uint64_t a0 = a[2*i], a1 = a[2*i+1];
+			uint64_t b0 = b[2*i], b1 = b[2*i+1];
+
+			uint64_t a1b1 = a1 * b1 % Q;
+			out[2*i] = (uint32_t)((a0 * b0 + a1b1 * tables::leaf_w[i]) % Q);
+			out[2*i+1] = (uint32_t)((a0 * b1 + a1 * b0) % Q);
+		}
+	}
+
+	// out = a * b mod (x^N -/+ 1), tmp must hold N coefficients
+	// out may alias a, tmp must not alias anything
+	static void multiply(uint32_t *out, const uint32_t *a, const uint32_t *b, uint32_t *tmp) {
+		for (int i = 0; i < N; i++) {
+			tmp[i] = b[i];
+		}
+		if (out != a) {
+			for (int i = 0; i < N; i++) {
+				out[i] = a[i];
+			}
+		}
+
+		forward(out);
+		forward(tmp);
+		pointwise(out, out, tmp);
+		inverse(out);
+	}
+};
+
+#endif
@@ -0,0 +1,146 @@
+/*
+ * NTT_reduce.h
+ *
+ * Description
+ * Modular reduction policies for the butterflies of NttPlanT (NTT_plan.h)
+ * Every policy works on uint32_t values for an odd q below 2^31 and provides
+ *
+ *   twiddle            precomputed form of a constant multiplier
+ *   prepare(w)         w in [0, q) -> twiddle
+ *   mul(a, t)          a * w mod q for any a < 2^32, result in [0, 2q)
+ *                      (lazy, the caller decides when to fold it back to [0, q))
+ *   mulmod(a, b)       a * b mod q for a, b in [0, q), result in [0, q)
+ *
+ *   ModReduce          hardware % by q, the reduction used by NTT_NWC.cpp
+ *   BarrettReduce      floor(2^64 / q) precomputed, one 64x64 high multiply
+ *   MontgomeryReduce   R = 2^32, twiddles kept in Montgomery form w * R mod q
+ *   ShoupReduce        twiddle carries floor(w * 2^32 / q), one 32x32 high multiply
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * */
+
+#ifndef NTT_REDUCE_H
+#define NTT_REDUCE_H
+
+#include <stdint.h>
+
+static inline uint32_t csub(uint32_t a, uint32_t m) {
+	// a in [0, 2m) -> [0, m), m <= 2^31, without a branch on random data
+	uint32_t r = a - m;
+	return r + (m & (0 - (r >> 31)));
+}
+
+struct ModReduce {
+	typedef uint32_t twiddle;
+
+	uint32_t q;
+
+	explicit ModReduce(uint32_t q) : q(q) {}
+
+	twiddle prepare(uint32_t w) const { return w; }
+
+	uint32_t mul(uint32_t a, twiddle w) const {
+		return (uint32_t)((uint64_t)a * w % q);
+	}
+
+	uint32_t mulmod(uint32_t a, uint32_t b) const {
+		return (uint32_t)((uint64_t)a * b % q);
+	}
+
+	static const char *name() { return "mod"; }
+};
+
+struct BarrettReduce {
+	typedef uint32_t twiddle;
+
+	uint32_t q;
+	uint64_t mu;	// floor(2^64 / q)
+
+	explicit BarrettReduce(uint32_t q) : q(q), mu(~(uint64_t)0 / q) {}
+
+	twiddle prepare(uint32_t w) const { return w; }
+
+	uint32_t reduce(uint64_t x) const {
+		// the estimate of x / q is short by at most 1
+		uint64_t qhat = (uint64_t)(((unsigned __int128)x * mu) >> 64);
+		return (uint32_t)(x - qhat * q);
+	}
+
+	uint32_t mul(uint32_t a, twiddle w) const {
+		return reduce((uint64_t)a * w);
+	}
+
+	uint32_t mulmod(uint32_t a, uint32_t b) const {
+		return csub(reduce((uint64_t)a * b), q);
+	}
+
+	static const char *name() { return "barrett"; }
+};
+
+struct MontgomeryReduce {
+	typedef uint32_t twiddle;
+
+	uint32_t q;
+	uint32_t qinv;	// -q^-1 mod 2^32
+	uint32_t r2;	// 2^64 mod q
+
+	explicit MontgomeryReduce(uint32_t q) : q(q) {
+		uint32_t inv = q;	// Newton iteration, q * q = 1 mod 8
+		for (int i = 0; i < 4; i++) inv *= 2 - q * inv;
+		qinv = 0 - inv;
+		r2 = (uint32_t)(((unsigned __int128)1 << 64) % q);
+	}
+
+	twiddle prepare(uint32_t w) const {
+		return (uint32_t)(((uint64_t)w << 32) % q);
+	}
+
+	uint32_t redc(uint64_t x) const {
+		// x * 2^-32 mod q, in [0, 2q) for x < q * 2^32
+		uint32_t m = (uint32_t)x * qinv;
+		return (uint32_t)((x + (uint64_t)m * q) >> 32);
+	}
+
+	uint32_t mul(uint32_t a, twiddle w) const {
+		return redc((uint64_t)a * w);
+	}
+
+	uint32_t mulmod(uint32_t a, uint32_t b) const {
+		return csub(redc((uint64_t)redc((uint64_t)a * b) * r2), q);
+	}
+
+	static const char *name() { return "montgomery"; }
+};
+
+struct ShoupReduce {
+	struct twiddle {
+		uint32_t w;
+		uint32_t wp;	// floor(w * 2^32 / q)
+	};
+
+	BarrettReduce barrett;	// for products without a precomputed operand
+	uint32_t q;
+
+	explicit ShoupReduce(uint32_t q) : barrett(q), q(q) {}
+
+	twiddle prepare(uint32_t w) const {
+		twiddle t;
+		t.w = w;
+		t.wp = (uint32_t)(((uint64_t)w << 32) / q);
+		return t;
+	}
+
+	uint32_t mul(uint32_t a, twiddle t) const {
+		uint32_t qhat = (uint32_t)(((uint64_t)a * t.wp) >> 32);
+		return a * t.w - qhat * q;
+	}
+
+	uint32_t mulmod(uint32_t a, uint32_t b) const {
+		return barrett.mulmod(a, b);
+	}
+
+	static const char *name() { return "shoup"; }
+};
+
+#endif
@@ -0,0 +1,118 @@
+/*
+ * NTT_simd.cpp
+ *
+ * Description
+ * Implementation of Ntt16Tables, see NTT_simd.h
+ *
+ * History
+ * 2026/10/17	jorjor	First release, split from NTT_avx2.cpp
+ * */
+
+#include "NTT_simd.h"
+
+#include <stdexcept>
+
+using namespace std;
+
+static int16_t montgomery_form(uint32_t w, uint32_t q) {
+	// w * 2^16 mod q, centered in (-q/2, q/2]
+	int32_t r = (int32_t)(((uint64_t)w << 16) % q);
+	if (r > (int32_t)q / 2) r -= q;
+	return (int16_t)r;
+}
+
+static int16_t times_qinv(int16_t w, int16_t qinv) {
+	return (int16_t)(uint16_t)((uint32_t)(uint16_t)w * (uint16_t)qinv);
+}
+
+static int barrett_shift(uint32_t q) {
+	// 2^(16 + shift) / q stays below 2^15
+	int shift = 0;
+	while ((2u << (shift + 1)) < q) shift++;
+	return shift;
+}
+
+static int lane_position(int lane, int d, int width) {
+	// register pair (a, b) after the shuffle for distance d :
+	// lane of a holds this position of the 2 * width coefficients, lane of b holds position + d
+	int g = lane / (2 * d);
+	int r = lane % (2 * d);
+	return (r < d) ? g * 2 * d + r : width + g * 2 * d + r - d;
+}
+
+bool Ntt16Tables::supported(const NttTables &tab, int width) {
+	if (tab.n < 2 * width || tab.q % 2 == 0) {
+		return false;
+	}
+	if ((uint64_t)(tab.layers + 1) * tab.q >= (1u << 15)) {
+		return false;
+	}
+	uint32_t v = ((1u << (16 + barrett_shift(tab.q))) + tab.q / 2) / tab.q;
+	return v < (1u << 15);
+}
+
+Ntt16Tables::Ntt16Tables(const NttTables &tab, int width)
+	: n(tab.n), leaf(tab.leaf), width(width), small(0) {
+	if (!supported(tab, width)) {
+		throw invalid_argument("Ntt16Tables: parameter set not supported");
+	}
+
+	while ((leaf << small) < width) small++;
+
+	uint32_t Q = tab.q;
+	uint32_t inv = Q;	// Newton iteration, q * q = 1 mod 8
+	for (int i = 0; i < 3; i++) inv *= 2 - Q * inv;
+
+	q = (int16_t)Q;
+	qinv = (int16_t)inv;
+	shift = barrett_shift(Q);
+	barrett = (int16_t)(((1u << (16 + shift)) + Q / 2) / Q);
+	scale = montgomery_form(tab.scale, Q);
+	scale_qinv = times_qinv(scale, qinv);
+	r2 = montgomery_form((uint32_t)((1ull << 16) % Q), Q);
+	r2_qinv = times_qinv(r2, qinv);
+
+	int blocks = (int)tab.zetas.size();
+	zetas.resize(blocks);
+	zetas_qinv.resize(blocks);
+	zetas_inv.resize(blocks);
+	zetas_inv_qinv.resize(blocks);
+	for (int k = 0; k < blocks; k++) {
+		zetas[k] = montgomery_form(tab.zetas[k], Q);
+		zetas_qinv[k] = times_qinv(zetas[k], qinv);
+		zetas_inv[k] = montgomery_form(tab.zetas_inv[k], Q);
+		zetas_inv_qinv[k] = times_qinv(zetas_inv[k], qinv);
+	}
+
+	/* lane twiddles of the small layers for every register pair */
+	int pairs_count = n / (2 * width);
+	lanes.resize(pairs_count * small * width);
+	lanes_qinv.resize(lanes.size());
+	lanes_inv.resize(lanes.size());
+	lanes_inv_qinv.resize(lanes.size());
+	for (int p = 0; p < pairs_count; p++) {
+		for (int l = 0; l < small; l++) {
+			int d = (width / 2) >> l;
+			for (int lane = 0; lane < width; lane++) {
+				int pos = 2 * width * p + lane_position(lane, d, width);
+				int k = n / (2 * d) + pos / (2 * d);
+				int idx = (p * small + l) * width + lane;
+				lanes[idx] = zetas[k];
+				lanes_qinv[idx] = zetas_qinv[k];
+				lanes_inv[idx] = zetas_inv[k];
+				lanes_inv_qinv[idx] = zetas_inv_qinv[k];
+			}
+		}
+	}
+
+	if (leaf == 2) {
+		pairs.resize(n);
+		pairs_qinv.resize(n);
+		for (int i = 0; i < n / 2; i++) {
+			pairs[2*i] = montgomery_form(1, Q);
+			pairs[2*i+1] = montgomery_form(tab.leaf_w[i], Q);
+			pairs_qinv[2*i] = times_qinv(pairs[2*i], qinv);
+			pairs_qinv[2*i+1] = times_qinv(pairs[2*i+1], qinv);
+		}
+	}
+}
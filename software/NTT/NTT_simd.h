@@ -0,0 +1,65 @@
+/*
+ * NTT_simd.h
+ *
+ * Description
+ * int16 Montgomery tables shared by the SIMD kernels (NTT_avx2.h, NTT_avx512.h)
+ * built from the plain tables of NTT_tables.h for a register of `width` int16 lanes
+ * (16 for AVX2, 32 for AVX-512)
+ *
+ * Montgomery form : w * 2^16 mod q, centered in (-q/2, q/2]
+ * every twiddle is stored next to w * 2^16 * q^-1 mod 2^16 for vpmullw
+ *
+ * Layers with a distance of width or more use whole registers, one twiddle per block
+ * The small layers (distance width/2 ... leaf) shuffle a register pair (a, b) so that
+ * lane i of a and lane i of b are butterfly partners, their twiddles are stored per lane
+ *
+ * Supported : n >= 2 * width, odd q with (log2(n / leaf) + 1) * q < 2^15
+ * (the forward layers add up to q per layer without reduction)
+ *
+ * History
+ * 2026/10/17	jorjor	First release, split from NTT_avx2.h
+ * */
+
+#ifndef NTT_SIMD_H
+#define NTT_SIMD_H
+
+#include <stdint.h>
+#include <vector>
+
+#include "NTT_tables.h"
+
+struct Ntt16Tables {
+	static bool supported(const NttTables &tab, int width);
+
+	Ntt16Tables() : n(0), leaf(1), width(0), small(0) {}
+
+	// throws std::invalid_argument when !supported(tab, width)
+	Ntt16Tables(const NttTables &tab, int width);
+
+	int n;
+	int leaf;
+	int width;
+	int small;			// number of shuffled layers, log2(width / leaf)
+
+	int16_t q;
+	int16_t qinv;		// q^-1 mod 2^16
+	int shift;
+	int16_t barrett;	// round(2^(16 + shift) / q), 2^26 / q for Kyber
+	int16_t scale;		// (n / leaf)^-1 in Montgomery form
+	int16_t scale_qinv;
+	int16_t r2;			// 2^32 mod q, fqmul(x, r2) = x * 2^16
+	int16_t r2_qinv;
+
+	// one value per block, for the register layers
+	std::vector<int16_t> zetas, zetas_qinv;
+	std::vector<int16_t> zetas_inv, zetas_inv_qinv;
+
+	// width lanes per register pair and small layer, layer l has distance width / 2 >> l
+	std::vector<int16_t> lanes, lanes_qinv;
+	std::vector<int16_t> lanes_inv, lanes_inv_qinv;
+
+	// leaf = 2 : n lanes, even lane 1 and odd lane leaf_w[i] of pair i
+	std::vector<int16_t> pairs, pairs_qinv;
+};
+
+#endif
@@ -0,0 +1,132 @@
+/*
+ * NTT_stockham.cpp
+ *
+ * Description
+ * Implementation of NttStockham, see NTT_stockham.h
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * */
+
+#include "NTT_stockham.h"
+
+#include <stdexcept>
+
+using namespace std;
+
+static uint32_t powmod(const ShoupReduce &red, uint32_t a, uint64_t e) {
+	uint32_t r = 1;
+	while (e != 0) {
+		if (e & 1) r = red.mulmod(r, a);
+		a = red.mulmod(a, a);
+		e >>= 1;
+	}
+	return r;
+}
+
+static NttTables check_tables(int n, uint32_t q, ntt_mode mode, uint32_t root) {
+	// NttTables checks n, q and the root, and finds one when root = 0
+	NttTables tab(n, q, mode, root);
+	if (tab.leaf != 1) {
+		throw invalid_argument("NttStockham: q - 1 is not divisible by 2n");
+	}
+	return tab;
+}
+
+NttStockham::NttStockham(int n, uint32_t q, ntt_mode mode, uint32_t root)
+	: n_(n), mode_(mode), root_(check_tables(n, q, mode, root).root), red_(q) {
+	// w : order n, psi : order 2n (negacyclic only)
+	uint32_t w = (mode == NTT_CYCLIC) ? root_ : red_.mulmod(root_, root_);
+	uint32_t w_inv = powmod(red_, w, n - 1);
+
+	tw_.resize(n);
+	tw_inv_.resize(n);
+	for (int m = 1; m < n; m <<= 1) {
+		// order 2m : w^(n / 2m)
+		uint32_t wm = powmod(red_, w, n / (2 * m));
+		uint32_t wm_inv = powmod(red_, w_inv, n / (2 * m));
+		uint32_t a = 1, b = 1;
+		for (int p = 0; p < m; p++) {
+			tw_[m + p] = red_.prepare(a);
+			tw_inv_[m + p] = red_.prepare(b);
+			a = red_.mulmod(a, wm);
+			b = red_.mulmod(b, wm_inv);
+		}
+	}
+
+	uint32_t n_inv = powmod(red_, n % q, q - 2);
+	if (mode == NTT_CYCLIC) {
+		untwist_.assign(1, red_.prepare(n_inv));
+		return;
+	}
+	uint32_t psi_inv = powmod(red_, root_, 2 * n - 1);
+	twist_.resize(n);
+	untwist_.resize(n);
+	uint32_t a = 1, b = n_inv;
+	for (int j = 0; j < n; j++) {
+		twist_[j] = red_.prepare(a);
+		untwist_[j] = red_.prepare(b);
+		a = red_.mulmod(a, root_);
+		b = red_.mulmod(b, psi_inv);
+	}
+}
+
+uint32_t *NttStockham::passes(uint32_t *x, uint32_t *tmp, const vector<twiddle> &tw) const {
+	const uint32_t q = red_.q;
+	uint32_t *src = x, *dst = tmp;
+	for (int m = n_ / 2, s = 1; m >= 1; m >>= 1, s <<= 1) {
+		for (int p = 0; p < m; p++) {
+			const twiddle t = tw[m + p];
+			const uint32_t *a = src + s * p;
+			const uint32_t *b = src + s * (p + m);
+			uint32_t *u = dst + 2 * s * p;
+			uint32_t *v = u + s;
+			for (int j = 0; j < s; j++) {
+				u[j] = csub(a[j] + b[j], q);
+				v[j] = csub(red_.mul(a[j] + q - b[j], t), q);
+			}
+		}
+		uint32_t *t = src;
+		src = dst;
+		dst = t;
+	}
+	return src;
+}
+
+void NttStockham::forward(uint32_t *x, uint32_t *tmp) const {
+	const uint32_t q = red_.q;
+	if (mode_ == NTT_NEGACYCLIC) {
+		for (int j = 0; j < n_; j++) {
+			x[j] = csub(red_.mul(x[j], twist_[j]), q);
+		}
+	}
+	uint32_t *y = passes(x, tmp, tw_);
+	if (y != x) {
+		for (int i = 0; i < n_; i++) {
+			x[i] = y[i];
+		}
+	}
+}
+
+void NttStockham::inverse(uint32_t *x, uint32_t *tmp) const {
+	// the scaling (and untwist) pass also moves the result back to x
+	const uint32_t q = red_.q;
+	const uint32_t *y = passes(x, tmp, tw_inv_);
+	if (mode_ == NTT_CYCLIC) {
+		const twiddle t = untwist_[0];
+		for (int j = 0; j < n_; j++) {
+			x[j] = csub(red_.mul(y[j], t), q);
+		}
+	}
+	else {
+		for (int j = 0; j < n_; j++) {
+			x[j] = csub(red_.mul(y[j], untwist_[j]), q);
+		}
+	}
+}
+
+void NttStockham::pointwise(uint32_t *out, const uint32_t *a, const uint32_t *b) const {
+	for (int i = 0; i < n_; i++) {
+		out[i] = red_.mulmod(a[i], b[i]);
+	}
+}
@@ -0,0 +1,71 @@
+/*
+ * NTT_stockham.h
+ *
+ * Description
+ * Stockham auto-sort NTT, natural order in and natural order out
+ * NTT_org.cpp pays for bitreverse() before its loops, NTT_GSCT.cpp, NTT_NWC.cpp
+ * and NttPlan avoid it by leaving the spectrum in bit-reversed order
+ * Every pass reads x and writes y (ping-pong), a = x[q + s p], b = x[q + s (p + m)],
+ * y[q + 2 s p] = a + b, y[q + s (2p + 1)] = (a - b) w^p with w of order 2m,
+ * log2(n) passes from (m, s) = (n / 2, 1) to (1, n / 2), unit stride in q
+ *
+ *   cyclic       X[k] = a(w^k), w of order n
+ *   negacyclic   X[k] = a(psi^(2k + 1)), psi of order 2n : the input is multiplied
+ *                by psi^j first, the output of inverse() by psi^-j n^-1
+ * The incomplete (Kyber-style) negacyclic transform has no Stockham form here,
+ * q - 1 must be divisible by n (cyclic) or 2n (negacyclic)
+ *
+ * Shoup twiddles (NTT_reduce.h), every value stays in [0, q), q an odd prime below 2^31
+ * Invalid parameters throw std::invalid_argument
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * */
+
+#ifndef NTT_STOCKHAM_H
+#define NTT_STOCKHAM_H
+
+#include <stdint.h>
+#include <vector>
+
+#include "NTT_tables.h"
+#include "NTT_reduce.h"
+
+class NttStockham {
+public:
+	// root : element of order n (cyclic) or 2n (negacyclic), 0 = search one
+	NttStockham(int n, uint32_t q, ntt_mode mode, uint32_t root = 0);
+
+	int size() const { return n_; }
+	uint32_t modulus() const { return red_.q; }
+	ntt_mode mode() const { return mode_; }
+	uint32_t root() const { return root_; }
+
+	// in-place transforms on n coefficients in natural order, tmp must hold n values
+	void forward(uint32_t *x, uint32_t *tmp) const;
+	void inverse(uint32_t *x, uint32_t *tmp) const;
+
+	// out = a . b in the NTT domain, out may alias a or b
+	void pointwise(uint32_t *out, const uint32_t *a, const uint32_t *b) const;
+
+private:
+	typedef ShoupReduce::twiddle twiddle;
+
+	// the log2(n) passes, returns the buffer that holds the result
+	uint32_t *passes(uint32_t *x, uint32_t *tmp, const std::vector<twiddle> &tw) const;
+
+	int n_;
+	ntt_mode mode_;
+	uint32_t root_;
+	ShoupReduce red_;
+
+	// pass with m at [m, 2m), w^p and w^-p with w of order 2m
+	std::vector<twiddle> tw_;
+	std::vector<twiddle> tw_inv_;
+
+	// negacyclic : psi^j and psi^-j n^-1, cyclic : n^-1 only
+	std::vector<twiddle> twist_;
+	std::vector<twiddle> untwist_;
+};
+
+#endif
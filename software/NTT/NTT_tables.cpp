@@ -0,0 +1,104 @@
+/*
+ * NTT_tables.cpp
+ *
+ * Description
+ * Implementation of NttTables, see NTT_tables.h
+ * The tables are built like main() of NTT_NWC.cpp, but for any parameter set
+ *
+ * History
+ * 2026/10/17	jorjor	First release, split from NTT_plan.cpp
+ * 2026/10/17	jorjor	bitrev_index() from bitrev.h
+ * 2026/10/17	jorjor	Primality test and root search from NTT_params.h
+ * */
+
+#include "NTT_tables.h"
+#include "NTT_params.h"
+#include "bitrev.h"
+
+#include <stdexcept>
+
+using namespace std;
+
+static uint32_t mulmod(uint32_t a, uint32_t b, uint32_t q) {
+	return (uint32_t)((uint64_t)a * b % q);
+}
+
+static uint32_t quickmod(uint32_t a, uint64_t b, uint32_t q) {
+	// a ** b % q
+	uint32_t ans = 1;
+	while (b != 0) {
+		if (b & 1) ans = mulmod(ans, a, q);
+		a = mulmod(a, a, q);
+		b >>= 1;
+	}
+	return ans;
+}
+
+NttTables::NttTables(int n, uint32_t q, ntt_mode mode, uint32_t root)
+	: n(n), q(q), mode(mode), leaf(1), layers(0), root(root), scale(1) {
+	if (n < 2 || (n & (n - 1)) != 0) {
+		throw invalid_argument("NttPlan: n must be a power of two");
+	}
+	if (q >= (1u << 31) || q % 2 == 0 || !is_prime_u64(q)) {
+		throw invalid_argument("NttPlan: q must be an odd prime below 2^31");
+	}
+
+	// order of the root used by the butterflies
+	uint32_t order;
+	if (mode == NTT_CYCLIC) {
+		order = n;
+	}
+	else if ((q - 1) % (2 * (uint64_t)n) == 0) {
+		order = 2 * n;
+	}
+	else {
+		leaf = 2;
+		order = n;
+	}
+	if (order < 2 || (q - 1) % order != 0) {
+		throw invalid_argument("NttPlan: q - 1 is not divisible by the transform size");
+	}
+
+	while ((leaf << layers) < n) layers++;
+
+	if (root == 0) {
+		this->root = root = (uint32_t)ntt_root_of_unity(q, order);
+	}
+	if (root >= q || quickmod(root, order, q) != 1 || quickmod(root, order / 2, q) != q - 1) {
+		throw invalid_argument("NttPlan: root does not have the required order");
+	}
+
+	/* build the twiddles, block k of the butterfly tree uses zetas[k] */
+	int blocks = 1 << layers;
+	zetas.assign(blocks, 1);
+	zetas_inv.assign(blocks, 1);
+	uint32_t root_inv = quickmod(root, q - 2, q);
+
+	for (int d = 0; d < layers; d++) {
+		for (int i = 0; i < (1 << d); i++) {
+			int k = (1 << d) + i;
+			uint64_t e;
+			if (mode == NTT_CYCLIC) {
+				// x^len - w^2 splits into x^(len/2) -/+ w, starting from w = 1
+				e = (uint64_t)bitrev_index(i, d) << (layers - d - 1);
+			}
+			else {
+				// x^n + 1 is the right half of x^2n - 1
+				e = bitrev_index(k, layers);
+			}
+			zetas[k] = quickmod(root, e, q);
+			zetas_inv[k] = quickmod(root_inv, e, q);
+		}
+	}
+
+	if (leaf == 2) {
+		// pair i is taken modulo x^2 - w, w = +/- zeta of its parent block
+		leaf_w.resize(n / 2);
+		for (int i = 0; i < n / 2; i++) {
+			uint32_t w = zetas[n / 4 + i / 2];
+			leaf_w[i] = (i & 1) ? q - w : w;
+		}
+	}
+
+	scale = quickmod(blocks % q, q - 2, q);
+}
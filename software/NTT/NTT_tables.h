@@ -0,0 +1,41 @@
+/*
+ * NTT_tables.h
+ *
+ * Description
+ * Plain twiddle tables of one NTT parameter set (n, q, cyclic/negacyclic)
+ * built once and shared by the scalar plan (NTT_plan.h) and the SIMD kernels
+ * Invalid parameters throw std::invalid_argument
+ *
+ * History
+ * 2026/10/17	jorjor	First release, split from NTT_plan.h
+ * */
+
+#ifndef NTT_TABLES_H
+#define NTT_TABLES_H
+
+#include <stdint.h>
+#include <vector>
+
+enum ntt_mode {
+	NTT_CYCLIC = 0,		// x^n - 1
+	NTT_NEGACYCLIC		// x^n + 1
+};
+
+struct NttTables {
+	// root : element of order n (cyclic) or 2n / leaf (negacyclic), 0 = search one
+	NttTables(int n, uint32_t q, ntt_mode mode, uint32_t root = 0);
+
+	int n;
+	uint32_t q;
+	ntt_mode mode;
+	int leaf;				// 1 : full NTT, 2 : incomplete NTT with degree-1 leaves
+	int layers;				// log2(n / leaf)
+	uint32_t root;
+	uint32_t scale;			// (n / leaf)^-1 mod q, applied at the end of inverse()
+
+	std::vector<uint32_t> zetas;		// forward twiddles, zetas[k] for butterfly block k
+	std::vector<uint32_t> zetas_inv;	// inverse of zetas[k]
+	std::vector<uint32_t> leaf_w;		// x^2 - leaf_w[i] for pair i (leaf = 2 only)
+};
+
+#endif
@@ -0,0 +1,166 @@
+/*
+ * NTT_tft.cpp
+ *
+ * Description
+ * Implementation of NttTft, see NTT_tft.h
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * */
+
+#include "NTT_tft.h"
+#include "NTT_params.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace std;
+
+static int check_size(int n) {
+	if (n < 2 || (n & (n - 1)) != 0) {
+		throw invalid_argument("NttTft: n must be a power of 2, at least 2");
+	}
+	return n;
+}
+
+NttTft::NttTft(int n, uint32_t q, cpu_isa isa) : n_(check_size(n)), red_(q) {
+	// the plan of size n checks q and finds w
+	NttPlan top(n, q, NTT_CYCLIC, 0, isa);
+	uint32_t w = top.root();
+	uint32_t w_inv = (uint32_t)inverse_mod(w, q);
+
+	half_ = red_.prepare((q + 1) / 2);
+	w_.resize(n / 2);
+	w_inv_.resize(n / 2);
+	uint32_t p = 1, p_inv = 1;
+	for (int j = 0; j < n / 2; j++) {
+		w_[j] = red_.prepare(p);
+		w_inv_[j] = red_.prepare(p_inv);
+		p = red_.mulmod(p, w);
+		p_inv = red_.mulmod(p_inv, w_inv);
+	}
+
+	for (int size = 2; size < n; size <<= 1) {
+		plans_.push_back(NttPlan(size, q, NTT_CYCLIC, (uint32_t)powmod_u64(w, n / size, q), isa));
+	}
+	plans_.push_back(top);
+}
+
+int NttTft::transform_size(int len) {
+	int n = 2;
+	while (n < len) n <<= 1;
+	return n;
+}
+
+void NttTft::forward_rec(uint32_t *x, int n, int z, int m) const {
+	if (m <= 0 || n == 1) return;
+	if (m == n) {
+		// every output wanted
+		int k = 0;
+		while ((2 << k) < n) k++;
+		plans_[k].forward_padded(x, max(z, 1));
+		return;
+	}
+
+	const uint32_t q = red_.q;
+	const int h = n / 2;
+	const int stride = n_ / n;
+	const int zh = min(z, h);
+	if (m <= h) {
+		// y0 only, x[j + h] = 0 from z on
+		for (int j = 0; j < z - h; j++) {
+			x[j] = csub(x[j] + x[j + h], q);
+		}
+		forward_rec(x, h, zh, m);
+		return;
+	}
+
+	// BFU_GS, both halves are zero from zh on
+	for (int j = 0; j < zh; j++) {
+		uint32_t u = x[j];
+		uint32_t v = (j + h < z) ? x[j + h] : 0;
+		x[j] = csub(u + v, q);
+		x[j + h] = csub(red_.mul(u + q - v, w_[j * stride]), q);
+	}
+	forward_rec(x, h, zh, h);
+	forward_rec(x + h, h, zh, m - h);
+}
+
+void NttTft::inverse_rec(uint32_t *x, int n, int m) const {
+	if (m <= 0 || n == 1) return;
+	if (m == n) {
+		int k = 0;
+		while ((2 << k) < n) k++;
+		plans_[k].inverse(x);
+		return;
+	}
+
+	const uint32_t q = red_.q;
+	const int h = n / 2;
+	const int stride = n_ / n;
+	if (m < h) {
+		// y0 = u + v where u is known, then u = y0 - v everywhere
+		for (int j = m; j < h; j++) {
+			x[j] = csub(x[j] + x[j + h], q);
+		}
+		inverse_rec(x, h, m);
+		for (int j = 0; j < h; j++) {
+			x[j] = csub(x[j] + q - x[j + h], q);
+		}
+		return;
+	}
+
+	// y0 from the complete first half, y1 = (y0 - 2v) w^j where v is known
+	inverse_rec(x, h, h);
+	for (int j = m - h; j < h; j++) {
+		uint32_t v2 = csub(x[j + h] + x[j + h], q);
+		x[j + h] = csub(red_.mul(x[j] + q - v2, w_[j * stride]), q);
+	}
+	inverse_rec(x + h, h, m - h);
+
+	// BFU_CT with the 1 / 2 of this layer
+	for (int j = 0; j < h; j++) {
+		uint32_t y0 = x[j];
+		uint32_t t = csub(red_.mul(x[j + h], w_inv_[j * stride]), q);
+		x[j] = csub(red_.mul(csub(y0 + t, q), half_), q);
+		x[j + h] = csub(red_.mul(y0 + q - t, half_), q);
+	}
+}
+
+void NttTft::forward(uint32_t *x, int z, int m) const {
+	if (z < 0 || z > n_ || m < 0 || m > n_) {
+		throw invalid_argument("NttTft: z and m must be in [0, n]");
+	}
+	forward_rec(x, n_, z, m);
+}
+
+void NttTft::inverse(uint32_t *x, int m) const {
+	if (m < 0 || m > n_) {
+		throw invalid_argument("NttTft: m must be in [0, n]");
+	}
+	inverse_rec(x, n_, m);
+}
+
+void NttTft::multiply(uint32_t *out, const uint32_t *a, int la, const uint32_t *b, int lb, uint32_t *tmp) const {
+	if (la < 1 || lb < 1 || (long long)la + lb - 1 > n_) {
+		throw invalid_argument("NttTft: la + lb - 1 must be in [1, n]");
+	}
+	const int len = la + lb - 1;
+	const int n = transform_size(len);
+	uint32_t *x = tmp;
+	uint32_t *y = tmp + n;
+	copy(a, a + la, x);
+	fill(x + la, x + n, 0);
+	copy(b, b + lb, y);
+	fill(y + lb, y + n, 0);
+
+	// the sub-block of size n uses w^(n_ / n), the stride of its twiddles
+	forward_rec(x, n, la, len);
+	forward_rec(y, n, lb, len);
+	for (int i = 0; i < len; i++) {
+		x[i] = red_.mulmod(x[i], y[i]);
+	}
+	fill(x + len, x + n, 0);
+	inverse_rec(x, n, len);
+	copy(x, x + len, out);
+}
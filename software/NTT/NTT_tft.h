@@ -0,0 +1,78 @@
+/*
+ * NTT_tft.h
+ *
+ * Description
+ * Truncated NTT (van der Hoeven's truncated Fourier transform) on the GS / CT
+ * butterflies of NTT_GSCT.cpp. A product of la + lb - 1 = 2^k + 1 coefficients
+ * pays a full 2^(k+1) transform with NttPlan, here the cost follows the length :
+ *
+ *   forward(x, z, m)   x[z, n) zero, the first m values of the cyclic NTT in
+ *                      bit-reversed order (the order of NttPlan::forward()).
+ *                      One GS layer y0 = u + v, y1 = (u - v) w^j splits the block,
+ *                      y0 gives the first half of the outputs and y1 the second,
+ *                      a half without wanted outputs is not computed
+ *   inverse(x, m)      x[0, m) the first m values of forward(), x[m, n) the input
+ *                      values at those positions (zero for a product) : the input
+ *                      values at [0, m) into x[0, m). Per layer either the first
+ *                      half of the outputs is complete (inverse of the half,
+ *                      then the second half from y1 = (y0 - 2v) w^j on its known
+ *                      inputs) or not (y0 = u + v on the known inputs, then the
+ *                      first half alone), the CT layer u, v = (y0 +- y1 w^-j) / 2
+ *                      closes it
+ *   multiply           out = a * b of la + lb - 1 <= n coefficients, the transforms
+ *                      on the power of 2 above la + lb - 1 truncated to la + lb - 1
+ * Blocks whose outputs are all wanted run the cyclic NttPlan of their size
+ * (forward_padded() / inverse()), only the layers above them are truncated,
+ * so the cost is about that of an NttPlan on la + lb - 1 points
+ *
+ * All coefficients are uint32_t in [0, q), q must be an odd prime below 2^31
+ * with n | q - 1. The object is read-only after construction and can be shared
+ * between threads
+ * Invalid parameters throw std::invalid_argument
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * */
+
+#ifndef NTT_TFT_H
+#define NTT_TFT_H
+
+#include <stdint.h>
+#include <vector>
+
+#include "NTT_plan.h"
+
+class NttTft {
+public:
+	// n : largest transform size, a power of 2
+	NttTft(int n, uint32_t q, cpu_isa isa = ISA_AUTO);
+
+	int size() const { return n_; }
+	uint32_t modulus() const { return red_.q; }
+
+	// 0 <= z <= n, 0 <= m <= n, x holds n values
+	void forward(uint32_t *x, int z, int m) const;
+	void inverse(uint32_t *x, int m) const;
+
+	// out = a * b, la + lb - 1 <= n coefficients, out may alias a or b
+	// tmp must hold 2 * transform_size(la + lb - 1) coefficients
+	void multiply(uint32_t *out, const uint32_t *a, int la, const uint32_t *b, int lb, uint32_t *tmp) const;
+
+	// the power of 2 above len the truncated transforms of multiply() run on
+	static int transform_size(int len);
+
+private:
+	typedef ShoupReduce::twiddle twiddle;
+
+	void forward_rec(uint32_t *x, int n, int z, int m) const;
+	void inverse_rec(uint32_t *x, int n, int m) const;
+
+	int n_;
+	ShoupReduce red_;
+	twiddle half_;				// 2^-1
+	std::vector<twiddle> w_;		// w^j, j < n / 2, w of order n
+	std::vector<twiddle> w_inv_;
+	std::vector<NttPlan> plans_;	// plans_[k] : cyclic, size 2^(k + 1), root w^(n / 2^(k + 1))
+};
+
+#endif
@@ -0,0 +1,181 @@
+/*
+ * FFT_bench.cpp
+ *
+ * Description
+ * This program compares FftPlan (FFT_plan.h) with the scalar, AVX2 and AVX-512
+ * stages of FFT_kernels.h, and the loops of main() in FFT_GSCT.cpp that call
+ * W() for every butterfly, for n = 2^6 ... 2^16
+ * Every ISA is first checked against the scalar plan (max abs error / n),
+ * then forward + inverse is timed
+ * The second table is one cyclic convolution of two real inputs,
+ * multiply() on complex copies with imag 0 against multiply_real()
+ *
+ * Using "make bench" to compile the cpp file
+ * and using "./build/FFT_bench.out" to run the program
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * 2026/10/17	jorjor	FftPlan twiddle tables, W() per butterfly as reference
+ * 2026/10/17	jorjor	Real convolution
+ * */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+
+#include "FFT_plan.h"
+
+using namespace std;
+
+static Complex W(int m, int n, bool inverse) {
+	// W() of FFT_GSCT.cpp
+	double a = 2 * acos(-1) * m / n;
+	return Complex(cos(a), inverse ? sin(a) : -sin(a));
+}
+
+static void fft_w(Complex *x, int n) {
+	// DIF, twiddle computed for every butterfly
+	for (int len = n; len >= 2; len >>= 1) {
+		for (int s = 0; s < n; s += len) {
+			for (int d = 0; d < len / 2; d++) {
+				Complex w = W(d, len, false);
+				Complex t = x[s + d] - x[s + d + len / 2];
+				x[s + d] += x[s + d + len / 2];
+				x[s + d + len / 2] = t * w;
+			}
+		}
+	}
+}
+
+static void ifft_w(Complex *x, int n) {
+	for (int len = 2; len <= n; len <<= 1) {
+		for (int s = 0; s < n; s += len) {
+			for (int d = 0; d < len / 2; d++) {
+				Complex t = W(d, len, true) * x[s + d + len / 2];
+				x[s + d + len / 2] = x[s + d] - t;
+				x[s + d] += t;
+			}
+		}
+	}
+	for (int i = 0; i < n; i++) x[i] /= n;
+}
+
+// best of 5 rounds of forward + inverse, ns per transform
+template <class F, class G>
+double time_pair(F fwd, G inv, int n, int lg) {
+	int iters = max(1, (1 << 22) / (n * lg));
+	double ns = 0;
+	for (int round = 0; round < 5; round++) {
+		chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+		for (int i = 0; i < iters; i++) {
+			fwd();
+			inv();
+		}
+		chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+		double t = chrono::duration<double, nano>(t1 - t0).count() / iters / 2;
+		if (round == 0 || t < ns) ns = t;
+	}
+	return ns;
+}
+
+// best of 5 rounds, ns per call
+template <class F>
+double time_op(F op, int n, int lg) {
+	int iters = max(1, (1 << 21) / (n * lg));
+	double ns = 0;
+	for (int round = 0; round < 5; round++) {
+		chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+		for (int i = 0; i < iters; i++) {
+			op();
+		}
+		chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+		double t = chrono::duration<double, nano>(t1 - t0).count() / iters;
+		if (round == 0 || t < ns) ns = t;
+	}
+	return ns;
+}
+
+static double max_error(const vector<Complex> &a, const vector<Complex> &b) {
+	double e = 0;
+	for (size_t i = 0; i < a.size(); i++) {
+		e = max(e, abs(a[i] - b[i]));
+	}
+	return e;
+}
+
+int main() {
+	cout << "CPU : " << cpu_isa_name(cpu_detect_isa())
+		 << ", selected : " << cpu_isa_name(cpu_select_isa()) << endl << endl;
+
+	/* set seed to 0 */
+	srand(0);
+
+	cout << setw(8) << "n" << setw(14) << "W()";
+	for (int isa = ISA_SCALAR; isa <= cpu_detect_isa(); isa++) {
+		cout << setw(14) << cpu_isa_name((cpu_isa)isa);
+	}
+	cout << "   ns/transform, max error / n against the scalar plan" << endl;
+
+	for (int lg = 6; lg <= 16; lg += 2) {
+		int n = 1 << lg;
+		vector<Complex> a(n);
+		for (int i = 0; i < n; i++) {
+			a[i] = Complex(rand() % 1000, rand() % 1000);
+		}
+
+		FftPlan scalar(n, ISA_SCALAR);
+		vector<Complex> ref = a;
+		scalar.forward(ref.data());
+
+		vector<Complex> x = a;
+		fft_w(x.data(), n);
+		double worst = max_error(x, ref) / n;
+		double ns = time_pair([&]() { fft_w(x.data(), n); }, [&]() { ifft_w(x.data(), n); }, n, lg);
+		cout << setw(8) << n << setw(14) << fixed << setprecision(1) << ns;
+
+		for (int isa = ISA_SCALAR; isa <= cpu_detect_isa(); isa++) {
+			FftPlan plan(n, (cpu_isa)isa);
+			x = a;
+			plan.forward(x.data());
+			worst = max(worst, max_error(x, ref) / n);
+
+			ns = time_pair([&]() { plan.forward(x.data()); }, [&]() { plan.inverse(x.data()); }, n, lg);
+			cout << setw(14) << fixed << setprecision(1) << ns;
+		}
+		cout << "   " << scientific << setprecision(1) << worst << (worst < 1e-12 ? "" : "   MISMATCH") << endl;
+	}
+
+	cout << endl << setw(8) << "n" << setw(14) << "complex" << setw(14) << "real" << setw(10) << "speedup"
+		 << "   ns/convolution, max error against the complex result" << endl;
+
+	for (int lg = 6; lg <= 16; lg += 2) {
+		int n = 1 << lg;
+		vector<double> a(n), b(n), c(n);
+		vector<Complex> ca(n), cb(n), cc(n), tmp(n);
+		for (int i = 0; i < n; i++) {
+			a[i] = rand() % 1000;
+			b[i] = rand() % 1000;
+			ca[i] = a[i];
+			cb[i] = b[i];
+		}
+
+		FftPlan plan(n);
+		plan.multiply(cc.data(), ca.data(), cb.data(), tmp.data());
+		plan.multiply_real(c.data(), a.data(), b.data(), tmp.data());
+		double worst = 0;
+		for (int i = 0; i < n; i++) {
+			worst = max(worst, fabs(c[i] - cc[i].real()));
+		}
+
+		double ns_c = time_op([&]() { plan.multiply(cc.data(), ca.data(), cb.data(), tmp.data()); }, n, lg);
+		double ns_r = time_op([&]() { plan.multiply_real(c.data(), a.data(), b.data(), tmp.data()); }, n, lg);
+		cout << setw(8) << n << fixed << setprecision(1) << setw(14) << ns_c << setw(14) << ns_r
+			 << setw(10) << setprecision(2) << ns_c / ns_r
+			 << "   " << scientific << setprecision(1) << worst << (worst < 1e-6 ? "" : "   MISMATCH") << endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,91 @@
+/*
+ * FFT_fourstep_bench.cpp
+ *
+ * Description
+ * This program compares the cache-blocked FftFourStep (FFT_fourstep.h) with FftPlan
+ * (FFT_plan.h) for n = 2^12 ... 2^24, all with the selected ISA
+ * "radix-2" is FftPlan with the stage loops of FFT_GSCT.cpp, a sweep of the array per stage,
+ * "split" is the default split-radix FftPlan, depth first
+ * The time is given per element and stage, ns / (n log2(n)), which stays flat
+ * while the transform runs from the cache and grows once every stage streams from DRAM
+ * The four-step output is first checked against FftPlan (max abs error / n)
+ *
+ * Using "make bench" to compile the cpp file
+ * and using "./build/FFT_fourstep_bench.out" to run the program
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+
+#include "FFT_fourstep.h"
+
+using namespace std;
+
+// best of 5 rounds of forward + inverse, ns per transform
+template <class F, class G>
+double time_pair(F fwd, G inv, int n, int lg) {
+	int iters = max(1, (1 << 24) / (n * lg));
+	double ns = 0;
+	for (int round = 0; round < 5; round++) {
+		chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+		for (int i = 0; i < iters; i++) {
+			fwd();
+			inv();
+		}
+		chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+		double t = chrono::duration<double, nano>(t1 - t0).count() / iters / 2;
+		if (round == 0 || t < ns) ns = t;
+	}
+	return ns;
+}
+
+int main() {
+	cout << "ISA : " << cpu_isa_name(cpu_select_isa()) << endl << endl;
+	cout << setw(4) << "lg" << setw(14) << "n1 x n2" << setw(10) << "radix-2" << setw(10) << "split"
+		 << setw(12) << "four-step" << setw(10) << "/ r2" << setw(10) << "/ split"
+		 << "   ns / (n log2 n), speedup of four-step, max error / n" << endl;
+
+	/* set seed to 0 */
+	srand(0);
+
+	for (int lg = 12; lg <= 24; lg++) {
+		int n = 1 << lg;
+		vector<Complex> a(n), tmp(n);
+		for (int i = 0; i < n; i++) {
+			a[i] = Complex(rand() % 1000, rand() % 1000);
+		}
+
+		double r2_ns, plan_ns, four_ns, worst = 0;
+		{
+			FftPlan r2(n, ISA_AUTO, FFT_RADIX2);
+			FftPlan plan(n);
+			FftFourStep four(n);
+			vector<Complex> ref = a, x = a;
+			plan.forward(ref.data());
+			four.forward(x.data(), tmp.data());
+			for (int i = 0; i < n; i++) {
+				worst = max(worst, abs(x[i] - ref[i]) / n);
+			}
+
+			r2_ns = time_pair([&]() { r2.forward(x.data()); }, [&]() { r2.inverse(x.data()); }, n, lg);
+			plan_ns = time_pair([&]() { plan.forward(x.data()); }, [&]() { plan.inverse(x.data()); }, n, lg);
+			four_ns = time_pair([&]() { four.forward(x.data(), tmp.data()); },
+								[&]() { four.inverse(x.data(), tmp.data()); }, n, lg);
+
+			cout << setw(4) << lg << setw(8) << four.rows() << " x " << left << setw(5) << four.cols() << right;
+		}
+		double scale = 1.0 / ((double)n * lg);
+		cout << fixed << setprecision(3) << setw(8) << r2_ns * scale << setw(10) << plan_ns * scale
+			 << setw(12) << four_ns * scale << setw(10) << setprecision(2) << r2_ns / four_ns
+			 << setw(10) << plan_ns / four_ns
+			 << "   " << scientific << setprecision(1) << worst << (worst < 1e-12 ? "" : "   MISMATCH") << endl;
+	}
+
+	return 0;
+}
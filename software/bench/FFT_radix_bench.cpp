@@ -0,0 +1,98 @@
+/*
+ * FFT_radix_bench.cpp
+ *
+ * Description
+ * This program compares the radix-2, radix-4 and split-radix FftPlan (FFT_plan.h)
+ * for n = 2^6 ... 2^22 : flops of one transform and forward + inverse wall time
+ * Every radix is first checked against the radix-2 plan (max abs error / n)
+ * The kernels are the ones of cpu_select_isa(), FFTNTT_ISA=scalar compares the scalar code
+ *
+ * Using "make bench" to compile the cpp file
+ * and using "./build/FFT_radix_bench.out" to run the program
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+
+#include "FFT_plan.h"
+
+using namespace std;
+
+// best of 5 rounds of forward + inverse, ns per transform
+static double time_plan(const FftPlan &plan, vector<Complex> &x) {
+	int n = plan.size();
+	int iters = max(1, (1 << 23) / (n * plan.log2n()));
+	double ns = 0;
+	for (int round = 0; round < 5; round++) {
+		chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+		for (int i = 0; i < iters; i++) {
+			plan.forward(x.data());
+			plan.inverse(x.data());
+		}
+		chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+		double t = chrono::duration<double, nano>(t1 - t0).count() / iters / 2;
+		if (round == 0 || t < ns) ns = t;
+	}
+	return ns;
+}
+
+int main() {
+	const char *names[] = { "radix-2", "radix-4", "split" };
+
+	cout << "ISA : " << cpu_isa_name(cpu_select_isa()) << endl << endl;
+	cout << setw(4) << "lg";
+	for (int r = 0; r < 3; r++) {
+		cout << setw(12) << names[r] << " Mflop";
+	}
+	for (int r = 0; r < 3; r++) {
+		cout << setw(12) << names[r] << " us";
+	}
+	cout << setw(10) << "r4 / r2" << setw(10) << "sr / r2" << endl;
+
+	/* set seed to 0 */
+	srand(0);
+
+	for (int lg = 6; lg <= 22; lg++) {
+		int n = 1 << lg;
+		vector<Complex> a(n);
+		for (int i = 0; i < n; i++) {
+			a[i] = Complex(rand() % 1000, rand() % 1000);
+		}
+
+		double flops[3], us[3], worst = 0;
+		vector<Complex> ref;
+		for (int r = 0; r < 3; r++) {
+			FftPlan plan(n, ISA_AUTO, (fft_radix)r);
+			vector<Complex> x = a;
+			plan.forward(x.data());
+			if (r == 0) {
+				ref = x;
+			}
+			for (int i = 0; i < n; i++) {
+				worst = max(worst, abs(x[i] - ref[i]) / n);
+			}
+
+			flops[r] = plan.flops();
+			us[r] = time_plan(plan, x) / 1000;
+		}
+
+		cout << setw(4) << lg << fixed;
+		for (int r = 0; r < 3; r++) {
+			cout << setw(18) << setprecision(3) << flops[r] / 1e6;
+		}
+		for (int r = 0; r < 3; r++) {
+			cout << setw(15) << setprecision(1) << us[r];
+		}
+		cout << setw(10) << setprecision(2) << us[1] / us[0]
+			 << setw(10) << us[2] / us[0]
+			 << (worst < 1e-12 ? "" : "   MISMATCH") << endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,112 @@
+/*
+ * FFT_soa_bench.cpp
+ *
+ * Description
+ * This program compares the split-complex FftSoaPlan (FFT_soa.h) with the
+ * interleaved FftPlan (FFT_plan.h) for n = 2^6 ... 2^16
+ * The reference is the scalar radix-2 FftPlan, "interleaved" is FftPlan with the
+ * selected ISA and the default radix, "+ convert" adds fft_split() / fft_merge()
+ * to the best split-complex kernel, as a caller of the Complex API would pay it
+ * Every kernel is first checked against the reference (max abs error / n)
+ *
+ * Using "make bench" to compile the cpp file
+ * and using "./build/FFT_soa_bench.out" to run the program
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+
+#include "FFT_plan.h"
+#include "FFT_soa.h"
+
+using namespace std;
+
+// best of 5 rounds of forward + inverse, ns per transform
+template <class F, class G>
+double time_pair(F fwd, G inv, int n, int lg) {
+	int iters = max(1, (1 << 22) / (n * lg));
+	double ns = 0;
+	for (int round = 0; round < 5; round++) {
+		chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+		for (int i = 0; i < iters; i++) {
+			fwd();
+			inv();
+		}
+		chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+		double t = chrono::duration<double, nano>(t1 - t0).count() / iters / 2;
+		if (round == 0 || t < ns) ns = t;
+	}
+	return ns;
+}
+
+int main() {
+	cpu_isa best = cpu_select_isa();
+	cout << "CPU : " << cpu_isa_name(cpu_detect_isa())
+		 << ", selected : " << cpu_isa_name(best) << endl << endl;
+
+	/* set seed to 0 */
+	srand(0);
+
+	cout << setw(8) << "n" << setw(14) << "radix-2" << setw(14) << "interleaved";
+	for (int isa = ISA_SCALAR; isa <= best; isa++) {
+		cout << setw(10) << "soa " << setw(4) << cpu_isa_name((cpu_isa)isa);
+	}
+	cout << setw(14) << "+ convert" << setw(10) << "speedup"
+		 << "   ns/transform, speedup of soa " << cpu_isa_name(best) << " over radix-2" << endl;
+
+	for (int lg = 6; lg <= 16; lg += 2) {
+		int n = 1 << lg;
+		vector<Complex> a(n);
+		for (int i = 0; i < n; i++) {
+			a[i] = Complex(rand() % 1000, rand() % 1000);
+		}
+
+		FftPlan scalar(n, ISA_SCALAR, FFT_RADIX2);
+		vector<Complex> ref = a, x = a;
+		scalar.forward(ref.data());
+		double r2 = time_pair([&]() { scalar.forward(x.data()); }, [&]() { scalar.inverse(x.data()); }, n, lg);
+
+		FftPlan plan(n);
+		x = a;
+		double inter = time_pair([&]() { plan.forward(x.data()); }, [&]() { plan.inverse(x.data()); }, n, lg);
+		cout << setw(8) << n << fixed << setprecision(1) << setw(14) << r2 << setw(14) << inter;
+
+		vector<double> re(n), im(n);
+		double worst = 0, soa = 0;
+		for (int isa = ISA_SCALAR; isa <= best; isa++) {
+			FftSoaPlan sp(n, (cpu_isa)isa);
+			fft_split(re.data(), im.data(), a.data(), n);
+			sp.forward(re.data(), im.data());
+			fft_merge(x.data(), re.data(), im.data(), n);
+			for (int i = 0; i < n; i++) {
+				worst = max(worst, abs(x[i] - ref[i]) / n);
+			}
+
+			soa = time_pair([&]() { sp.forward(re.data(), im.data()); },
+							[&]() { sp.inverse(re.data(), im.data()); }, n, lg);
+			cout << setw(14) << soa;
+		}
+
+		FftSoaPlan sp(n, best);
+		x = a;
+		double conv = time_pair([&]() {
+			fft_split(re.data(), im.data(), x.data(), n);
+			sp.forward(re.data(), im.data());
+			fft_merge(x.data(), re.data(), im.data(), n);
+		}, [&]() {
+			fft_split(re.data(), im.data(), x.data(), n);
+			sp.inverse(re.data(), im.data());
+			fft_merge(x.data(), re.data(), im.data(), n);
+		}, n, lg);
+		cout << setw(14) << conv << setw(10) << setprecision(2) << r2 / soa
+			 << "   " << scientific << setprecision(1) << worst << (worst < 1e-12 ? "" : "   MISMATCH") << endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,126 @@
+/*
+ * NTT_batch_bench.cpp
+ *
+ * Description
+ * This program compares the lane-per-polynomial batch (NTT_batch.h) with the
+ * horizontal kernels of NttPlan, one polynomial at a time, on many independent
+ * n = 256 multiplications (Kyber, q = 3329 and a 30-bit prime, q = 998244353)
+ * Every batch ISA is first checked against NttPlan, then the throughput of
+ * multiply() (transposes included) and of forward() is reported in polynomials / second
+ *
+ * Using "make bench" to compile the cpp file
+ * and using "./build/NTT_batch_bench.out" to run the program
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+
+#include "NTT_plan.h"
+#include "NTT_batch.h"
+
+using namespace std;
+
+struct Param {
+	const char *name;
+	int n;
+	uint32_t q;
+	ntt_mode mode;
+	uint32_t root;
+};
+
+static const int COUNT = 4096;	// polynomials per batch
+
+// best of 5 rounds, seconds per call
+template <class F>
+double best_time(F f) {
+	double best = 0;
+	for (int round = 0; round < 5; round++) {
+		chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+		f();
+		chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+		double t = chrono::duration<double>(t1 - t0).count();
+		if (round == 0 || t < best) best = t;
+	}
+	return best;
+}
+
+static void report(const char *name, int width, double mul_s, double fwd_s, bool ok) {
+	cout << setw(16) << name << setw(6) << width
+		 << setw(16) << fixed << setprecision(0) << COUNT / mul_s
+		 << setw(16) << COUNT / fwd_s
+		 << (ok ? "" : "   MISMATCH") << endl;
+}
+
+int main() {
+	Param params[] = {
+		{ "Kyber", 256, 3329, NTT_NEGACYCLIC, 17 },
+		{ "30-bit prime", 256, 998244353, NTT_NEGACYCLIC, 0 },
+	};
+
+	/* set seed to 0 */
+	srand(0);
+
+	for (size_t i = 0; i < sizeof(params) / sizeof(params[0]); i++) {
+		const Param &p = params[i];
+		const int n = p.n;
+		vector<uint32_t> a((size_t)COUNT * n), b((size_t)COUNT * n);
+		for (size_t j = 0; j < a.size(); j++) {
+			a[j] = rand() % p.q;
+			b[j] = rand() % p.q;
+		}
+
+		cout << "***** " << p.name << " : n = " << n << ", q = " << p.q
+			 << ", " << COUNT << " polynomials *****" << endl;
+		cout << setw(16) << "kernel" << setw(6) << "lanes"
+			 << setw(16) << "multiply/s" << setw(16) << "forward/s" << endl;
+
+		/* horizontal : one polynomial per call */
+		NttPlan plan(n, p.q, p.mode, p.root);
+		vector<uint32_t> ref((size_t)COUNT * n), tmp(n);
+		double mul_s = best_time([&]() {
+			for (int c = 0; c < COUNT; c++) {
+				plan.multiply(&ref[(size_t)c * n], &a[(size_t)c * n], &b[(size_t)c * n], tmp.data());
+			}
+		});
+		vector<uint32_t> x = a;
+		double fwd_s = best_time([&]() {
+			for (int c = 0; c < COUNT; c++) {
+				plan.forward(&x[(size_t)c * n]);
+			}
+		});
+		string name = string("plan ") + cpu_isa_name(plan.isa());
+		report(name.c_str(), 1, mul_s, fwd_s, true);
+
+		/* vertical : width polynomials per call */
+		for (int isa = ISA_SCALAR; isa <= cpu_detect_isa(); isa++) {
+			NttBatch batch(n, p.q, p.mode, p.root, (cpu_isa)isa);
+			const int W = batch.width();
+			vector<uint32_t> out((size_t)COUNT * n), btmp(2 * (size_t)W * n);
+
+			batch.multiply(out.data(), a.data(), b.data(), COUNT, btmp.data());
+			bool ok = (out == ref);
+
+			mul_s = best_time([&]() {
+				batch.multiply(out.data(), a.data(), b.data(), COUNT, btmp.data());
+			});
+			vector<uint32_t> blk((size_t)W * n);
+			batch.interleave(blk.data(), a.data(), W);
+			fwd_s = best_time([&]() {
+				for (int c = 0; c < COUNT; c += W) {
+					batch.forward(blk.data());
+				}
+			});
+			name = string("batch ") + cpu_isa_name(batch.isa());
+			report(name.c_str(), W, mul_s, fwd_s, ok);
+		}
+		cout << endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,151 @@
+/*
+ * NTT_bench.cpp
+ *
+ * Description
+ * This program compares the modular reduction policies of NttPlanT (NTT_reduce.h)
+ * on the Kyber parameter set (n = 256, q = 3329) and a 30-bit prime (q = 998244353)
+ * Every policy is first checked against the "%" plan, then forward + inverse is timed
+ * The policy rows always run the scalar kernels, the AVX2 and AVX-512 rows are
+ * the kernels NttPlan dispatches to (cpu_dispatch.h) when the CPU and the parameter
+ * set allow them, checked to be bit-identical to the scalar plan first
+ *
+ * Using "make bench" to compile the cpp file
+ * and using "./build/NTT_bench.out" to run the program
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * 2026/10/17	jorjor	AVX2 kernel
+ * 2026/10/17	jorjor	AVX-512 kernel through the ISA dispatch of NttPlan
+ * */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+#include <algorithm>
+
+#include "NTT_plan.h"
+
+using namespace std;
+
+struct Param {
+	const char *name;
+	int n;
+	uint32_t q;
+	ntt_mode mode;
+	uint32_t root;
+};
+
+static vector<uint32_t> reference;
+
+template <class Reduce, int Lazy>
+void bench(const Param &p, const vector<uint32_t> &a, const vector<uint32_t> &b) {
+	NttPlanT<Reduce, Lazy> plan(p.n, p.q, p.mode, p.root, ISA_SCALAR);
+
+	vector<uint32_t> out(p.n), tmp(p.n);
+	plan.multiply(out.data(), a.data(), b.data(), tmp.data());
+
+	if (reference.empty()) {
+		reference = out;
+	}
+	bool ok = (out == reference);
+
+	// forward + inverse on the same buffer, the values stay in [0, q)
+	// best of 5 rounds to filter out scheduling noise
+	int iters = (1 << 22) / p.n;
+	vector<uint32_t> x = a;
+	double ns = 0;
+	for (int round = 0; round < 5; round++) {
+		chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+		for (int i = 0; i < iters; i++) {
+			plan.forward(x.data());
+			plan.inverse(x.data());
+		}
+		chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+		double t = chrono::duration<double, nano>(t1 - t0).count() / iters / 2;
+		if (round == 0 || t < ns) ns = t;
+	}
+
+	cout << setw(12) << Reduce::name() << " lazy " << Lazy
+		 << setw(12) << fixed << setprecision(1) << ns << " ns/transform"
+		 << (ok && x == a ? "" : "   MISMATCH") << endl;
+}
+
+void bench_isa(const Param &p, const vector<uint32_t> &a, const vector<uint32_t> &b, cpu_isa isa) {
+	NttPlan scalar(p.n, p.q, p.mode, p.root, ISA_SCALAR);
+	NttPlan plan(p.n, p.q, p.mode, p.root, isa);
+	if (plan.isa() != isa) {
+		return;
+	}
+
+	// bit-identical to the scalar plan, forward, inverse and multiply
+	vector<uint32_t> ref = a, x = a;
+	scalar.forward(ref.data());
+	plan.forward(x.data());
+	bool ok = (x == ref);
+	scalar.inverse(ref.data());
+	plan.inverse(x.data());
+	ok = ok && x == ref && x == a;
+
+	vector<uint32_t> out(p.n), tmp(p.n);
+	plan.multiply(out.data(), a.data(), b.data(), tmp.data());
+	ok = ok && out == reference;
+
+	int iters = (1 << 22) / p.n;
+	double ns = 0;
+	for (int round = 0; round < 5; round++) {
+		chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+		for (int i = 0; i < iters; i++) {
+			plan.forward(x.data());
+			plan.inverse(x.data());
+		}
+		chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+		double t = chrono::duration<double, nano>(t1 - t0).count() / iters / 2;
+		if (round == 0 || t < ns) ns = t;
+	}
+
+	cout << setw(12) << cpu_isa_name(isa) << " int16 "
+		 << setw(12) << fixed << setprecision(1) << ns << " ns/transform"
+		 << (ok ? "" : "   MISMATCH") << endl;
+}
+
+int main() {
+	Param params[] = {
+		{ "Kyber", 256, 3329, NTT_NEGACYCLIC, 17 },
+		{ "30-bit prime", 1024, 998244353, NTT_NEGACYCLIC, 0 },
+	};
+
+	cout << "CPU : " << cpu_isa_name(cpu_detect_isa())
+		 << ", selected : " << cpu_isa_name(cpu_select_isa()) << endl << endl;
+
+	/* set seed to 0 */
+	srand(0);
+
+	for (size_t i = 0; i < sizeof(params) / sizeof(params[0]); i++) {
+		const Param &p = params[i];
+		vector<uint32_t> a(p.n), b(p.n);
+		for (int j = 0; j < p.n; j++) {
+			a[j] = rand() % p.q;
+			b[j] = rand() % p.q;
+		}
+
+		cout << "***** " << p.name << " : n = " << p.n << ", q = " << p.q << " *****" << endl;
+		reference.clear();
+		bench<ModReduce, 1>(p, a, b);
+		bench<BarrettReduce, 1>(p, a, b);
+		bench<BarrettReduce, 2>(p, a, b);
+		bench<BarrettReduce, 4>(p, a, b);
+		bench<MontgomeryReduce, 1>(p, a, b);
+		bench<MontgomeryReduce, 2>(p, a, b);
+		bench<MontgomeryReduce, 4>(p, a, b);
+		bench<ShoupReduce, 1>(p, a, b);
+		bench<ShoupReduce, 2>(p, a, b);
+		bench<ShoupReduce, 4>(p, a, b);
+		bench_isa(p, a, b, ISA_AVX2);
+		bench_isa(p, a, b, ISA_AVX512);
+		cout << endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,154 @@
+/*
+ * NTT_crt_bench.cpp
+ *
+ * Description
+ * This program measures the multi-modulus NTT (NTT_crt.h)
+ *
+ *   polynomials   exact linear products of la = lb = n / 2 coefficients of 32 bits
+ *                 (3 moduli, 128-bit results) and 64 bits (5 moduli, 6 words),
+ *                 ns per result coefficient, 1 thread and a ThreadPool with one
+ *                 thread per core
+ *   bigint        bigint_multiply() against schoolbook on 32-bit words,
+ *                 schoolbook stops at 2^14 words
+ *
+ * Every result is first checked against schoolbook (polynomials up to n = 2^12)
+ *
+ * Using "make bench" to compile the cpp file
+ * and using "./build/NTT_crt_bench.out" to run the program
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+
+#include "NTT_crt.h"
+
+using namespace std;
+
+// best of 5 rounds, ns per call
+template <class F>
+double time_op(F op, double work) {
+	int iters = max(1, (int)((1 << 24) / work));
+	double ns = 0;
+	for (int round = 0; round < 5; round++) {
+		chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+		for (int i = 0; i < iters; i++) {
+			op();
+		}
+		chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+		double t = chrono::duration<double, nano>(t1 - t0).count() / iters;
+		if (round == 0 || t < ns) ns = t;
+	}
+	return ns;
+}
+
+static uint64_t rand64() {
+	return ((uint64_t)rand() << 62) ^ ((uint64_t)rand() << 31) ^ (uint64_t)rand();
+}
+
+static void school_words(uint32_t *z, const uint32_t *x, int nx, const uint32_t *y, int ny) {
+	for (int i = 0; i < nx + ny; i++) {
+		z[i] = 0;
+	}
+	for (int i = 0; i < nx; i++) {
+		uint64_t carry = 0;
+		for (int j = 0; j < ny; j++) {
+			uint64_t t = (uint64_t)x[i] * y[j] + z[i + j] + carry;
+			z[i + j] = (uint32_t)t;
+			carry = t >> 32;
+		}
+		z[i + ny] = (uint32_t)carry;
+	}
+}
+
+// exact la x lb product in 6 words per coefficient
+static void school_poly(uint32_t *out, const uint64_t *a, int la, const uint64_t *b, int lb) {
+	for (int i = 0; i < (la + lb - 1) * 6; i++) {
+		out[i] = 0;
+	}
+	for (int i = 0; i < la; i++) {
+		for (int j = 0; j < lb; j++) {
+			unsigned __int128 p = (unsigned __int128)a[i] * b[j];
+			uint32_t *x = out + (i + j) * 6;
+			uint64_t carry = 0;
+			for (int w = 0; w < 6; w++) {
+				uint64_t t = (uint64_t)x[w] + (w < 4 ? (uint32_t)(p >> (32 * w)) : 0) + carry;
+				x[w] = (uint32_t)t;
+				carry = t >> 32;
+			}
+		}
+	}
+}
+
+int main() {
+	ThreadPool pool;
+
+	/* set seed to 0 */
+	srand(0);
+
+	cout << "polynomials, threads : " << pool.slots() << endl;
+	cout << setw(10) << "n" << setw(8) << "bits" << setw(8) << "primes" << setw(14) << "1 thread"
+		 << setw(14) << "pool" << "   ns/coefficient" << endl;
+	for (int lg = 10; lg <= 20; lg += 2) {
+		for (int bits = 32; bits <= 64; bits += 32) {
+			int n = 1 << lg, la = n / 2, lb = n / 2, len = la + lb - 1;
+			vector<uint64_t> a(la), b(lb);
+			for (int i = 0; i < la; i++) a[i] = (bits == 64) ? rand64() : (uint32_t)rand64();
+			for (int i = 0; i < lb; i++) b[i] = (bits == 64) ? rand64() : (uint32_t)rand64();
+
+			int k = NttCrt::primes_for(la, lb, bits, bits);
+			NttCrt crt(n, k);
+			vector<uint32_t> out((size_t)len * 6), ref;
+			bool ok = true;
+			crt.multiply_words(&out[0], 6, &a[0], la, &b[0], lb, &pool);
+			if (lg <= 12) {
+				ref.resize(out.size());
+				school_poly(&ref[0], &a[0], la, &b[0], lb);
+				ok = (out == ref);
+			}
+
+			double work = (double)n * lg * k;
+			double t1 = time_op([&]() { crt.multiply_words(&out[0], 6, &a[0], la, &b[0], lb); }, work);
+			double tp = time_op([&]() { crt.multiply_words(&out[0], 6, &a[0], la, &b[0], lb, &pool); }, work);
+			cout << setw(10) << n << setw(8) << bits << setw(8) << k << fixed << setprecision(1)
+				 << setw(14) << t1 / len << setw(14) << tp / len << (ok ? "" : "   MISMATCH") << endl;
+		}
+	}
+
+	cout << endl << "bigint, 32-bit words" << endl;
+	cout << setw(10) << "words" << setw(14) << "schoolbook" << setw(14) << "ntt crt"
+		 << setw(10) << "speedup" << "   us/product" << endl;
+	for (int lg = 6; lg <= 20; lg += 2) {
+		int nx = 1 << lg;
+		vector<uint32_t> x(nx), y(nx), z(2 * nx), ref(2 * nx);
+		for (int i = 0; i < nx; i++) {
+			x[i] = (uint32_t)rand64();
+			y[i] = (uint32_t)rand64();
+		}
+
+		bigint_multiply(&z[0], &x[0], nx, &y[0], nx);
+		double ts = 0;
+		bool ok = true;
+		if (lg <= 14) {
+			school_words(&ref[0], &x[0], nx, &y[0], nx);
+			ok = (z == ref);
+			ts = time_op([&]() { school_words(&ref[0], &x[0], nx, &y[0], nx); }, (double)nx * nx);
+		}
+		double tn = time_op([&]() { bigint_multiply(&z[0], &x[0], nx, &y[0], nx); }, 3.0 * nx * lg);
+		cout << setw(10) << nx << fixed << setprecision(1);
+		if (ts > 0) {
+			cout << setw(14) << ts / 1000 << setw(14) << tn / 1000 << setw(10) << setprecision(2) << ts / tn;
+		}
+		else {
+			cout << setw(14) << "-" << setw(14) << tn / 1000 << setw(10) << "-";
+		}
+		cout << (ok ? "" : "   MISMATCH") << endl;
+	}
+
+	return 0;
+}
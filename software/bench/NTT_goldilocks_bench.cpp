@@ -0,0 +1,103 @@
+/*
+ * NTT_goldilocks_bench.cpp
+ *
+ * Description
+ * This program measures the Goldilocks NTT (NTT_goldilocks.h), n = 2^10 ... 2^20
+ *
+ *   transform   ns per butterfly of forward(), NttGoldilocks against NttPlan
+ *               on a 31-bit prime (q = 2013265921, Shoup), both cyclic
+ *   product     exact linear product of two polynomials of n / 2 coefficients
+ *               of 20 bits (results below 2^59), one Goldilocks multiply()
+ *               against NttCrt (NTT_crt.h) with the 2 moduli it needs, in us
+ *
+ * Every product is first checked against the NttCrt one
+ *
+ * Using "make bench" to compile the cpp file
+ * and using "./build/NTT_goldilocks_bench.out" to run the program
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+
+#include "NTT_goldilocks.h"
+#include "NTT_plan.h"
+#include "NTT_crt.h"
+
+using namespace std;
+
+// best of 5 rounds, ns per call
+template <class F>
+double time_op(F op, int n, int lg) {
+	int iters = max(1, (1 << 22) / (n * lg));
+	double ns = 0;
+	for (int round = 0; round < 5; round++) {
+		chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+		for (int i = 0; i < iters; i++) {
+			op();
+		}
+		chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+		double t = chrono::duration<double, nano>(t1 - t0).count() / iters;
+		if (round == 0 || t < ns) ns = t;
+	}
+	return ns;
+}
+
+int main() {
+	/* set seed to 0 */
+	srand(0);
+
+	cout << "transform" << endl;
+	cout << setw(10) << "n" << setw(14) << "goldilocks" << setw(14) << "31-bit" << "   ns/butterfly" << endl;
+	const uint32_t q = 2013265921u;
+	for (int lg = 10; lg <= 20; lg += 2) {
+		int n = 1 << lg;
+		vector<uint64_t> x(n);
+		vector<uint32_t> y(n);
+		for (int i = 0; i < n; i++) {
+			x[i] = ((uint64_t)rand() << 33) ^ rand();
+			y[i] = rand() % q;
+		}
+		NttGoldilocks gl(n);
+		NttPlan plan(n, q, NTT_CYCLIC);
+
+		double bf = (double)n / 2 * lg;
+		double tg = time_op([&]() { gl.forward(x.data()); }, n, lg);
+		double tq = time_op([&]() { plan.forward(y.data()); }, n, lg);
+		cout << setw(10) << n << fixed << setprecision(2) << setw(14) << tg / bf << setw(14) << tq / bf << endl;
+	}
+
+	cout << endl << "product, 20-bit coefficients" << endl;
+	cout << setw(10) << "n" << setw(14) << "goldilocks" << setw(14) << "crt" << setw(8) << "primes"
+		 << setw(10) << "speedup" << "   us/product" << endl;
+	for (int lg = 10; lg <= 20; lg += 2) {
+		int n = 1 << lg, la = n / 2, len = 2 * la - 1;
+		vector<uint64_t> a(n, 0), b(n, 0), out(n), tmp(n), ref(len);
+		for (int i = 0; i < la; i++) {
+			a[i] = rand() & 0xfffff;
+			b[i] = rand() & 0xfffff;
+		}
+		NttGoldilocks gl(n);
+		int k = NttCrt::primes_for(la, la, 20, 20);
+		NttCrt crt(n, k);
+
+		gl.multiply(out.data(), a.data(), b.data(), tmp.data());
+		crt.multiply(ref.data(), a.data(), la, b.data(), la);
+		bool ok = true;
+		for (int i = 0; i < len; i++) {
+			ok = ok && out[i] == ref[i];
+		}
+
+		double tg = time_op([&]() { gl.multiply(out.data(), a.data(), b.data(), tmp.data()); }, n, lg);
+		double tc = time_op([&]() { crt.multiply(ref.data(), a.data(), la, b.data(), la); }, n, lg);
+		cout << setw(10) << n << fixed << setprecision(1) << setw(14) << tg / 1000 << setw(14) << tc / 1000
+			 << setw(8) << k << setw(10) << setprecision(2) << tc / tg << (ok ? "" : "   MISMATCH") << endl;
+	}
+
+	return 0;
+}
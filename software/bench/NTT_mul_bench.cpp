@@ -0,0 +1,132 @@
+/*
+ * NTT_mul_bench.cpp
+ *
+ * Description
+ * This program measures the kernels of PolyMul (NTT_mul.h), the numbers behind
+ * the POLYMUL_* thresholds
+ *
+ *   school / karatsuba / toom3 / ntt   ns per product of n coefficients, the kernel
+ *                                      forced on the top level, the sub-products dispatched
+ *   dispatch                           multiply(), the kernel algorithm(n) picks
+ *   NttPlan                            NttPlan::multiply() on the padded cyclic size
+ *
+ * and the thresholds tune() finds on this machine next to the defaults
+ * Every kernel is first checked against a product with one % per coefficient product
+ *
+ * Using "make bench" to compile the cpp file
+ * and using "./build/NTT_mul_bench.out" to run the program
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+
+#include "NTT_mul.h"
+
+using namespace std;
+
+// best of 5 rounds, ns per call
+template <class F>
+double time_op(F op, int n) {
+	int iters = max(2, (1 << 20) / (n * n));
+	double ns = 0;
+	for (int round = 0; round < 5; round++) {
+		chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+		for (int i = 0; i < iters; i++) {
+			op();
+		}
+		chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+		double t = chrono::duration<double, nano>(t1 - t0).count() / iters;
+		if (round == 0 || t < ns) ns = t;
+	}
+	return ns;
+}
+
+static void naive(uint32_t *out, const uint32_t *a, const uint32_t *b, int n, uint32_t q) {
+	for (int k = 0; k < 2 * n - 1; k++) {
+		out[k] = 0;
+	}
+	for (int i = 0; i < n; i++) {
+		for (int j = 0; j < n; j++) {
+			out[i + j] = (uint32_t)((out[i + j] + (uint64_t)a[i] * b[j]) % q);
+		}
+	}
+}
+
+static void run(const char *name, uint32_t q, int max_n) {
+	PolyMul pm(q, max_n);
+	cout << name << ", q = " << q << ", NTT up to n = ";
+	int top = 0;
+	for (int n = 1; n <= max_n; n *= 2) {
+		if (pm.has_ntt(n)) top = n;
+	}
+	cout << top << endl;
+	cout << setw(6) << "n" << setw(10) << "school" << setw(11) << "karatsuba" << setw(10) << "toom3"
+		 << setw(10) << "ntt" << setw(10) << "dispatch" << setw(10) << "NttPlan" << setw(11) << "algorithm"
+		 << "   ns/product" << endl;
+
+	mul_algo algos[4] = { MUL_SCHOOL, MUL_KARATSUBA, MUL_TOOM3, MUL_NTT };
+	for (int n = 4; n <= max_n; n = (n % 3 == 0) ? n / 3 * 4 : n / 2 * 3) {
+		vector<uint32_t> a(n), b(n), ref(2 * n - 1), c(2 * n - 1), tmp(pm.scratch_size(n));
+		for (int i = 0; i < n; i++) {
+			a[i] = rand() % q;
+			b[i] = rand() % q;
+		}
+		naive(ref.data(), a.data(), b.data(), n, q);
+
+		cout << setw(6) << n;
+		bool ok = true;
+		for (int k = 0; k < 4; k++) {
+			int width = (k == 1) ? 11 : 10;
+			if ((k == 0 && n > POLYMUL_SCHOOL_MAX) || (k == 1 && n < 2) || (k == 2 && n < 3) || (k == 3 && !pm.has_ntt(n))) {
+				cout << setw(width) << "-";
+				continue;
+			}
+			pm.multiply_with(algos[k], c.data(), a.data(), b.data(), n, tmp.data());
+			ok = ok && c == ref;
+			double t = time_op([&]() { pm.multiply_with(algos[k], c.data(), a.data(), b.data(), n, tmp.data()); }, n);
+			cout << fixed << setprecision(0) << setw(width) << t;
+		}
+		pm.multiply(c.data(), a.data(), b.data(), n, tmp.data());
+		ok = ok && c == ref;
+		cout << setw(10) << time_op([&]() { pm.multiply(c.data(), a.data(), b.data(), n, tmp.data()); }, n);
+
+		if (pm.has_ntt(n)) {
+			int size = 2;
+			while (size < 2 * n - 1) size *= 2;
+			NttPlan plan(size, q, NTT_CYCLIC);
+			vector<uint32_t> x(size, 0), y(size, 0), z(size), w(size);
+			for (int i = 0; i < n; i++) {
+				x[i] = a[i];
+				y[i] = b[i];
+			}
+			cout << setw(10) << time_op([&]() { plan.multiply(z.data(), x.data(), y.data(), w.data()); }, n);
+		}
+		else {
+			cout << setw(10) << "-";
+		}
+		cout << setw(11) << mul_algo_name(pm.algorithm(n)) << (ok ? "" : "   MISMATCH") << endl;
+	}
+
+	pm.tune();
+	cout << "thresholds    default " << POLYMUL_KARATSUBA << " / " << POLYMUL_TOOM3 << " / " << POLYMUL_NTT
+		 << ", tuned " << pm.karatsuba_threshold() << " / " << pm.toom3_threshold() << " / " << pm.ntt_threshold()
+		 << "   (karatsuba / toom3 / ntt, 2147483647 : never)" << endl << endl;
+}
+
+int main() {
+	/* set seed to 0 */
+	srand(0);
+
+	run("kyber", 3329, 1024);
+	run("dilithium", 8380417, 4096);
+	run("998244353", 998244353, 4096);
+	run("31-bit", 2130706433, 4096);
+
+	return 0;
+}
@@ -0,0 +1,100 @@
+/*
+ * NTT_parallel_bench.cpp
+ *
+ * Description
+ * This program measures the scaling of NttParallel (NTT_parallel.h) on a batch of
+ * 10^5 independent n = 256 multiplications, for 1, 2, 4, ... threads up to one per core
+ * (Kyber, q = 3329 and a 30-bit prime, q = 998244353)
+ * The result of every thread count is first checked against NttPlan::multiply()
+ *
+ * Using "make bench" to compile the cpp file
+ * and using "./build/NTT_parallel_bench.out [pin]" to run the program
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+#include "NTT_parallel.h"
+
+using namespace std;
+
+struct Param {
+	const char *name;
+	int n;
+	uint32_t q;
+	ntt_mode mode;
+	uint32_t root;
+};
+
+static const long COUNT = 100000;	// polynomial pairs
+
+int main(int argc, char **argv) {
+	Param params[] = {
+		{ "Kyber", 256, 3329, NTT_NEGACYCLIC, 17 },
+		{ "30-bit prime", 256, 998244353, NTT_NEGACYCLIC, 0 },
+	};
+	bool pin = (argc > 1 && strcmp(argv[1], "pin") == 0);
+	int cores = (int)thread::hardware_concurrency();
+	if (cores < 1) cores = 1;
+
+	/* set seed to 0 */
+	srand(0);
+
+	for (size_t i = 0; i < sizeof(params) / sizeof(params[0]); i++) {
+		const Param &p = params[i];
+		const size_t n = p.n;
+		vector<uint32_t> a(COUNT * n), b(COUNT * n), ref(COUNT * n), out(COUNT * n), tmp(n);
+		for (size_t j = 0; j < a.size(); j++) {
+			a[j] = rand() % p.q;
+			b[j] = rand() % p.q;
+		}
+
+		NttPlan plan(p.n, p.q, p.mode, p.root);
+		for (long c = 0; c < COUNT; c++) {
+			plan.multiply(&ref[c * n], &a[c * n], &b[c * n], tmp.data());
+		}
+
+		cout << "***** " << p.name << " : n = " << n << ", q = " << p.q << ", "
+			 << COUNT << " pairs, " << cores << " cores" << (pin ? ", pinned" : "") << " *****" << endl;
+		cout << setw(8) << "threads" << setw(8) << "chunk" << setw(16) << "multiply/s" << setw(10) << "speedup" << endl;
+
+		double base = 0;
+		for (int t = 1; ; t = (2 * t < cores || t == cores) ? 2 * t : cores) {
+			ThreadPool pool(t - 1, pin);
+			NttParallel par(plan, pool);
+
+			par.multiply(out.data(), a.data(), b.data(), COUNT);
+			bool ok = (out == ref);
+
+			// best of 5 rounds
+			double best = 0;
+			for (int round = 0; round < 5; round++) {
+				chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+				par.multiply(out.data(), a.data(), b.data(), COUNT);
+				chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+				double s = chrono::duration<double>(t1 - t0).count();
+				if (round == 0 || s < best) best = s;
+			}
+			double rate = COUNT / best;
+			if (t == 1) base = rate;
+
+			cout << setw(8) << t << setw(8) << par.chunk()
+				 << setw(16) << fixed << setprecision(0) << rate
+				 << setw(10) << setprecision(2) << rate / base
+				 << (par.uses_batch() ? "  (batch)" : "")
+				 << (ok ? "" : "   MISMATCH") << endl;
+			if (t >= cores) break;
+		}
+		cout << endl;
+	}
+
+	return 0;
+}
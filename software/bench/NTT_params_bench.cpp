@@ -0,0 +1,107 @@
+/*
+ * NTT_params_bench.cpp
+ *
+ * Description
+ * This program measures the NTT parameter generation (NTT_params.h)
+ *
+ *   ntt_params(n, negacyclic, bits) for 30 ... 62-bit moduli and n = 2^10 ... 2^20,
+ *   the prime found, its primitive root, psi of order 2n, and us per call
+ *   (prime search, factoring q - 1, primitive root, psi and the inverses)
+ *
+ * Every parameter set is first checked : q prime (trial division up to 2^31 only),
+ * psi^n = -1, psi * psi^-1 = 1, n * n^-1 = 1, and for q below 2^31 the same root
+ * as NttTables and a product by x through NttPlan
+ *
+ * Using "make bench" to compile the cpp file
+ * and using "./build/NTT_params_bench.out" to run the program
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+
+#include "NTT_params.h"
+#include "NTT_plan.h"
+
+using namespace std;
+
+// best of 5 rounds, ns per call
+template <class F>
+double time_op(F op, int iters) {
+	double ns = 0;
+	for (int round = 0; round < 5; round++) {
+		chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+		for (int i = 0; i < iters; i++) {
+			op();
+		}
+		chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+		double t = chrono::duration<double, nano>(t1 - t0).count() / iters;
+		if (round == 0 || t < ns) ns = t;
+	}
+	return ns;
+}
+
+static bool check(const NttParams &p) {
+	uint64_t q = p.q;
+	bool ok = powmod_u64(p.root, p.n, q) == q - 1
+		&& mulmod_u64(p.root, p.root_inv, q) == 1
+		&& mulmod_u64(p.n % q, p.n_inv, q) == 1
+		&& (q - 1) % (2 * p.n) == 0;
+	if (q < (1ull << 31)) {
+		for (uint64_t d = 3; d * d <= q && ok; d += 2) {
+			ok = (q % d != 0);
+		}
+		// same root as NttTables, and a product through NttPlan
+		NttPlan plan((int)p.n, (uint32_t)q, NTT_NEGACYCLIC);
+		ok = ok && plan.root() == p.root;
+		vector<uint32_t> a(p.n), b(p.n), c(p.n), tmp(p.n);
+		for (size_t i = 0; i < p.n; i++) {
+			a[i] = rand() % q;
+		}
+		b.assign(p.n, 0);
+		b[1] = 1;	// x * a(x) mod x^n + 1
+		plan.multiply(c.data(), a.data(), b.data(), tmp.data());
+		ok = ok && c[0] == (q - a[p.n - 1]) % q;
+		for (size_t i = 1; i < p.n && ok; i++) {
+			ok = c[i] == a[i - 1];
+		}
+	}
+	return ok;
+}
+
+int main() {
+	/* set seed to 0 */
+	srand(0);
+
+	const int widths[6] = { 30, 31, 40, 50, 60, 62 };
+
+	cout << setw(8) << "n" << setw(6) << "bits" << setw(22) << "q" << setw(6) << "g"
+		 << setw(22) << "psi" << setw(10) << "factors" << setw(12) << "us/call" << endl;
+	for (int lg = 10; lg <= 20; lg += 5) {
+		size_t n = (size_t)1 << lg;
+		for (int w = 0; w < 6; w++) {
+			int bits = widths[w];
+			NttParams p = ntt_params(n, NTT_NEGACYCLIC, bits);
+			bool ok = check(p);
+			double t = time_op([&]() { ntt_params(n, NTT_NEGACYCLIC, bits); }, 20);
+			cout << setw(8) << n << setw(6) << bits << setw(22) << p.q << setw(6) << p.g
+				 << setw(22) << p.root << setw(10) << p.factors.size()
+				 << fixed << setprecision(1) << setw(12) << t / 1000 << (ok ? "" : "   MISMATCH") << endl;
+		}
+	}
+
+	cout << endl << "4 primes of 50 bits for n = 2^16 (CRT sets)" << endl;
+	double t = time_op([&]() { ntt_primes(1 << 16, NTT_NEGACYCLIC, 50, 4); }, 20);
+	vector<uint64_t> primes = ntt_primes(1 << 16, NTT_NEGACYCLIC, 50, 4);
+	for (size_t i = 0; i < primes.size(); i++) {
+		cout << setw(22) << primes[i] << endl;
+	}
+	cout << fixed << setprecision(1) << t / 1000 << " us/call" << endl;
+
+	return 0;
+}
@@ -0,0 +1,108 @@
+/*
+ * NTT_poly_bench.cpp
+ *
+ * Description
+ * This program measures Poly<N, Q> (NTT_poly.h), the NTT fixed at compile time,
+ * against NttPlan with the same parameters given at run time
+ *
+ *   forward / inverse / multiply    ns per call, negacyclic
+ *   plan scalar                     NttPlan restricted to ISA_SCALAR, the same butterflies
+ *   plan auto                       NttPlan with its SIMD kernels when the CPU allows them
+ *
+ * Every Poly result is first checked against the NttPlan one
+ *
+ * Using "make bench" to compile the cpp file
+ * and using "./build/NTT_poly_bench.out" to run the program
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+
+#include "NTT_poly.h"
+#include "NTT_plan.h"
+
+using namespace std;
+
+// best of 5 rounds, ns per call
+template <class F>
+double time_op(F op, int n) {
+	int iters = max(1, (1 << 22) / n);
+	double ns = 0;
+	for (int round = 0; round < 5; round++) {
+		chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+		for (int i = 0; i < iters; i++) {
+			op();
+		}
+		chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+		double t = chrono::duration<double, nano>(t1 - t0).count() / iters;
+		if (round == 0 || t < ns) ns = t;
+	}
+	return ns;
+}
+
+template <int N, uint32_t Q>
+void run(const char *name) {
+	typedef Poly<N, Q> poly;
+	NttPlan scalar(N, Q, NTT_NEGACYCLIC, 0, ISA_SCALAR);
+	NttPlan plan(N, Q, NTT_NEGACYCLIC);
+
+	vector<uint32_t> a(N), b(N), x(N), y(N), tmp(N);
+	for (int i = 0; i < N; i++) {
+		a[i] = rand() % Q;
+		b[i] = rand() % Q;
+	}
+
+	bool ok = true;
+	x = a;
+	y = a;
+	poly::forward(x.data());
+	scalar.forward(y.data());
+	ok = ok && x == y;
+	poly::inverse(x.data());
+	scalar.inverse(y.data());
+	ok = ok && x == y && x == a;
+	poly::multiply(x.data(), a.data(), b.data(), tmp.data());
+	plan.multiply(y.data(), a.data(), b.data(), tmp.data());
+	ok = ok && x == y;
+
+	double t[3][3];
+	t[0][0] = time_op([&]() { poly::forward(x.data()); }, N);
+	t[0][1] = time_op([&]() { scalar.forward(x.data()); }, N);
+	t[0][2] = time_op([&]() { plan.forward(x.data()); }, N);
+	t[1][0] = time_op([&]() { poly::inverse(x.data()); }, N);
+	t[1][1] = time_op([&]() { scalar.inverse(x.data()); }, N);
+	t[1][2] = time_op([&]() { plan.inverse(x.data()); }, N);
+	t[2][0] = time_op([&]() { poly::multiply(x.data(), a.data(), b.data(), tmp.data()); }, N);
+	t[2][1] = time_op([&]() { scalar.multiply(x.data(), a.data(), b.data(), tmp.data()); }, N);
+	t[2][2] = time_op([&]() { plan.multiply(x.data(), a.data(), b.data(), tmp.data()); }, N);
+
+	const char *ops[3] = { "forward", "inverse", "multiply" };
+	for (int i = 0; i < 3; i++) {
+		cout << setw(12) << name << setw(6) << N << setw(12) << Q << setw(10) << ops[i]
+			 << fixed << setprecision(0) << setw(10) << t[i][0] << setw(14) << t[i][1] << setw(12) << t[i][2]
+			 << setw(10) << setprecision(2) << t[i][1] / t[i][0] << (ok ? "" : "   MISMATCH") << endl;
+	}
+}
+
+int main() {
+	/* set seed to 0 */
+	srand(0);
+
+	cout << "isa of plan auto : " << cpu_isa_name(NttPlan(256, 3329, NTT_NEGACYCLIC).isa()) << endl;
+	cout << setw(12) << "" << setw(6) << "n" << setw(12) << "q" << setw(10) << "op"
+		 << setw(10) << "poly" << setw(14) << "plan scalar" << setw(12) << "plan auto"
+		 << setw(10) << "speedup" << "   ns/call, speedup of poly over plan scalar" << endl;
+	run<256, 3329>("kyber");
+	run<256, 8380417>("dilithium");
+	run<256, 7681>("7681");
+	run<1024, 12289>("newhope");
+	run<512, 998244353>("998244353");
+
+	return 0;
+}
@@ -0,0 +1,150 @@
+/*
+ * bitrev_bench.cpp
+ *
+ * Description
+ * This program compares the bit-reversal permutations on uint32_t (NTT) and
+ * Complex (FFT) arrays, n = 2^10 ... 2^22, in ns per value
+ *
+ *   pow index    x_rev[i] = x[bitreverse(i, lg)] with the pow(2, i) loop of NTT_org.cpp
+ *   table swap   swap loop on a precomputed rev table, as in FftPlan and the benches
+ *   swap         bitrev_swap, reversed counter, no table
+ *   cobra        bitrev_cobra, the blocked permutation (bitrev.h), at every size
+ *   permute      bitrev_permute, swap or cobra by size
+ *
+ * Every result is first checked against the pow index one
+ *
+ * Using "make bench" to compile the cpp file
+ * and using "./build/bitrev_bench.out" to run the program
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <complex>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+
+#include "bitrev.h"
+
+using namespace std;
+
+typedef complex<double> Complex;
+
+// best of 5 rounds, ns per value
+template <class F>
+double time_op(F op, int n) {
+	int iters = max(1, (1 << 22) / n);
+	double ns = 0;
+	for (int round = 0; round < 5; round++) {
+		chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+		for (int i = 0; i < iters; i++) {
+			op();
+		}
+		chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+		double t = chrono::duration<double, nano>(t1 - t0).count() / iters / n;
+		if (round == 0 || t < ns) ns = t;
+	}
+	return ns;
+}
+
+// the index of NTT_org.cpp
+static int bitreverse(int num, int len) {
+	int result = 0;
+
+	for (int i = len - 1; i >= 0; i--) {
+		result += ((num & 1) * pow(2, i));
+		num >>= 1;
+	}
+
+	return result;
+}
+
+template <typename T>
+static void pow_index(T *out, const T *x, int lg) {
+	for (int i = 0; i < (1 << lg); i++) {
+		out[i] = x[bitreverse(i, lg)];
+	}
+}
+
+template <typename T>
+static void table_swap(T *x, const vector<int> &rev) {
+	for (size_t i = 0; i < rev.size(); i++) {
+		if ((int)i < rev[i]) {
+			T t = x[i];
+			x[i] = x[rev[i]];
+			x[rev[i]] = t;
+		}
+	}
+}
+
+template <typename T>
+static int tile_bits() {
+	// the t of bitrev_permute
+	int t = 0;
+	while (((size_t)sizeof(T) << (2 * t + 2)) <= BITREV_TILE_BYTES) t++;
+	return t;
+}
+
+template <typename T>
+static void run(const char *name, T (*make)()) {
+	cout << name << endl;
+	cout << setw(10) << "n" << setw(12) << "pow index" << setw(12) << "table swap" << setw(12) << "swap"
+		 << setw(12) << "cobra" << setw(12) << "permute" << "   ns/value" << endl;
+
+	for (int lg = 10; lg <= 22; lg += 2) {
+		int n = 1 << lg;
+		vector<T> a(n), ref(n), x(n), out(n);
+		for (int i = 0; i < n; i++) {
+			a[i] = make();
+		}
+		vector<int> rev(n);
+		bitrev_table(&rev[0], lg);
+		int t = min(tile_bits<T>(), lg / 2);
+
+		pow_index(ref.data(), a.data(), lg);
+		bool ok = true;
+		x = a;
+		table_swap(x.data(), rev);
+		ok = ok && x == ref;
+		x = a;
+		bitrev_swap(x.data(), lg);
+		ok = ok && x == ref;
+		x = a;
+		bitrev_cobra(x.data(), lg, t);
+		ok = ok && x == ref;
+		x = a;
+		bitrev_permute(x.data(), lg);
+		ok = ok && x == ref;
+
+		double tp = time_op([&]() { pow_index(out.data(), x.data(), lg); }, n);
+		double tt = time_op([&]() { table_swap(x.data(), rev); }, n);
+		double ts = time_op([&]() { bitrev_swap(x.data(), lg); }, n);
+		double tc = time_op([&]() { bitrev_cobra(x.data(), lg, t); }, n);
+		double tb = time_op([&]() { bitrev_permute(x.data(), lg); }, n);
+		cout << setw(10) << n << fixed << setprecision(2) << setw(12) << tp << setw(12) << tt
+			 << setw(12) << ts << setw(12) << tc << setw(12) << tb << (ok ? "" : "   MISMATCH") << endl;
+	}
+	cout << endl;
+}
+
+static uint32_t make_u32() {
+	return rand();
+}
+
+static Complex make_complex() {
+	return Complex(rand() % 1000, rand() % 1000);
+}
+
+int main() {
+	/* set seed to 0 */
+	srand(0);
+
+	run<uint32_t>("uint32_t", make_u32);
+	run<Complex>("Complex", make_complex);
+
+	return 0;
+}
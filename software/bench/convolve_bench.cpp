@@ -0,0 +1,142 @@
+/*
+ * convolve_bench.cpp
+ *
+ * Description
+ * This program measures the linear convolutions FftConvolver (FFT_convolve.h) and
+ * NttConvolver (NTT_convolve.h) against the padding done by hand before them :
+ * both operands copied into 2 x the power of 2 above the longer one, then
+ * FftPlan::multiply() on complex copies or NttPlan::multiply()
+ *
+ *   la, lb        operand lengths, balanced, unbalanced and just above a power of 2
+ *   n hand, n     transform sizes of the hand padding and of convolve()
+ *   ns / call     best of 5 rounds, and the speedup of convolve()
+ *
+ * Every result is first checked against the hand-padded product
+ * (integer inputs below 2^10, the FFT results rounded)
+ *
+ * Using "make bench" to compile the cpp file
+ * and using "./build/convolve_bench.out" to run the program
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+
+#include "FFT_convolve.h"
+#include "NTT_convolve.h"
+
+using namespace std;
+
+// best of 5 rounds, ns per call
+template <class F>
+double time_op(F op, int n) {
+	int iters = max(2, (1 << 22) / n);
+	double ns = 0;
+	for (int round = 0; round < 5; round++) {
+		chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+		for (int i = 0; i < iters; i++) {
+			op();
+		}
+		chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+		double t = chrono::duration<double, nano>(t1 - t0).count() / iters;
+		if (round == 0 || t < ns) ns = t;
+	}
+	return ns;
+}
+
+static int hand_size(int la, int lb) {
+	int n = 1;
+	while (n < max(la, lb)) n <<= 1;
+	return 2 * n;
+}
+
+static void run_fft(int la, int lb) {
+	int nh = hand_size(la, lb);
+	int len = la + lb - 1;
+	vector<double> a(la), b(lb), c(len);
+	for (int i = 0; i < la; i++) a[i] = rand() % 1024;
+	for (int i = 0; i < lb; i++) b[i] = rand() % 1024;
+
+	FftPlan plan(nh);
+	FftConvolver conv;
+	vector<Complex> x(nh), y(nh), tmp(nh);
+	auto hand = [&]() {
+		for (int i = 0; i < nh; i++) {
+			x[i] = Complex(i < la ? a[i] : 0.0, 0.0);
+			y[i] = Complex(i < lb ? b[i] : 0.0, 0.0);
+		}
+		plan.multiply(x.data(), x.data(), y.data(), tmp.data());
+	};
+
+	hand();
+	conv.convolve(a.data(), la, b.data(), lb, c.data());
+	bool ok = true;
+	for (int i = 0; i < len && ok; i++) {
+		ok = llround(c[i]) == llround(x[i].real());
+	}
+
+	double th = time_op(hand, nh);
+	double tc = time_op([&]() { conv.convolve(a.data(), la, b.data(), lb, c.data()); }, nh);
+	cout << setw(6) << "fft" << setw(9) << la << setw(9) << lb << setw(9) << nh << setw(9) << FftConvolver::transform_size(la, lb)
+		 << fixed << setprecision(0) << setw(12) << th << setw(12) << tc
+		 << setprecision(2) << setw(9) << th / tc << (ok ? "" : "   MISMATCH") << endl;
+}
+
+static void run_ntt(int la, int lb, uint32_t q) {
+	int nh = hand_size(la, lb);
+	int len = la + lb - 1;
+	vector<uint32_t> a(la), b(lb), c(len);
+	for (int i = 0; i < la; i++) a[i] = rand() % 1024;
+	for (int i = 0; i < lb; i++) b[i] = rand() % 1024;
+
+	NttPlan plan(nh, q, NTT_CYCLIC);
+	NttConvolver conv(q);
+	vector<uint32_t> x(nh), y(nh), tmp(nh);
+	auto hand = [&]() {
+		for (int i = 0; i < nh; i++) {
+			x[i] = i < la ? a[i] : 0;
+			y[i] = i < lb ? b[i] : 0;
+		}
+		plan.multiply(x.data(), x.data(), y.data(), tmp.data());
+	};
+
+	hand();
+	conv.convolve(a.data(), la, b.data(), lb, c.data());
+	bool ok = true;
+	for (int i = 0; i < len && ok; i++) {
+		ok = c[i] == x[i];
+	}
+
+	double th = time_op(hand, nh);
+	double tc = time_op([&]() { conv.convolve(a.data(), la, b.data(), lb, c.data()); }, nh);
+	cout << setw(6) << "ntt" << setw(9) << la << setw(9) << lb << setw(9) << nh << setw(9) << conv.transform_size(la, lb)
+		 << fixed << setprecision(0) << setw(12) << th << setw(12) << tc
+		 << setprecision(2) << setw(9) << th / tc << (ok ? "" : "   MISMATCH") << endl;
+}
+
+int main() {
+	/* set seed to 0 */
+	srand(0);
+
+	const int shapes[8][2] = {
+		{ 256, 256 }, { 1000, 1000 }, { 4097, 4097 }, { 65536, 65536 },
+		{ 1000, 50 }, { 10000, 300 }, { 100000, 1000 }, { 100000, 20 }
+	};
+
+	cout << setw(6) << "" << setw(9) << "la" << setw(9) << "lb" << setw(9) << "n hand" << setw(9) << "n"
+		 << setw(12) << "hand" << setw(12) << "convolve" << setw(9) << "speedup" << "   ns/call, n = 0 : direct sum" << endl;
+	for (int i = 0; i < 8; i++) {
+		run_fft(shapes[i][0], shapes[i][1]);
+	}
+	for (int i = 0; i < 8; i++) {
+		run_ntt(shapes[i][0], shapes[i][1], 998244353);
+	}
+
+	return 0;
+}
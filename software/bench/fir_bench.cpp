@@ -0,0 +1,142 @@
+/*
+ * fir_bench.cpp
+ *
+ * Description
+ * This program measures FftFir (FFT_fir.h), the streaming FIR filter
+ *
+ *   taps          kernel length
+ *   n, L          transform size and outputs per block, 6 powers of 2 from the
+ *                 smallest above 2 taps, * marks best_size(taps)
+ *   save / add    ns per output sample of FIR_OVERLAP_SAVE / FIR_OVERLAP_ADD on
+ *                 a stream fed in chunks of 1000 samples
+ *   direct        ns per output sample of the direct sum (n = 0 below FFT_FIR_DIRECT taps)
+ *   check         both methods against the direct sum y[i] = sum h[k] x[i - k]
+ *                 on the first samples of the stream, MISMATCH above 1e-9
+ *
+ * Using "make bench" to compile the cpp file
+ * and using "./build/fir_bench.out" to run the program
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+
+#include "FFT_fir.h"
+
+using namespace std;
+
+// best of 5 rounds, ns per call
+template <class F>
+double time_op(F op, int n) {
+	int iters = max(2, (1 << 22) / n);
+	double ns = 0;
+	for (int round = 0; round < 5; round++) {
+		chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+		for (int i = 0; i < iters; i++) {
+			op();
+		}
+		chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+		double t = chrono::duration<double, nano>(t1 - t0).count() / iters;
+		if (round == 0 || t < ns) ns = t;
+	}
+	return ns;
+}
+
+// ns per sample of fir on the stream x, in chunks of 1000
+static double per_sample(FftFir &fir, const vector<double> &x, vector<double> &y) {
+	const int len = (int)x.size();
+	double ns = time_op([&]() {
+		for (int i = 0; i < len; i += 1000) {
+			fir.process(&x[i], &y[i], min(1000, len - i));
+		}
+	}, len * 16);
+	return ns / len;
+}
+
+static bool check(const vector<double> &h, fir_method method, int n, const vector<double> &x) {
+	// against the direct sum, lag latency() : the first 1024 outputs and 32 on
+	// each side of the next 3 block boundaries
+	FftFir fir(h.data(), (int)h.size(), method, n);
+	const int L = fir.block();
+	const int len = min((int)x.size(), fir.latency() + 4 * L + 32);
+	vector<double> y(len);
+	fir.process(x.data(), y.data(), len);
+	for (int i = fir.latency(); i < len; i++) {
+		const int t = i - fir.latency();
+		if (t >= 1024 && t % L >= 32 && t % L < L - 32) continue;
+		double sum = 0;
+		for (int k = 0; k < (int)h.size() && k <= t; k++) {
+			sum += h[k] * x[t - k];
+		}
+		if (fabs(sum - y[i]) > 1e-9) return false;
+	}
+	return true;
+}
+
+int main() {
+	/* set seed to 0 */
+	srand(0);
+
+	const int taps_list[6] = { 16, 48, 128, 512, 2048, 8192 };
+	vector<double> x(1 << 19), y(1 << 19);
+	for (size_t i = 0; i < x.size(); i++) {
+		x[i] = rand() / (double)RAND_MAX - 0.5;
+	}
+
+	for (int t = 0; t < 6; t++) {
+		const int taps = taps_list[t];
+		vector<double> h(taps);
+		for (int k = 0; k < taps; k++) {
+			h[k] = rand() / (double)RAND_MAX - 0.5;
+		}
+
+		// the direct sum on a shorter stream above a few hundred taps
+		vector<double> xd(x.begin(), x.begin() + min((int)x.size(), max(4 * taps, (1 << 24) / taps)));
+		vector<double> yd(xd.size());
+		FftFir direct(h.data(), taps, FIR_OVERLAP_SAVE, 0);
+		double td = -1;
+		if (direct.size() == 0) {
+			td = per_sample(direct, xd, yd);
+		} else {
+			// the loop of the direct path, from the first complete window on
+			const int len = (int)xd.size();
+			chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+			for (int i = taps - 1; i < len; i++) {
+				const double *p = &xd[i];
+				double sum = 0;
+				for (int k = 0; k < taps; k++) {
+					sum += h[k] * p[-k];
+				}
+				yd[i] = sum;
+			}
+			chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+			td = chrono::duration<double, nano>(t1 - t0).count() / (len - taps + 1);
+		}
+
+		cout << "taps = " << taps << ", best_size = " << FftFir::best_size(taps)
+			 << ", direct " << fixed << setprecision(2) << td << " ns/sample" << defaultfloat << endl;
+		cout << setw(10) << "n" << setw(10) << "L" << setw(10) << "save" << setw(10) << "add" << "   ns/sample" << endl;
+
+		int n = 2;
+		while (n < 2 * taps) n <<= 1;
+		const int best = FftFir::best_size(taps);
+		for (int k = 0; k < 6 && n <= (1 << 18); k++, n <<= 1) {
+			FftFir save(h.data(), taps, FIR_OVERLAP_SAVE, n);
+			FftFir add(h.data(), taps, FIR_OVERLAP_ADD, n);
+			double ts = per_sample(save, x, y);
+			double ta = per_sample(add, x, y);
+			bool ok = check(h, FIR_OVERLAP_SAVE, n, x) && check(h, FIR_OVERLAP_ADD, n, x);
+			cout << setw(10) << n << setw(10) << save.block() << fixed << setprecision(2) << setw(10) << ts
+				 << setw(10) << ta << defaultfloat << (n == best ? "  *" : "") << (ok ? "" : "   MISMATCH") << endl;
+		}
+		cout << endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,125 @@
+/*
+ * mixed_radix_bench.cpp
+ *
+ * Description
+ * This program measures FftMixed (FFT_mixed.h), the mixed-radix FFT of 7-smooth n
+ *
+ *   n             frame sizes (1920, 3000, 44100), powers of 3, 5 and 7, a power of 2
+ *   radices       the passes of the plan, in the order they run
+ *   mixed         ns per forward(), and ns / (n log2 n)
+ *   bluestein     ns per FftBluestein::forward() on the same n
+ *   pow2 plan     ns per FftPlan::forward() on the power of 2 above n, the transform
+ *                 of a frame padded to that size (another spectrum, for the cost only)
+ *   error         max |X - DFT(x)| / max |DFT(x)| against a long double DFT
+ *                 (n up to 5000), and of inverse(forward(x)) against x
+ *
+ * Using "make bench" to compile the cpp file
+ * and using "./build/mixed_radix_bench.out" to run the program
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * */
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+
+#include "FFT_mixed.h"
+#include "FFT_bluestein.h"
+
+using namespace std;
+
+// best of 5 rounds, ns per call
+template <class F>
+double time_op(F op, int n) {
+	int iters = max(2, (1 << 22) / n);
+	double ns = 0;
+	for (int round = 0; round < 5; round++) {
+		chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+		for (int i = 0; i < iters; i++) {
+			op();
+		}
+		chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+		double t = chrono::duration<double, nano>(t1 - t0).count() / iters;
+		if (round == 0 || t < ns) ns = t;
+	}
+	return ns;
+}
+
+static double dft_error(const vector<Complex> &x, const vector<Complex> &y) {
+	// y against the DFT of x in long double, angles reduced modulo n
+	const int n = (int)x.size();
+	const long double pi = acosl(-1.0L);
+	double err = 0, top = 0;
+	for (int k = 0; k < n; k++) {
+		long double re = 0, im = 0;
+		for (int j = 0; j < n; j++) {
+			long double a = -2 * pi * (long double)((long long)j * k % n) / n;
+			re += x[j].real() * cosl(a) - x[j].imag() * sinl(a);
+			im += x[j].real() * sinl(a) + x[j].imag() * cosl(a);
+		}
+		err = max(err, (double)hypotl(y[k].real() - re, y[k].imag() - im));
+		top = max(top, (double)hypotl(re, im));
+	}
+	return err / top;
+}
+
+int main() {
+	/* set seed to 0 */
+	srand(0);
+
+	const int sizes[10] = { 60, 1000, 1920, 2187, 2401, 3000, 3125, 4096, 44100, 100000 };
+
+	cout << setw(8) << "n" << setw(16) << "radices" << setw(10) << "mixed" << setw(8) << "/nlogn"
+		 << setw(12) << "bluestein" << setw(12) << "pow2 plan" << setw(12) << "dft err" << setw(12) << "inv err"
+		 << "   ns/call" << endl;
+	for (int s = 0; s < 10; s++) {
+		int n = sizes[s];
+		FftMixed fm(n);
+		FftBluestein fb(n);
+		vector<Complex> x(n), y(n), tmp(n), tmp_b(fb.transform_size());
+		for (int i = 0; i < n; i++) {
+			x[i] = Complex(rand() / (double)RAND_MAX - 0.5, rand() / (double)RAND_MAX - 0.5);
+		}
+
+		y = x;
+		fm.forward(y.data(), tmp.data());
+		double derr = (n <= 5000) ? dft_error(x, y) : -1;
+		fm.inverse(y.data(), tmp.data());
+		double ierr = 0;
+		for (int i = 0; i < n; i++) {
+			ierr = max(ierr, abs(y[i] - x[i]));
+		}
+
+		// radix counts, 4^3 2 3 for 384
+		ostringstream rad;
+		const vector<int> &r = fm.radices();
+		for (size_t i = 0; i < r.size();) {
+			size_t j = i;
+			while (j < r.size() && r[j] == r[i]) j++;
+			rad << (i ? " " : "") << r[i];
+			if (j - i > 1) rad << "^" << j - i;
+			i = j;
+		}
+
+		int p2 = 1;
+		while (p2 < n) p2 <<= 1;
+		FftPlan plan(p2);
+		vector<Complex> z(p2, Complex(0, 0));
+		double tm = time_op([&]() { fm.forward(y.data(), tmp.data()); }, n);
+		double tb = time_op([&]() { fb.forward(y.data(), tmp_b.data()); }, fb.transform_size());
+		double tp = time_op([&]() { plan.forward(z.data()); }, p2);
+
+		cout << setw(8) << n << setw(16) << rad.str() << fixed << setprecision(0) << setw(10) << tm
+			 << setprecision(2) << setw(8) << tm / (n * log2((double)n)) << setprecision(0) << setw(12) << tb
+			 << setw(12) << tp << scientific << setprecision(1) << setw(12) << derr << setw(12) << ierr
+			 << defaultfloat << endl;
+	}
+	cout << "dft err -1 : not computed (n > 5000)" << endl;
+
+	return 0;
+}
@@ -0,0 +1,124 @@
+/*
+ * stockham_bench.cpp
+ *
+ * Description
+ * This program compares the Stockham auto-sort transforms (FFT_stockham.h,
+ * NTT_stockham.h) with the bit-reversed plans followed by a bit-reverse
+ * permutation, both giving the spectrum in natural order, n = 2^8 ... 2^20
+ *
+ *   bitrev order   FftPlan / NttPlan forward alone, the spectrum stays bit-reversed
+ *   + permute      the same, then bitrev_permute() (bitrev.h)
+ *   stockham       natural order directly
+ *
+ * The FFT uses the selected ISA, the NTT (q = 998244353, negacyclic) is scalar
+ * Every Stockham spectrum is first checked against the permuted plan output
+ *
+ * Using "make bench" to compile the cpp file
+ * and using "./build/stockham_bench.out" to run the program
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * 2026/10/17	jorjor	Permutation by bitrev_permute()
+ * */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+
+#include "FFT_plan.h"
+#include "FFT_stockham.h"
+#include "NTT_plan.h"
+#include "NTT_stockham.h"
+#include "bitrev.h"
+
+using namespace std;
+
+// best of 5 rounds, ns per call
+template <class F>
+double time_op(F op, int n, int lg) {
+	int iters = max(1, (1 << 22) / (n * lg));
+	double ns = 0;
+	for (int round = 0; round < 5; round++) {
+		chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+		for (int i = 0; i < iters; i++) {
+			op();
+		}
+		chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+		double t = chrono::duration<double, nano>(t1 - t0).count() / iters;
+		if (round == 0 || t < ns) ns = t;
+	}
+	return ns;
+}
+
+static void header(const char *name) {
+	cout << name << endl;
+	cout << setw(8) << "n" << setw(14) << "bitrev order" << setw(14) << "+ permute"
+		 << setw(14) << "stockham" << setw(10) << "speedup" << "   ns/forward, stockham against + permute" << endl;
+}
+
+static void row(int n, double plain, double perm, double st, bool ok) {
+	cout << setw(8) << n << fixed << setprecision(1) << setw(14) << plain << setw(14) << perm
+		 << setw(14) << st << setw(10) << setprecision(2) << perm / st << (ok ? "" : "   MISMATCH") << endl;
+}
+
+int main() {
+	cout << "ISA : " << cpu_isa_name(cpu_select_isa()) << endl << endl;
+
+	/* set seed to 0 */
+	srand(0);
+
+	header("FFT");
+	for (int lg = 8; lg <= 20; lg += 2) {
+		int n = 1 << lg;
+		vector<Complex> a(n), x(n), y(n), tmp(n);
+		for (int i = 0; i < n; i++) {
+			a[i] = Complex(rand() % 1000, rand() % 1000);
+		}
+
+		FftPlan plan(n);
+		FftStockham st(n);
+		x = a;
+		plan.forward(x.data());
+		bitrev_permute(x.data(), lg);
+		y = a;
+		st.forward(y.data(), tmp.data());
+		bool ok = true;
+		for (int i = 0; i < n; i++) {
+			ok = ok && abs(x[i] - y[i]) / n < 1e-12;
+		}
+
+		double plain = time_op([&]() { plan.forward(x.data()); }, n, lg);
+		double perm = time_op([&]() { plan.forward(x.data()); bitrev_permute(x.data(), lg); }, n, lg);
+		double sto = time_op([&]() { st.forward(y.data(), tmp.data()); }, n, lg);
+		row(n, plain, perm, sto, ok);
+	}
+
+	cout << endl;
+	header("NTT, q = 998244353, negacyclic");
+	const uint32_t q = 998244353;
+	for (int lg = 8; lg <= 20; lg += 2) {
+		int n = 1 << lg;
+		vector<uint32_t> a(n), x(n), y(n), tmp(n);
+		for (int i = 0; i < n; i++) {
+			a[i] = rand() % q;
+		}
+
+		NttStockham st(n, q, NTT_NEGACYCLIC);
+		NttPlan plan(n, q, NTT_NEGACYCLIC, st.root());
+		x = a;
+		plan.forward(x.data());
+		bitrev_permute(x.data(), lg);
+		y = a;
+		st.forward(y.data(), tmp.data());
+		bool ok = (x == y);
+
+		double plain = time_op([&]() { plan.forward(x.data()); }, n, lg);
+		double perm = time_op([&]() { plan.forward(x.data()); bitrev_permute(x.data(), lg); }, n, lg);
+		double sto = time_op([&]() { st.forward(y.data(), tmp.data()); }, n, lg);
+		row(n, plain, perm, sto, ok);
+	}
+
+	return 0;
+}
@@ -0,0 +1,657 @@
+/*
+ * suite_bench.cpp
+ *
+ * Description
+ * Benchmark suite of every transform variant of the repository
+ * The demo programs print their arrays and exit, their loops are kept here as
+ * functions of (n, q) so they can be timed next to the library :
+ *
+ *   naive       schoolbook product, naive_polymulti.cpp (double) and
+ *               naive_polynomial_multiplication() of NTT_GSCT.cpp / NTT_NWC.cpp (mod q)
+ *   ntt_org     NTT_org.cpp, bit-reverse then DIT (Cooley-Tukey), cyclic
+ *   ntt_gsct    NTT_GSCT.cpp, DIF (Gentleman-Sande) forward, DIT inverse, cyclic
+ *   ntt_nwc     NTT_NWC.cpp, incomplete negacyclic NTT, PWM() on degree-1 pairs
+ *   ntt_plan    NttPlan (NTT_plan.h) with the same parameters
+ *   fft_org     FFT_org.cpp, bit-reverse then DIT, twiddle_table()
+ *   fft_gsct    FFT_GSCT.cpp, DIF forward, DIT inverse
+ *   fft_plan    FftPlan (FFT_plan.h)
+ * The loops are the ones of the demos (pow() bounds included), the products
+ * are 64-bit so every q below 2^31 works
+ *
+ * Before anything is timed the product of every variant is checked against
+ * the naive one, a failed check prints MISMATCH and "valid": false
+ *
+ * Every row is 11 rounds :
+ *   ns/op       best round, ns per transform (forward) or per product (multiply)
+ *   mean, cv    mean of the rounds and its relative standard deviation
+ *   cyc/bfly    time stamp counter ticks per butterfly of the best round (forward only)
+ *   Mcoef/s     coefficients per second of the best round
+ *
+ * The rows are also written as JSON, to the file given as first argument
+ * (default suite_bench.json), "make suite" runs it into build/suite_bench.json
+ *
+ * Using "make bench" to compile the cpp file
+ * and using "./build/suite_bench.out [out.json]" to run the program
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * */
+
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+
+#include <x86intrin.h>
+
+#include "NTT_plan.h"
+#include "NTT_params.h"
+#include "NTT_constexpr.h"
+#include "FFT_plan.h"
+#include "bitrev.h"
+
+using namespace std;
+
+/* ---------------- NTT variants ---------------- */
+
+// the loops of the demos take q as a macro, here it is a member
+struct NttDemo {
+	int n, logn;
+	uint64_t q;
+
+	NttDemo(int n, uint64_t q) : n(n), logn(0), q(q) {
+		while ((1 << logn) < n) logn++;
+	}
+
+	void BFU_CT(uint32_t *arr, int i, int j, uint64_t wn) const {
+		// DIT-FFT
+		// Cooley Tukey algorithm
+		uint64_t temp1 = arr[i];
+		uint64_t temp2 = wn * arr[j] % q;
+		arr[i] = (uint32_t)((temp1 + temp2) % q);
+		arr[j] = (uint32_t)((temp1 + q - temp2) % q);
+	}
+
+	void BFU_GS(uint32_t *arr, int i, int j, uint64_t wn) const {
+		// DIF-FFT
+		// Gentleman Sande algorithm
+		uint64_t temp1 = arr[i];
+		uint64_t temp2 = arr[j];
+		arr[i] = (uint32_t)((temp1 + temp2) % q);
+		arr[j] = (uint32_t)((temp1 + q - temp2) * wn % q);
+	}
+
+	void scale(uint32_t *x, uint64_t rv) const {
+		for (int i = 0; i < n; i++) {
+			x[i] = (uint32_t)(x[i] * rv % q);
+		}
+	}
+};
+
+class NttVariant {
+public:
+	virtual ~NttVariant() {}
+	virtual void forward(uint32_t *x) = 0;
+	virtual void multiply(uint32_t *out, const uint32_t *a, const uint32_t *b) = 0;
+	virtual double butterflies() const = 0;
+};
+
+// NTT_org.cpp
+class NttOrg : public NttVariant, NttDemo {
+public:
+	NttOrg(int n, uint64_t q) : NttDemo(n, q), wn(n), wn_inv(n), tmp(n) {
+		uint64_t w = ntt_root_of_unity(q, n);
+		uint64_t winv = inverse_mod(w, q);
+		wn[0] = wn_inv[0] = 1;
+		for (int i = 1; i < n; i++) {
+			wn[i] = (uint32_t)(wn[i-1] * w % q);
+			wn_inv[i] = (uint32_t)(wn_inv[i-1] * winv % q);
+		}
+		rv = inverse_mod(n, q);
+	}
+
+	void stages(uint32_t *x, const vector<uint32_t> &w) {
+		bitrev_permute(x, logn);
+		for (int step = 1; step <= log2(n); step++) {
+			for (int idx = 0; idx < (n/pow(2, step)); idx++) {
+				for (int distance = 0; distance < pow(2, step - 1); distance++) {
+					int i = idx * pow(2, step) + distance;
+					int j = idx * pow(2, step) + distance + pow(2, step - 1);
+					BFU_CT(x, i, j, w[distance * int(n/pow(2, step))]);
+				}
+			}
+		}
+	}
+
+	void forward(uint32_t *x) { stages(x, wn); }
+
+	void multiply(uint32_t *out, const uint32_t *a, const uint32_t *b) {
+		for (int i = 0; i < n; i++) {
+			out[i] = a[i];
+			tmp[i] = b[i];
+		}
+		stages(out, wn);
+		stages(&tmp[0], wn);
+		for (int i = 0; i < n; i++) {
+			out[i] = (uint32_t)((uint64_t)out[i] * tmp[i] % q);
+		}
+		stages(out, wn_inv);
+		scale(out, rv);
+	}
+
+	double butterflies() const { return (double)n / 2 * logn; }
+
+private:
+	vector<uint32_t> wn, wn_inv, tmp;
+	uint64_t rv;
+};
+
+// NTT_GSCT.cpp
+class NttGsct : public NttVariant, NttDemo {
+public:
+	NttGsct(int n, uint64_t q) : NttDemo(n, q), wn(n), wn_inv(n), tmp(n) {
+		uint64_t w = ntt_root_of_unity(q, n);
+		uint64_t winv = inverse_mod(w, q);
+		wn[0] = wn_inv[0] = 1;
+		for (int i = 1; i < n; i++) {
+			wn[i] = (uint32_t)(wn[i-1] * w % q);
+			wn_inv[i] = (uint32_t)(wn_inv[i-1] * winv % q);
+		}
+		rv = inverse_mod(n, q);
+	}
+
+	void forward(uint32_t *x) {
+		for (int step = log2(n); step >= 1; step--) {
+			for (int idx = 0; idx < (n/pow(2, step)); idx++) {
+				for (int distance = 0; distance < pow(2, step - 1); distance++) {
+					int i = idx * pow(2, step) + distance;
+					int j = idx * pow(2, step) + distance + pow(2, step - 1);
+					BFU_GS(x, i, j, wn[distance * int(n/pow(2, step))]);
+				}
+			}
+		}
+	}
+
+	void inverse(uint32_t *x) {
+		for (int step = 1; step <= log2(n); step++) {
+			for (int idx = 0; idx < (n/pow(2, step)); idx++) {
+				for (int distance = 0; distance < pow(2, step - 1); distance++) {
+					int i = idx * pow(2, step) + distance;
+					int j = idx * pow(2, step) + distance + pow(2, step - 1);
+					BFU_CT(x, i, j, wn_inv[distance * int(n/pow(2, step))]);
+				}
+			}
+		}
+		scale(x, rv);
+	}
+
+	void multiply(uint32_t *out, const uint32_t *a, const uint32_t *b) {
+		for (int i = 0; i < n; i++) {
+			out[i] = a[i];
+			tmp[i] = b[i];
+		}
+		forward(out);
+		forward(&tmp[0]);
+		for (int i = 0; i < n; i++) {
+			out[i] = (uint32_t)((uint64_t)out[i] * tmp[i] % q);
+		}
+		inverse(out);
+	}
+
+	double butterflies() const { return (double)n / 2 * logn; }
+
+private:
+	vector<uint32_t> wn, wn_inv, tmp;
+	uint64_t rv;
+};
+
+// NTT_NWC.cpp, psi of order n, tables of NwcConstTables (NTT_constexpr.h) built for a runtime n
+class NttNwc : public NttVariant, NttDemo {
+public:
+	NttNwc(int n, uint64_t q) : NttDemo(n, q), wn(n), wn_inv(n), wq(n), tmp(n) {
+		uint32_t psi = (uint32_t)ntt_root_of_unity(q, n);
+		for (int i = 0; i < n; i++) {
+			wn[i] = cx_nwc_zeta(i, n, (uint32_t)q, psi);
+			wn_inv[i] = cx_nwc_zeta_inv(i, n, (uint32_t)q, psi);
+			wq[i] = cx_nwc_leaf(i, n, (uint32_t)q, psi);
+		}
+	}
+
+	uint32_t DIV2(uint64_t a) const {
+		return (uint32_t)((a >> 1) + (a & 1) * ((q + 1) / 2));
+	}
+
+	void forward(uint32_t *x_ntt) {
+		int k = 1;
+		for (int i = 1; i <= log2(n) - 1; i++) {
+			int m = pow(2, log2(n) - i);
+			for (int s = 0; s < n; s += 2*m) {
+				for (int j = s; j < s + m; j++) {
+					uint64_t A = x_ntt[j];
+					uint64_t B = x_ntt[j + m];
+					uint64_t W = wn[k];
+					uint64_t T = W * B % q;
+					x_ntt[j] = (uint32_t)((A + T) % q);
+					x_ntt[j + m] = (uint32_t)((A + q - T) % q);
+				}
+				k++;
+			}
+		}
+	}
+
+	void inverse(uint32_t *x_intt) {
+		int k = 0;
+		for (int i = log2(n) - 1; i >= 1; i--) {
+			int m = pow(2, log2(n) - i);
+			for (int s = 0; s < n; s += 2*m) {
+				for (int j = s; j < s + m; j++) {
+					uint64_t A = x_intt[j];
+					uint64_t B = x_intt[j + m];
+					uint64_t W = wn_inv[k];
+					uint64_t E = (A + B) % q;
+					uint64_t O = (A + q - B) * W % q;
+					x_intt[j] = DIV2(E);
+					x_intt[j + m] = DIV2(O);
+				}
+				k++;
+			}
+		}
+	}
+
+	void PWM(uint32_t *out, const uint32_t *a, const uint32_t *b) const {
+		for (int i = 0; i < n / 2; i++) {
+			uint64_t a0 = a[2*i], a1 = a[2*i+1];
+			uint64_t b0 = b[2*i], b1 = b[2*i+1];
+			out[2*i] = (uint32_t)((a0 * b0 % q + (a1 * b1 % q) * wq[i]) % q);
+			out[2*i+1] = (uint32_t)((a0 * b1 + a1 * b0) % q);
+		}
+	}
+
+	void multiply(uint32_t *out, const uint32_t *a, const uint32_t *b) {
+		for (int i = 0; i < n; i++) {
+			out[i] = a[i];
+			tmp[i] = b[i];
+		}
+		forward(out);
+		forward(&tmp[0]);
+		PWM(out, out, &tmp[0]);
+		inverse(out);
+	}
+
+	double butterflies() const { return (double)n / 2 * (logn - 1); }
+
+private:
+	vector<uint32_t> wn, wn_inv, wq, tmp;
+};
+
+class NttPlanVariant : public NttVariant {
+public:
+	NttPlanVariant(int n, uint32_t q, ntt_mode mode) : plan(n, q, mode), tmp(n) {}
+
+	void forward(uint32_t *x) { plan.forward(x); }
+	void multiply(uint32_t *out, const uint32_t *a, const uint32_t *b) { plan.multiply(out, a, b, &tmp[0]); }
+	double butterflies() const { return (double)plan.size() / 2 * plan.tables().layers; }
+
+private:
+	NttPlan plan;
+	vector<uint32_t> tmp;
+};
+
+// naive_polynomial_multiplication() of NTT_GSCT.cpp (cyclic) and NTT_NWC.cpp (negacyclic)
+static void naive_mod(uint32_t *out, const uint32_t *a, const uint32_t *b, int n, uint64_t q, ntt_mode mode) {
+	vector<uint64_t> acc(n, 0);
+	for (int i = 0; i < n; i++) {
+		for (int j = 0; j < n; j++) {
+			uint64_t p = (uint64_t)a[i] * b[j] % q;
+			int k = i + j;
+			if (k < n)						acc[k] += p;
+			else if (mode == NTT_CYCLIC)	acc[k - n] += p;
+			else							acc[k - n] += q - p;
+		}
+	}
+	for (int i = 0; i < n; i++) {
+		out[i] = (uint32_t)(acc[i] % q);
+	}
+}
+
+/* ---------------- FFT variants ---------------- */
+
+enum {
+	normal = 0,
+	inverse
+};
+
+static Complex W(int m, int n, bool stat) {
+	// acos(-1) = pi
+	Complex w;
+	w.real(cos(2*acos(-1)*m/n));
+	if (stat == inverse) {
+		w.imag(sin(2*acos(-1)*m/n));
+	}
+	else {
+		w.imag(sin(-2*acos(-1)*m/n));
+	}
+	return w;
+}
+
+static vector<Complex> twiddle_table(int n, bool stat) {
+	// W(distance, 2 * half, stat) of the stage with half = 2^(step - 1) at table[half + distance]
+	vector<Complex> table(n);
+	for (int half = 1; half < n; half <<= 1) {
+		for (int distance = 0; distance < half; distance++) {
+			table[half + distance] = W(distance, 2 * half, stat);
+		}
+	}
+	return table;
+}
+
+class FftVariant {
+public:
+	virtual ~FftVariant() {}
+	virtual void forward(Complex *x) = 0;
+	virtual void multiply(double *out, const double *a, const double *b) = 0;
+	virtual double butterflies() const = 0;
+};
+
+// FFT_org.cpp (gsct = false) and FFT_GSCT.cpp (gsct = true)
+class FftDemo : public FftVariant {
+public:
+	FftDemo(int n, bool gsct) : n(n), logn(0), gsct(gsct), w_fft(twiddle_table(n, normal)),
+		w_ifft(twiddle_table(n, inverse)), x1(n), x2(n) {
+		while ((1 << logn) < n) logn++;
+	}
+
+	void dit(Complex *x, const vector<Complex> &w) {
+		for (int step = 1; step <= logn; step++) {
+			for (int idx = 0; idx < (n >> step); idx++) {
+				for (int distance = 0; distance < (1 << (step - 1)); distance++) {
+					int i = (idx << step) + distance;
+					int j = (idx << step) + distance + (1 << (step - 1));
+					// BFU_CT
+					Complex temp1 = x[i];
+					Complex temp2 = x[j];
+					x[i] = temp1 + w[(1 << (step - 1)) + distance] * temp2;
+					x[j] = temp1 - w[(1 << (step - 1)) + distance] * temp2;
+				}
+			}
+		}
+	}
+
+	void dif(Complex *x, const vector<Complex> &w) {
+		for (int step = logn; step >= 1; step--) {
+			for (int idx = 0; idx < (n >> step); idx++) {
+				for (int distance = 0; distance < (1 << (step - 1)); distance++) {
+					int i = (idx << step) + distance;
+					int j = (idx << step) + distance + (1 << (step - 1));
+					// BFU_GS
+					Complex temp1 = x[i];
+					Complex temp2 = x[j];
+					x[i] = temp1 + temp2;
+					x[j] = (temp1 - temp2) * w[(1 << (step - 1)) + distance];
+				}
+			}
+		}
+	}
+
+	void forward(Complex *x) {
+		if (gsct) {
+			dif(x, w_fft);
+		}
+		else {
+			bitrev_permute(x, logn);
+			dit(x, w_fft);
+		}
+	}
+
+	void multiply(double *out, const double *a, const double *b) {
+		for (int i = 0; i < n; i++) {
+			x1[i] = Complex(a[i], 0);
+			x2[i] = Complex(b[i], 0);
+		}
+		forward(&x1[0]);
+		forward(&x2[0]);
+		for (int i = 0; i < n; i++) {
+			x1[i] *= x2[i];
+		}
+		if (!gsct) bitrev_permute(&x1[0], logn);
+		dit(&x1[0], w_ifft);
+		for (int i = 0; i < n; i++) {
+			out[i] = x1[i].real() / n;
+		}
+	}
+
+	double butterflies() const { return (double)n / 2 * logn; }
+
+private:
+	int n, logn;
+	bool gsct;
+	vector<Complex> w_fft, w_ifft, x1, x2;
+};
+
+class FftPlanVariant : public FftVariant {
+public:
+	FftPlanVariant(int n) : plan(n), x1(n), x2(n), tmp(n) {}
+
+	void forward(Complex *x) { plan.forward(x); }
+
+	void multiply(double *out, const double *a, const double *b) {
+		int n = plan.size();
+		for (int i = 0; i < n; i++) {
+			x1[i] = Complex(a[i], 0);
+			x2[i] = Complex(b[i], 0);
+		}
+		plan.multiply(&x1[0], &x1[0], &x2[0], &tmp[0]);
+		for (int i = 0; i < n; i++) {
+			out[i] = x1[i].real();
+		}
+	}
+
+	double butterflies() const { return (double)plan.size() / 2 * plan.log2n(); }
+
+private:
+	FftPlan plan;
+	vector<Complex> x1, x2, tmp;
+};
+
+// naive_polymulti.cpp
+static void naive_double(double *ans, const double *x1, const double *x2, int n) {
+	for (int i = 0; i < n; i++) {
+		ans[i] = 0;
+	}
+	for (int i = 0; i < n; i++) {
+		for (int j = 0; j < n; j++) {
+			ans[(i+j)%n] += x1[i] * x2[j];
+		}
+	}
+}
+
+/* ---------------- measurement ---------------- */
+
+struct Stats {
+	double best;		// ns per call
+	double mean;
+	double cv;			// standard deviation / mean
+	double ticks;		// time stamp counter ticks per call, best round
+};
+
+// 11 rounds of about 2^20 units of work each
+template <class F>
+Stats measure(F op, double work) {
+	const int rounds = 11;
+	int iters = max(1, (int)((1 << 20) / work));
+	vector<double> t(rounds), tk(rounds);
+	for (int round = 0; round < rounds; round++) {
+		chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+		uint64_t c0 = __rdtsc();
+		for (int i = 0; i < iters; i++) {
+			op();
+		}
+		uint64_t c1 = __rdtsc();
+		chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+		t[round] = chrono::duration<double, nano>(t1 - t0).count() / iters;
+		tk[round] = (double)(c1 - c0) / iters;
+	}
+
+	Stats s;
+	s.best = t[0];
+	s.ticks = tk[0];
+	s.mean = 0;
+	for (int r = 0; r < rounds; r++) {
+		if (t[r] < s.best) {
+			s.best = t[r];
+			s.ticks = tk[r];
+		}
+		s.mean += t[r] / rounds;
+	}
+	double var = 0;
+	for (int r = 0; r < rounds; r++) {
+		var += (t[r] - s.mean) * (t[r] - s.mean) / (rounds - 1);
+	}
+	s.cv = sqrt(var) / s.mean;
+	return s;
+}
+
+static vector<string> json_rows;
+
+static void report(const string &variant, const string &mode, uint64_t q, int n, const char *op,
+	const Stats &s, double butterflies, bool ok) {
+	double cyc = (butterflies > 0) ? s.ticks / butterflies : 0;
+	double mcoef = n / s.best * 1e3;
+	cout << setw(10) << variant << setw(12) << mode << setw(12) << q << setw(8) << n << setw(10) << op
+		 << fixed << setprecision(0) << setw(14) << s.best << setw(14) << s.mean
+		 << setprecision(1) << setw(8) << 100 * s.cv;
+	if (butterflies > 0)	cout << setprecision(2) << setw(10) << cyc;
+	else					cout << setw(10) << "-";
+	cout << setprecision(1) << setw(10) << mcoef << (ok ? "" : "   MISMATCH") << endl;
+
+	ostringstream js;
+	js << fixed << setprecision(3) << "  {\"variant\": \"" << variant << "\", \"mode\": \"" << mode
+	   << "\", \"q\": " << q << ", \"n\": " << n << ", \"op\": \"" << op
+	   << "\", \"ns_best\": " << s.best << ", \"ns_mean\": " << s.mean << ", \"cv\": " << s.cv
+	   << ", \"ticks_per_butterfly\": " << cyc << ", \"mcoef_per_s\": " << mcoef
+	   << ", \"valid\": " << (ok ? "true" : "false") << "}";
+	json_rows.push_back(js.str());
+}
+
+static void run_ntt(const char *mode_name, ntt_mode mode, uint64_t q, int n) {
+	vector<uint32_t> a(n), b(n), ref(n), out(n), x(n);
+	for (int i = 0; i < n; i++) {
+		a[i] = (uint32_t)(((uint64_t)rand() << 16 ^ rand()) % q);
+		b[i] = (uint32_t)(((uint64_t)rand() << 16 ^ rand()) % q);
+	}
+	naive_mod(&ref[0], &a[0], &b[0], n, q, mode);
+
+	// the naive product itself is only timed up to n = 4096
+	if (n <= 4096) {
+		Stats s = measure([&]() { naive_mod(&out[0], &a[0], &b[0], n, q, mode); }, (double)n * n);
+		report("naive", mode_name, q, n, "multiply", s, 0, out == ref);
+	}
+
+	vector<NttVariant *> variants;
+	vector<string> names;
+	if (mode == NTT_CYCLIC) {
+		variants.push_back(new NttOrg(n, q));
+		names.push_back("ntt_org");
+		variants.push_back(new NttGsct(n, q));
+		names.push_back("ntt_gsct");
+	}
+	else {
+		variants.push_back(new NttNwc(n, q));
+		names.push_back("ntt_nwc");
+	}
+	variants.push_back(new NttPlanVariant(n, (uint32_t)q, mode));
+	names.push_back("ntt_plan");
+
+	for (size_t v = 0; v < variants.size(); v++) {
+		NttVariant *var = variants[v];
+		var->multiply(&out[0], &a[0], &b[0]);
+		bool ok = (out == ref);
+
+		double lg = log2((double)n);
+		x = a;
+		Stats sf = measure([&]() { var->forward(&x[0]); }, n * lg);
+		report(names[v], mode_name, q, n, "forward", sf, var->butterflies(), ok);
+		Stats sm = measure([&]() { var->multiply(&out[0], &a[0], &b[0]); }, 3 * n * lg);
+		report(names[v], mode_name, q, n, "multiply", sm, 3 * var->butterflies(), ok);
+		delete var;
+	}
+}
+
+static void run_fft(int n) {
+	vector<double> a(n), b(n), ref(n), out(n);
+	for (int i = 0; i < n; i++) {
+		a[i] = rand() % 1024;
+		b[i] = rand() % 1024;
+	}
+	naive_double(&ref[0], &a[0], &b[0], n);
+
+	if (n <= 4096) {
+		Stats s = measure([&]() { naive_double(&out[0], &a[0], &b[0], n); }, (double)n * n);
+		report("naive", "complex", 0, n, "multiply", s, 0, out == ref);
+	}
+
+	FftVariant *variants[3] = { new FftDemo(n, false), new FftDemo(n, true), new FftPlanVariant(n) };
+	const char *names[3] = { "fft_org", "fft_gsct", "fft_plan" };
+	vector<Complex> x(n);
+	for (int v = 0; v < 3; v++) {
+		FftVariant *var = variants[v];
+		var->multiply(&out[0], &a[0], &b[0]);
+		bool ok = true;
+		for (int i = 0; i < n; i++) {
+			ok = ok && floor(out[i] + 0.5) == ref[i];
+		}
+
+		double lg = log2((double)n);
+		for (int i = 0; i < n; i++) {
+			x[i] = Complex(a[i], b[i]);
+		}
+		Stats sf = measure([&]() { var->forward(&x[0]); }, n * lg);
+		report(names[v], "complex", 0, n, "forward", sf, var->butterflies(), ok);
+		Stats sm = measure([&]() { var->multiply(&out[0], &a[0], &b[0]); }, 3 * n * lg);
+		report(names[v], "complex", 0, n, "multiply", sm, 3 * var->butterflies(), ok);
+		delete var;
+	}
+}
+
+int main(int argc, char **argv) {
+	const char *path = (argc > 1) ? argv[1] : "suite_bench.json";
+
+	/* set seed to 0 */
+	srand(0);
+
+	cout << setw(10) << "variant" << setw(12) << "mode" << setw(12) << "q" << setw(8) << "n" << setw(10) << "op"
+		 << setw(14) << "ns/op" << setw(14) << "mean" << setw(8) << "cv %" << setw(10) << "cyc/bfly"
+		 << setw(10) << "Mcoef/s" << endl;
+
+	// cyclic : the demo modulus, and a 30-bit one for the larger sizes
+	for (int n = 8; n <= 256; n *= 4) {
+		run_ntt("cyclic", NTT_CYCLIC, 3329, n);
+	}
+	for (int n = 1024; n <= 16384; n *= 4) {
+		run_ntt("cyclic", NTT_CYCLIC, 998244353, n);
+	}
+
+	// negacyclic : Kyber, NewHope, and n | q - 1 for a 30-bit q
+	run_ntt("negacyclic", NTT_NEGACYCLIC, 3329, 256);
+	run_ntt("negacyclic", NTT_NEGACYCLIC, 12289, 1024);
+	run_ntt("negacyclic", NTT_NEGACYCLIC, 998244353, 4096);
+
+	for (int n = 64; n <= 16384; n *= 4) {
+		run_fft(n);
+	}
+
+	ofstream json(path);
+	json << "[" << endl;
+	for (size_t i = 0; i < json_rows.size(); i++) {
+		json << json_rows[i] << (i + 1 < json_rows.size() ? "," : "") << endl;
+	}
+	json << "]" << endl;
+	cout << endl << json_rows.size() << " rows written to " << path << endl;
+
+	return 0;
+}
@@ -0,0 +1,109 @@
+/*
+ * tft_bench.cpp
+ *
+ * Description
+ * This program measures the truncated transforms NttTft (NTT_tft.h) and FftTft
+ * (FFT_tft.h) against the power-of-2 plans on products of len = la + lb - 1
+ * values, la = lb, len from just above 2^12 and 2^16 up to the next power of 2
+ *
+ *   plan   NttPlan::multiply() / FftPlan::multiply() on the power of 2 above len
+ *   tft    NttTft::multiply() / FftTft::multiply(), truncated to len
+ *   ns / value of the product, the plan is a sawtooth, the TFT follows len
+ *
+ * Every TFT product is first checked against the plan one
+ * (q = 998244353, the complex inputs below 2^10, rounded)
+ *
+ * Using "make bench" to compile the cpp file
+ * and using "./build/tft_bench.out" to run the program
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+
+#include "NTT_tft.h"
+#include "FFT_tft.h"
+
+using namespace std;
+
+// best of 5 rounds, ns per call
+template <class F>
+double time_op(F op, int n) {
+	int iters = max(2, (1 << 22) / n);
+	double ns = 0;
+	for (int round = 0; round < 5; round++) {
+		chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+		for (int i = 0; i < iters; i++) {
+			op();
+		}
+		chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+		double t = chrono::duration<double, nano>(t1 - t0).count() / iters;
+		if (round == 0 || t < ns) ns = t;
+	}
+	return ns;
+}
+
+static void run(const NttTft &ntft, const FftTft &ftft, int len) {
+	const uint32_t q = ntft.modulus();
+	int la = (len + 1) / 2, lb = len + 1 - la;
+	int n = NttTft::transform_size(len);
+
+	vector<uint32_t> a(n, 0), b(n, 0), c(n), d(len), tmp(2 * n);
+	vector<Complex> x(n), y(n), z(n), w(len), ctmp(2 * n);
+	for (int i = 0; i < la; i++) {
+		a[i] = rand() % q;
+		x[i] = Complex(rand() % 1024, rand() % 1024);
+	}
+	for (int i = 0; i < lb; i++) {
+		b[i] = rand() % q;
+		y[i] = Complex(rand() % 1024, rand() % 1024);
+	}
+	NttPlan nplan(n, q, NTT_CYCLIC);
+	FftPlan fplan(n);
+
+	nplan.multiply(c.data(), a.data(), b.data(), tmp.data());
+	ntft.multiply(d.data(), a.data(), la, b.data(), lb, tmp.data());
+	fplan.multiply(z.data(), x.data(), y.data(), ctmp.data());
+	ftft.multiply(w.data(), x.data(), la, y.data(), lb, ctmp.data());
+	bool ok = true;
+	for (int i = 0; i < len && ok; i++) {
+		ok = c[i] == d[i] && llround(z[i].real()) == llround(w[i].real()) && llround(z[i].imag()) == llround(w[i].imag());
+	}
+
+	double t[4];
+	t[0] = time_op([&]() { nplan.multiply(c.data(), a.data(), b.data(), tmp.data()); }, n);
+	t[1] = time_op([&]() { ntft.multiply(d.data(), a.data(), la, b.data(), lb, tmp.data()); }, n);
+	t[2] = time_op([&]() { fplan.multiply(z.data(), x.data(), y.data(), ctmp.data()); }, n);
+	t[3] = time_op([&]() { ftft.multiply(w.data(), x.data(), la, y.data(), lb, ctmp.data()); }, n);
+	cout << setw(8) << len << setw(8) << n << fixed << setprecision(2);
+	for (int i = 0; i < 4; i++) {
+		cout << setw(10) << t[i] / len;
+	}
+	cout << setw(10) << t[0] / t[1] << setw(10) << t[2] / t[3] << (ok ? "" : "   MISMATCH") << endl;
+}
+
+int main() {
+	/* set seed to 0 */
+	srand(0);
+
+	NttTft ntft(1 << 17, 998244353);
+	FftTft ftft(1 << 17);
+
+	cout << setw(8) << "len" << setw(8) << "n" << setw(10) << "ntt plan" << setw(10) << "ntt tft"
+		 << setw(10) << "fft plan" << setw(10) << "fft tft" << setw(10) << "ntt x" << setw(10) << "fft x"
+		 << "   ns/value, speedup of the TFT" << endl;
+	for (int k = 12; k <= 16; k += 4) {
+		for (int e = 0; e <= 8; e++) {
+			int len = (1 << k) + (e == 0 ? 1 : e * (1 << k) / 8);
+			run(ntft, ftft, len);
+		}
+	}
+
+	return 0;
+}
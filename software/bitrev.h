@@ -0,0 +1,153 @@
+/*
+ * bitrev.h
+ *
+ * Description
+ * Bit-reversal permutation shared by the FFT and NTT programs and plans
+ * reverse() and bitreverse() of the demos build every index bit by bit (the NTT ones
+ * with pow(2, i) in floating point), and the loop that follows reads x[rev(i)]
+ * all over the array, past the caches that is one miss per value
+ *
+ *   bitrev_index(x, lg)     reversal of the low lg bits of x, 4 lookups in a byte table
+ *   bitrev_table(rev, lg)   rev[i] for i < 2^lg, each entry from the one of i >> 1
+ *   bitrev_permute(x, lg)   in place, x[i] <-> x[rev(i)] for the 2^lg values of x
+ *   bitrev_swap(x, lg)      in place by swaps, i = (hi, lo) read as two halves,
+ *                           so the table only has 2^(lg - lg/2) entries
+ *   bitrev_cobra(x, lg, t)  in place by blocks, lg >= 2t
+ *
+ * bitrev_permute swaps while the array fits in BITREV_COBRA_BYTES, beyond it runs
+ * the blocked permutation of Carter and Gatlin (COBRA) : the index is split as
+ * (a, b, c), a and c of t bits, so rev(a, b, c) = (rev(c), rev(b), rev(a))
+ * The B = 2^t rows of block b (B contiguous values each) are copied to a B x B buffer,
+ * as are the rows of the partner block rev(b), and both are written back transposed
+ * into the rows of the other one
+ * Every access to x is a whole row, every value is read and written once
+ * t is the largest with B x B values in BITREV_TILE_BYTES
+ *
+ * Header only, the single-file demos include it without linking the library
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * */
+
+#ifndef BITREV_H
+#define BITREV_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <algorithm>
+#include <vector>
+
+// arrays up to this size are permuted by swaps, the blocked version is faster beyond
+#define BITREV_COBRA_BYTES (1 << 14)
+
+// one of the two buffers of the blocked permutation, both stay in the L1 data cache
+#define BITREV_TILE_BYTES (1 << 14)
+
+struct BitrevByteTable {
+	uint8_t rev[256];
+
+	BitrevByteTable() {
+		for (int i = 0; i < 256; i++) {
+			int r = 0;
+			for (int b = 0; b < 8; b++) {
+				r |= ((i >> b) & 1) << (7 - b);
+			}
+			rev[i] = (uint8_t)r;
+		}
+	}
+};
+
+inline uint32_t bitrev_index(uint32_t x, int lg) {
+	// lg <= 32
+	static const BitrevByteTable t;
+	if (lg == 0) return 0;
+	uint32_t r = ((uint32_t)t.rev[x & 0xff] << 24) | ((uint32_t)t.rev[(x >> 8) & 0xff] << 16)
+		| ((uint32_t)t.rev[(x >> 16) & 0xff] << 8) | (uint32_t)t.rev[x >> 24];
+	return r >> (32 - lg);
+}
+
+inline void bitrev_table(int *rev, int lg) {
+	rev[0] = 0;
+	for (int j = 1; j < (1 << lg); j++) {
+		rev[j] = (rev[j >> 1] >> 1) | ((j & 1) << (lg - 1));
+	}
+}
+
+template <typename T>
+void bitrev_swap(T *x, int lg) {
+	// i = (hi, lo) of h and l = lg - h bits, rev(i) = (rev(lo), rev(hi))
+	const int h = lg / 2;
+	const int l = lg - h;
+	std::vector<int> rl(1 << l);
+	bitrev_table(&rl[0], l);
+	for (int hi = 0; hi < (1 << h); hi++) {
+		const int rh = rl[hi] >> (l - h);
+		for (int lo = 0; lo < (1 << l); lo++) {
+			int i = (hi << l) | lo;
+			int r = (rl[lo] << h) | rh;
+			if (i < r) std::swap(x[i], x[r]);
+		}
+	}
+}
+
+template <typename T>
+void bitrev_cobra(T *x, int lg, int t) {
+	// lg >= 2t, x[a, b, c] at (a << (m + t)) | (b << t) | c
+	const int B = 1 << t;
+	const int m = lg - 2 * t;
+	const size_t row = (size_t)1 << (m + t);
+
+	std::vector<T> buf(2 * B * B);
+	T *t1 = &buf[0];
+	T *t2 = &buf[B * B];
+	std::vector<int> rt(B);
+	bitrev_table(&rt[0], t);
+
+	for (uint32_t b = 0; b < ((uint32_t)1 << m); b++) {
+		uint32_t br = bitrev_index(b, m);
+		if (br < b) continue;
+
+		for (int a = 0; a < B; a++) {
+			const T *src = x + a * row + ((size_t)b << t);
+			std::copy(src, src + B, t1 + a * B);
+		}
+		if (br != b) {
+			for (int a = 0; a < B; a++) {
+				const T *src = x + a * row + ((size_t)br << t);
+				std::copy(src, src + B, t2 + a * B);
+			}
+		}
+
+		// x[a, br, c] = x[rev(c), b, rev(a)] and the other way
+		for (int a = 0; a < B; a++) {
+			T *dst = x + a * row + ((size_t)br << t);
+			const T *col = t1 + rt[a];
+			for (int c = 0; c < B; c++) {
+				dst[c] = col[rt[c] * B];
+			}
+		}
+		if (br != b) {
+			for (int a = 0; a < B; a++) {
+				T *dst = x + a * row + ((size_t)b << t);
+				const T *col = t2 + rt[a];
+				for (int c = 0; c < B; c++) {
+					dst[c] = col[rt[c] * B];
+				}
+			}
+		}
+	}
+}
+
+template <typename T>
+void bitrev_permute(T *x, int lg) {
+	int t = 0;
+	while (((size_t)sizeof(T) << (2 * t + 2)) <= BITREV_TILE_BYTES) t++;
+	if (((size_t)sizeof(T) << lg) <= BITREV_COBRA_BYTES || lg < 2 * t) {
+		bitrev_swap(x, lg);
+	}
+	else {
+		bitrev_cobra(x, lg, t);
+	}
+}
+
+#endif
@@ -0,0 +1,66 @@
+/*
+ * cpu_dispatch.cpp
+ *
+ * Description
+ * Implementation of cpu_dispatch.h
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * 2026/10/17	jorjor	Unknown FFTNTT_ISA values reported
+ * */
+
+#include "cpu_dispatch.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+cpu_isa cpu_detect_isa() {
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) {
+		return ISA_AVX512;
+	}
+	if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+		return ISA_AVX2;
+	}
+	return ISA_SCALAR;
+}
+
+cpu_isa cpu_select_isa() {
+	cpu_isa isa = cpu_detect_isa();
+
+	const char *env = getenv("FFTNTT_ISA");
+	if (env == NULL) {
+		return isa;
+	}
+
+	cpu_isa want = isa;
+	if (strcmp(env, "scalar") == 0)			want = ISA_SCALAR;
+	else if (strcmp(env, "avx2") == 0)		want = ISA_AVX2;
+	else if (strcmp(env, "avx512") == 0)	want = ISA_AVX512;
+	else {
+		// once per process, every plan calls cpu_select_isa()
+		static const int reported = fprintf(stderr, "FFTNTT_ISA=%s unknown (scalar, avx2, avx512), using %s\n",
+			env, cpu_isa_name(isa));
+		(void)reported;
+	}
+
+	return (want < isa) ? want : isa;
+}
+
+cpu_isa cpu_resolve_isa(cpu_isa isa) {
+	if (isa == ISA_AUTO) {
+		return cpu_select_isa();
+	}
+	cpu_isa best = cpu_detect_isa();
+	return (isa < best) ? isa : best;
+}
+
+const char *cpu_isa_name(cpu_isa isa) {
+	switch (isa) {
+	case ISA_SCALAR:	return "scalar";
+	case ISA_AVX2:		return "avx2";
+	case ISA_AVX512:	return "avx512";
+	default:			return "auto";
+	}
+}
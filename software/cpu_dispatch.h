@@ -0,0 +1,40 @@
+/*
+ * cpu_dispatch.h
+ *
+ * Description
+ * Runtime selection of the SIMD kernels (scalar, AVX2, AVX-512)
+ * The plans call cpu_select_isa() once when they are built
+ *
+ * The environment variable FFTNTT_ISA = scalar | avx2 | avx512 forces an ISA,
+ * so the kernels can be compared on the same machine
+ * A forced ISA above what the CPU supports is clamped down to the best one it can run,
+ * any other value is reported on stderr and ignored
+ * The intrinsics and target attributes of the kernels are in cpu_target.h
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * 2026/10/17	jorjor	Unknown FFTNTT_ISA values reported
+ * */
+
+#ifndef CPU_DISPATCH_H
+#define CPU_DISPATCH_H
+
+enum cpu_isa {
+	ISA_AUTO = -1,		// cpu_select_isa()
+	ISA_SCALAR = 0,
+	ISA_AVX2,			// AVX2 + FMA
+	ISA_AVX512			// AVX-512 F + BW
+};
+
+// best ISA of this CPU (CPUID)
+cpu_isa cpu_detect_isa();
+
+// cpu_detect_isa() limited by FFTNTT_ISA
+cpu_isa cpu_select_isa();
+
+// isa limited by cpu_detect_isa(), ISA_AUTO -> cpu_select_isa()
+cpu_isa cpu_resolve_isa(cpu_isa isa);
+
+const char *cpu_isa_name(cpu_isa isa);
+
+#endif
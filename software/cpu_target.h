@@ -0,0 +1,32 @@
+/*
+ * cpu_target.h
+ *
+ * Description
+ * Intrinsics and target attributes of the SIMD kernels, the ISAs of cpu_dispatch.h
+ * The kernels are compiled with a target attribute, so the rest of the library
+ * does not need -mavx2 / -mavx512f
+ *
+ *   AVX2     avx2 + fma, ISA_AVX2
+ *   AVX512   avx512f + avx512bw, ISA_AVX512
+ *
+ * A kernel must only run when cpu_resolve_isa() returned its ISA or a higher one
+ *
+ * g++ 12 reports the _mm512_undefined_*() inside its own intrinsics as
+ * -Wmaybe-uninitialized, the warning is off for <immintrin.h> only
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * */
+
+#ifndef CPU_TARGET_H
+#define CPU_TARGET_H
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#include <immintrin.h>
+#pragma GCC diagnostic pop
+
+#define AVX2 __attribute__((target("avx2,fma")))
+#define AVX512 __attribute__((target("avx512f,avx512bw")))
+
+#endif
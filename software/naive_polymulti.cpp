@@ -75,7 +75,7 @@ int main(){
     cout << "result: "; print(ans, n);
 	
 	//delete buff;
-	delete ans;
+	delete[] ans;
 
 	return 0;
 }
@@ -0,0 +1,43 @@
+/*
+ * plan_cache.h
+ *
+ * Description
+ * Lazy cache of power-of-2 plans, one slot per log2 of the size
+ * The convolvers (FFT_convolve.h, NTT_convolve.h) pick the transform size per call
+ * and keep the plan of every size they have used for the next calls
+ *
+ *   get(n, make)   plan of size n, make(n) returns a new Plan on the first call for n
+ *
+ * Not thread-safe, a cache belongs to one convolver
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * */
+
+#ifndef PLAN_CACHE_H
+#define PLAN_CACHE_H
+
+#include <memory>
+#include <vector>
+
+template <class Plan>
+class PlanCache {
+public:
+	template <class Make>
+	const Plan &get(int n, Make make) {
+		int k = 0;
+		while ((1 << k) < n) k++;
+		if ((int)plans_.size() <= k) {
+			plans_.resize(k + 1);
+		}
+		if (!plans_[k]) {
+			plans_[k].reset(make(n));
+		}
+		return *plans_[k];
+	}
+
+private:
+	std::vector<std::unique_ptr<Plan> > plans_;	// plans_[k] : size 2^k
+};
+
+#endif
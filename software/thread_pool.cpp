@@ -0,0 +1,171 @@
+/*
+ * thread_pool.cpp
+ *
+ * Description
+ * Implementation of ThreadPool, see thread_pool.h
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * */
+
+#include "thread_pool.h"
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+using namespace std;
+
+ThreadPool::ThreadPool(int threads, bool pin)
+	: generation_(0), stop_(false), task_(NULL), remaining_(0) {
+	if (threads < 0) {
+		threads = (int)thread::hardware_concurrency() - 1;
+		if (threads < 0) threads = 0;
+	}
+
+	for (int i = 0; i <= threads; i++) {
+		queues_.push_back(new Queue);
+	}
+	for (int i = 0; i < threads; i++) {
+		threads_.push_back(thread(&ThreadPool::worker, this, i));
+#ifdef __linux__
+		if (pin) {
+			int cores = (int)thread::hardware_concurrency();
+			cpu_set_t set;
+			CPU_ZERO(&set);
+			CPU_SET(cores > 0 ? i % cores : 0, &set);
+			pthread_setaffinity_np(threads_[i].native_handle(), sizeof(set), &set);
+		}
+#else
+		(void)pin;
+#endif
+	}
+}
+
+ThreadPool::~ThreadPool() {
+	{
+		lock_guard<mutex> g(lock_);
+		stop_ = true;
+	}
+	wake_.notify_all();
+	for (size_t i = 0; i < threads_.size(); i++) {
+		threads_[i].join();
+	}
+	for (size_t i = 0; i < queues_.size(); i++) {
+		delete queues_[i];
+	}
+}
+
+bool ThreadPool::pop(int slot, Range &r) {
+	// own deque first (back, the most recently pushed chunk), then steal (front)
+	const int n = (int)queues_.size();
+	for (int k = 0; k < n; k++) {
+		Queue &q = *queues_[(slot + k) % n];
+		lock_guard<mutex> g(q.lock);
+		if (q.chunks.empty()) {
+			continue;
+		}
+		if (k == 0) {
+			r = q.chunks.back();
+			q.chunks.pop_back();
+		}
+		else {
+			r = q.chunks.front();
+			q.chunks.pop_front();
+		}
+		return true;
+	}
+	return false;
+}
+
+void ThreadPool::run(int slot) {
+	Range r;
+	while (pop(slot, r)) {
+		try {
+			(*task_)(r.lo, r.hi, slot);
+		}
+		catch (...) {
+			lock_guard<mutex> g(lock_);
+			if (!error_) error_ = current_exception();
+		}
+		if (remaining_.fetch_sub(1) == 1) {
+			lock_guard<mutex> g(lock_);
+			done_.notify_all();
+		}
+	}
+}
+
+void ThreadPool::worker(int slot) {
+	unsigned long seen = 0;
+	for (;;) {
+		{
+			unique_lock<mutex> g(lock_);
+			while (!stop_ && generation_ == seen) {
+				wake_.wait(g);
+			}
+			if (stop_) {
+				return;
+			}
+			seen = generation_;
+		}
+		run(slot);
+	}
+}
+
+void ThreadPool::parallel_for(long begin, long end, long chunk, const Task &f) {
+	if (end <= begin) {
+		return;
+	}
+	lock_guard<mutex> call(call_);
+
+	const int n = slots();
+	if (chunk <= 0) {
+		chunk = (end - begin + n - 1) / n;
+	}
+	long count = (end - begin + chunk - 1) / chunk;
+
+	// the task is published before the chunks, a worker still leaving the
+	// previous call may already pop one of them
+	{
+		lock_guard<mutex> g(lock_);
+		task_ = &f;
+		remaining_ = count;
+		error_ = exception_ptr();
+	}
+
+	// contiguous shares, neighbouring chunks stay on the same thread unless stolen
+	for (int s = 0; s < n; s++) {
+		long first = count * s / n;
+		long last = count * (s + 1) / n;
+		Queue &q = *queues_[s];
+		lock_guard<mutex> g(q.lock);
+		for (long c = last - 1; c >= first; c--) {
+			Range r;
+			r.lo = begin + c * chunk;
+			r.hi = (r.lo + chunk < end) ? r.lo + chunk : end;
+			q.chunks.push_back(r);
+		}
+	}
+
+	{
+		lock_guard<mutex> g(lock_);
+		generation_++;
+	}
+	wake_.notify_all();
+
+	run(n - 1);
+
+	exception_ptr error;
+	{
+		unique_lock<mutex> g(lock_);
+		while (remaining_ != 0) {
+			done_.wait(g);
+		}
+		task_ = NULL;
+		error = error_;
+	}
+	if (error) {
+		rethrow_exception(error);
+	}
+}
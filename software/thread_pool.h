@@ -0,0 +1,80 @@
+/*
+ * thread_pool.h
+ *
+ * Description
+ * Work-stealing thread pool for the batch APIs (NTT_parallel.h)
+ * Every thread owns a deque of chunks [lo, hi) : the owner pops from the back,
+ * idle threads steal from the front of the other deques
+ * parallel_for() splits [begin, end) into chunks, gives every deque a contiguous
+ * share and runs the chunks on the workers and on the calling thread
+ *
+ * The task gets the slot of the thread running it, in [0, slots()),
+ * so callers can keep per-thread data (twiddle copies, buffers) without locking
+ * A pool runs one parallel_for() at a time, the first exception thrown by a task
+ * is rethrown by parallel_for() once every chunk is done
+ *
+ * pin = true binds worker i to core i (Linux only, ignored elsewhere)
+ *
+ * History
+ * 2026/10/17	jorjor	First release
+ * */
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool {
+public:
+	typedef std::function<void(long lo, long hi, int slot)> Task;
+
+	// threads : worker threads besides the caller, < 0 = one per core
+	explicit ThreadPool(int threads = -1, bool pin = false);
+	~ThreadPool();
+
+	// number of threads running tasks, the workers and the caller of parallel_for()
+	int slots() const { return (int)queues_.size(); }
+
+	// f(lo, hi, slot) for every chunk of [begin, end), chunk <= 0 = one chunk per slot
+	void parallel_for(long begin, long end, long chunk, const Task &f);
+
+private:
+	ThreadPool(const ThreadPool &);
+	ThreadPool &operator=(const ThreadPool &);
+
+	struct Range {
+		long lo, hi;
+	};
+
+	struct Queue {
+		std::mutex lock;
+		std::deque<Range> chunks;
+	};
+
+	void worker(int slot);
+	bool pop(int slot, Range &r);
+	void run(int slot);
+
+	std::vector<std::thread> threads_;
+	std::vector<Queue *> queues_;	// slot threads_.size() is the caller
+
+	std::mutex lock_;
+	std::condition_variable wake_;
+	std::condition_variable done_;
+	unsigned long generation_;
+	bool stop_;
+
+	std::mutex call_;				// one parallel_for() at a time
+	const Task *task_;
+	std::atomic<long> remaining_;
+	std::exception_ptr error_;
+};
+
+#endif